@@ -0,0 +1,286 @@
+#include "Clients.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <print>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace Hyprutils::Memory;
+
+#define DEFAULT_WIDTH  640
+#define DEFAULT_HEIGHT 480
+#define STRIPE_WIDTH   32
+
+CSyntheticClients::~CSyntheticClients() {
+    m_popup.reset();
+    m_surfaces.clear();
+
+    m_layerShell.reset();
+    m_xdgWmBase.reset();
+    m_shm.reset();
+    m_compositor.reset();
+    m_registry.reset();
+
+    if (m_display)
+        wl_display_disconnect(m_display);
+}
+
+bool CSyntheticClients::connect(const std::string& socket) {
+    m_display = wl_display_connect(socket.c_str());
+
+    if (!m_display) {
+        std::println(stderr, "hyprbench: couldn't connect to {}", socket);
+        return false;
+    }
+
+    m_registry = makeShared<CCWlRegistry>((wl_proxy*)wl_display_get_registry(m_display));
+    m_registry->setGlobal([this](CCWlRegistry* r, uint32_t name, const char* interface, uint32_t version) {
+        const std::string IFACE = interface;
+
+        if (IFACE == wl_compositor_interface.name)
+            m_compositor = makeShared<CCWlCompositor>((wl_proxy*)wl_registry_bind((wl_registry*)r->resource(), name, &wl_compositor_interface, 4));
+        else if (IFACE == wl_shm_interface.name)
+            m_shm = makeShared<CCWlShm>((wl_proxy*)wl_registry_bind((wl_registry*)r->resource(), name, &wl_shm_interface, 1));
+        else if (IFACE == xdg_wm_base_interface.name) {
+            m_xdgWmBase = makeShared<CCXdgWmBase>((wl_proxy*)wl_registry_bind((wl_registry*)r->resource(), name, &xdg_wm_base_interface, 1));
+            m_xdgWmBase->setPing([](CCXdgWmBase* r, uint32_t serial) { r->sendPong(serial); });
+        } else if (IFACE == zwlr_layer_shell_v1_interface.name)
+            m_layerShell = makeShared<CCZwlrLayerShellV1>((wl_proxy*)wl_registry_bind((wl_registry*)r->resource(), name, &zwlr_layer_shell_v1_interface, 1));
+    });
+
+    wl_display_roundtrip(m_display);
+
+    if (!m_compositor || !m_shm || !m_xdgWmBase || !m_layerShell) {
+        std::println(stderr, "hyprbench: compositor is missing a required global");
+        return false;
+    }
+
+    return true;
+}
+
+void CSyntheticClients::addToplevel(const std::string& appID) {
+    auto surf        = makeShared<SSurface>();
+    surf->surface    = makeShared<CCWlSurface>(m_compositor->sendCreateSurface());
+    surf->xdgSurface = makeShared<CCXdgSurface>(m_xdgWmBase->sendGetXdgSurface(surf->surface->resource()));
+    surf->toplevel   = makeShared<CCXdgToplevel>(surf->xdgSurface->sendGetToplevel());
+
+    const auto PSURF = surf.get();
+
+    surf->toplevel->setConfigure([PSURF](CCXdgToplevel* r, int32_t width, int32_t height, wl_array* states) {
+        PSURF->pendingWidth  = width > 0 ? width : DEFAULT_WIDTH;
+        PSURF->pendingHeight = height > 0 ? height : DEFAULT_HEIGHT;
+    });
+    surf->xdgSurface->setConfigure([this, PSURF](CCXdgSurface* r, uint32_t serial) {
+        r->sendAckConfigure(serial);
+        resizeBuffers(PSURF);
+        PSURF->configured = true;
+    });
+
+    surf->toplevel->sendSetAppId(appID.c_str());
+    surf->toplevel->sendSetTitle(("hyprbench " + std::to_string(m_surfaces.size())).c_str());
+    surf->surface->sendCommit();
+
+    m_surfaces.emplace_back(surf);
+}
+
+void CSyntheticClients::addBar(int height) {
+    auto surf          = makeShared<SSurface>();
+    surf->surface      = makeShared<CCWlSurface>(m_compositor->sendCreateSurface());
+    surf->layerSurface = makeShared<CCZwlrLayerSurfaceV1>(m_layerShell->sendGetLayerSurface(surf->surface->resource(), nullptr, ZWLR_LAYER_SHELL_V1_LAYER_TOP, "hyprbench"));
+
+    const auto PSURF = surf.get();
+
+    surf->layerSurface->setConfigure([this, PSURF](CCZwlrLayerSurfaceV1* r, uint32_t serial, uint32_t width, uint32_t height) {
+        r->sendAckConfigure(serial);
+        PSURF->pendingWidth  = width > 0 ? width : DEFAULT_WIDTH;
+        PSURF->pendingHeight = height;
+        resizeBuffers(PSURF);
+        PSURF->configured = true;
+    });
+
+    surf->layerSurface->sendSetAnchor((zwlrLayerSurfaceV1Anchor)(ZWLR_LAYER_SURFACE_V1_ANCHOR_TOP | ZWLR_LAYER_SURFACE_V1_ANCHOR_LEFT | ZWLR_LAYER_SURFACE_V1_ANCHOR_RIGHT));
+    surf->layerSurface->sendSetSize(0, height);
+    surf->layerSurface->sendSetExclusiveZone(height);
+    surf->surface->sendCommit();
+
+    m_surfaces.emplace_back(surf);
+}
+
+void CSyntheticClients::togglePopup() {
+    if (m_popup) {
+        destroySurface(m_popup);
+        return;
+    }
+
+    std::vector<SSurface*> parents;
+    for (const auto& s : m_surfaces) {
+        if (s->toplevel && s->configured)
+            parents.emplace_back(s.get());
+    }
+
+    if (parents.empty())
+        return;
+
+    const auto PPARENT = parents[m_nextPopupParent++ % parents.size()];
+
+    auto       positioner = makeShared<CCXdgPositioner>(m_xdgWmBase->sendCreatePositioner());
+    positioner->sendSetSize(240, 180);
+    positioner->sendSetAnchorRect(0, 0, std::max(1, PPARENT->width / 2), std::max(1, PPARENT->height / 2));
+    positioner->sendSetAnchor(XDG_POSITIONER_ANCHOR_BOTTOM_RIGHT);
+    positioner->sendSetGravity(XDG_POSITIONER_GRAVITY_BOTTOM_RIGHT);
+
+    m_popup             = makeShared<SSurface>();
+    m_popup->surface    = makeShared<CCWlSurface>(m_compositor->sendCreateSurface());
+    m_popup->xdgSurface = makeShared<CCXdgSurface>(m_xdgWmBase->sendGetXdgSurface(m_popup->surface->resource()));
+    m_popup->popup      = makeShared<CCXdgPopup>(m_popup->xdgSurface->sendGetPopup(PPARENT->xdgSurface->resource(), positioner->resource()));
+
+    const auto PSURF = m_popup.get();
+
+    m_popup->popup->setConfigure([PSURF](CCXdgPopup* r, int32_t x, int32_t y, int32_t width, int32_t height) {
+        PSURF->pendingWidth  = width;
+        PSURF->pendingHeight = height;
+    });
+    // dismissed by the compositor. Can't destroy it from its own listener, the next toggle does
+    m_popup->popup->setPopupDone([PSURF](CCXdgPopup* r) { PSURF->configured = false; });
+    m_popup->xdgSurface->setConfigure([this, PSURF](CCXdgSurface* r, uint32_t serial) {
+        r->sendAckConfigure(serial);
+        resizeBuffers(PSURF);
+        PSURF->configured = true;
+    });
+
+    m_popup->surface->sendCommit();
+}
+
+void CSyntheticClients::resizeBuffers(SSurface* surf) {
+    if (surf->pendingWidth <= 0 || surf->pendingHeight <= 0 || (surf->pendingWidth == surf->width && surf->pendingHeight == surf->height))
+        return;
+
+    releaseBuffers(surf);
+
+    surf->width  = surf->pendingWidth;
+    surf->height = surf->pendingHeight;
+
+    const size_t STRIDE = surf->width * 4;
+    const size_t SIZE   = STRIDE * surf->height;
+
+    const int    FD = memfd_create("hyprbench", MFD_CLOEXEC);
+    if (FD < 0 || ftruncate(FD, SIZE * surf->buffers.size()) < 0) {
+        std::println(stderr, "hyprbench: couldn't allocate {} bytes of shm", SIZE * surf->buffers.size());
+        if (FD >= 0)
+            close(FD);
+        return;
+    }
+
+    surf->mappingSize = SIZE * surf->buffers.size();
+    surf->mapping     = mmap(nullptr, surf->mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0);
+
+    if (surf->mapping == MAP_FAILED) {
+        surf->mapping = nullptr;
+        close(FD);
+        return;
+    }
+
+    auto pool = makeShared<CCWlShmPool>(m_shm->sendCreatePool(FD, surf->mappingSize));
+
+    for (size_t i = 0; i < surf->buffers.size(); ++i) {
+        auto& buf = surf->buffers[i];
+        buf.data   = (uint8_t*)surf->mapping + i * SIZE;
+        buf.busy   = false;
+        buf.buffer = makeShared<CCWlBuffer>(pool->sendCreateBuffer(i * SIZE, surf->width, surf->height, STRIDE, WL_SHM_FORMAT_XRGB8888));
+        buf.buffer->setRelease([&buf](CCWlBuffer* r) { buf.busy = false; });
+
+        // a flat background, frames only repaint a stripe on top of it
+        memset(buf.data, 0x30 + i * 0x10, SIZE);
+    }
+
+    close(FD);
+}
+
+void CSyntheticClients::releaseBuffers(SSurface* surf) {
+    for (auto& buf : surf->buffers) {
+        buf.buffer.reset();
+        buf.data = nullptr;
+        buf.busy = false;
+    }
+
+    if (surf->mapping)
+        munmap(surf->mapping, surf->mappingSize);
+
+    surf->mapping     = nullptr;
+    surf->mappingSize = 0;
+}
+
+void CSyntheticClients::draw(SSurface* surf) {
+    auto it = std::ranges::find_if(surf->buffers, [](const auto& b) { return b.buffer && !b.busy; });
+
+    if (it == surf->buffers.end()) {
+        m_skippedFrames++;
+        return;
+    }
+
+    // a stripe sweeping across, the rest keeps whatever was there
+    const int  STRIPEX = (surf->frame * 8) % std::max(1, surf->width - STRIPE_WIDTH);
+    const auto COLOR   = 0xFF000000 | ((surf->frame * 0x050301) & 0xFFFFFF);
+
+    for (int y = 0; y < surf->height; ++y) {
+        auto* row = (uint32_t*)(it->data + (size_t)y * surf->width * 4);
+        for (int x = STRIPEX; x < std::min(surf->width, STRIPEX + STRIPE_WIDTH); ++x) {
+            row[x] = COLOR;
+        }
+    }
+
+    it->busy = true;
+    surf->surface->sendAttach(it->buffer->resource(), 0, 0);
+    surf->surface->sendDamageBuffer(0, 0, surf->width, surf->height);
+    surf->surface->sendCommit();
+    surf->frame++;
+}
+
+void CSyntheticClients::commitFrames() {
+    for (const auto& s : m_surfaces) {
+        if (s->configured)
+            draw(s.get());
+    }
+
+    if (m_popup && m_popup->configured)
+        draw(m_popup.get());
+}
+
+void CSyntheticClients::destroySurface(SP<SSurface>& surf) {
+    // children before parents, the generated destructors send the protocol destroys
+    surf->popup.reset();
+    surf->toplevel.reset();
+    surf->layerSurface.reset();
+    surf->xdgSurface.reset();
+    releaseBuffers(surf.get());
+    surf->surface.reset();
+    surf.reset();
+}
+
+bool CSyntheticClients::dispatch(std::chrono::milliseconds timeout) {
+    while (wl_display_prepare_read(m_display) != 0) {
+        if (wl_display_dispatch_pending(m_display) < 0)
+            return false;
+    }
+
+    wl_display_flush(m_display);
+
+    pollfd pfd = {.fd = wl_display_get_fd(m_display), .events = POLLIN};
+    if (poll(&pfd, 1, timeout.count()) > 0) {
+        if (wl_display_read_events(m_display) < 0)
+            return false;
+    } else
+        wl_display_cancel_read(m_display);
+
+    return wl_display_dispatch_pending(m_display) >= 0;
+}
+
+size_t CSyntheticClients::configured() const {
+    return std::ranges::count_if(m_surfaces, [](const auto& s) { return s->configured; });
+}
+
+size_t CSyntheticClients::skippedFrames() const {
+    return m_skippedFrames;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <wayland-client.h>
+#include <hyprutils/memory/SharedPtr.hpp>
+
+#include "wayland.hpp"
+#include "xdg-shell.hpp"
+#include "wlr-layer-shell-unstable-v1.hpp"
+
+template <typename T>
+using SP = Hyprutils::Memory::CSharedPointer<T>;
+
+/*
+    Scripted wayland clients, all on one connection: toplevels, a layer-shell bar and popups,
+    each redrawing into shm buffers whenever commitFrames() is called.
+*/
+class CSyntheticClients {
+  public:
+    CSyntheticClients() = default;
+    ~CSyntheticClients();
+
+    bool   connect(const std::string& socket);
+
+    void   addToplevel(const std::string& appID);
+    void   addBar(int height);
+    // opens a popup on the next toplevel, or closes the one that's open
+    void   togglePopup();
+
+    // redraws a stripe of every configured surface and commits it. Surfaces whose buffers are all still held by the compositor skip the frame.
+    void   commitFrames();
+
+    // reads and dispatches events for at most timeout. Returns false if the connection died.
+    bool   dispatch(std::chrono::milliseconds timeout);
+
+    size_t configured() const;
+    size_t skippedFrames() const;
+
+  private:
+    struct SShmBuffer {
+        SP<CCWlBuffer> buffer;
+        uint8_t*       data = nullptr;
+        bool           busy = false;
+    };
+
+    struct SSurface {
+        SP<CCWlSurface>            surface;
+        SP<CCXdgSurface>           xdgSurface;
+        SP<CCXdgToplevel>          toplevel;
+        SP<CCXdgPopup>             popup;
+        SP<CCZwlrLayerSurfaceV1>   layerSurface;
+
+        std::array<SShmBuffer, 3>  buffers;
+        void*                      mapping = nullptr;
+        size_t                     mappingSize = 0;
+
+        int                        width = 0, height = 0;               // of the buffers
+        int                        pendingWidth = 0, pendingHeight = 0; // from the last configure
+        bool                       configured = false;
+        uint32_t                   frame      = 0;
+    };
+
+    void                      resizeBuffers(SSurface* surf);
+    void                      releaseBuffers(SSurface* surf);
+    void                      draw(SSurface* surf);
+    void                      destroySurface(SP<SSurface>& surf);
+
+    wl_display*               m_display = nullptr;
+    SP<CCWlRegistry>          m_registry;
+    SP<CCWlCompositor>        m_compositor;
+    SP<CCWlShm>               m_shm;
+    SP<CCXdgWmBase>           m_xdgWmBase;
+    SP<CCZwlrLayerShellV1>    m_layerShell;
+
+    std::vector<SP<SSurface>> m_surfaces;
+    SP<SSurface>              m_popup;
+    size_t                    m_nextPopupParent = 0;
+    size_t                    m_skippedFrames   = 0;
+};
@@ -0,0 +1,179 @@
+#include "Instance.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <thread>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+std::string runtimeDir() {
+    const auto XDG = getenv("XDG_RUNTIME_DIR");
+
+    if (!XDG)
+        return "/run/user/" + std::to_string(getuid()) + "/hypr";
+
+    return std::string{XDG} + "/hypr";
+}
+
+CInstance::CInstance(const SInstanceOptions& options) : m_options(options) {
+    ;
+}
+
+CInstance::~CInstance() {
+    stop();
+}
+
+bool CInstance::start(std::chrono::milliseconds timeout) {
+    m_pid = fork();
+
+    if (m_pid < 0) {
+        std::println(stderr, "hyprbench: fork failed: {}", strerror(errno));
+        return false;
+    }
+
+    if (m_pid == 0) {
+        // no parent session: aquamarine falls back to headless only, we add the outputs ourselves
+        unsetenv("WAYLAND_DISPLAY");
+        unsetenv("DISPLAY");
+        unsetenv("HYPRLAND_INSTANCE_SIGNATURE");
+
+        if (m_options.software) {
+            setenv("LIBGL_ALWAYS_SOFTWARE", "1", 1);
+            setenv("GALLIUM_DRIVER", "llvmpipe", 1);
+        }
+
+        const int OUT = m_options.logPath.empty() ? open("/dev/null", O_WRONLY) : open(m_options.logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (OUT >= 0) {
+            dup2(OUT, STDOUT_FILENO);
+            dup2(OUT, STDERR_FILENO);
+            close(OUT);
+        }
+
+        execlp(m_options.binary.c_str(), m_options.binary.c_str(), "--config", m_options.config.c_str(), nullptr);
+        _exit(127);
+    }
+
+    const auto DEADLINE = std::chrono::steady_clock::now() + timeout;
+
+    while (std::chrono::steady_clock::now() < DEADLINE) {
+        if (!alive()) {
+            std::println(stderr, "hyprbench: Hyprland exited during startup, see --log");
+            return false;
+        }
+
+        if ((!m_signature.empty() || findInstance()) && !request("version").empty())
+            return true;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    std::println(stderr, "hyprbench: Hyprland didn't come up in time");
+    return false;
+}
+
+void CInstance::stop() {
+    if (m_pid <= 0)
+        return;
+
+    kill(m_pid, SIGTERM);
+
+    // give it a moment to clean up its instance dir, then make sure
+    for (int i = 0; i < 100; ++i) {
+        if (waitpid(m_pid, nullptr, WNOHANG) == m_pid) {
+            m_pid = -1;
+            return;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    kill(m_pid, SIGKILL);
+    waitpid(m_pid, nullptr, 0);
+    m_pid = -1;
+}
+
+bool CInstance::alive() {
+    if (m_pid <= 0)
+        return false;
+
+    if (waitpid(m_pid, nullptr, WNOHANG) == 0)
+        return true;
+
+    // reaped
+    m_pid = -1;
+    return false;
+}
+
+bool CInstance::findInstance() {
+    std::error_code ec;
+    for (const auto& el : std::filesystem::directory_iterator(runtimeDir(), ec)) {
+        if (!el.is_directory())
+            continue;
+
+        // the lock holds the pid and the wayland socket
+        std::ifstream ifs(el.path() / "hyprland.lock");
+        std::string   pid, socket;
+        if (!std::getline(ifs, pid) || !std::getline(ifs, socket) || pid != std::to_string(m_pid))
+            continue;
+
+        m_signature     = el.path().filename().string();
+        m_waylandSocket = socket;
+        return true;
+    }
+
+    return false;
+}
+
+std::string CInstance::request(const std::string& req) {
+    const auto SOCKETFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (SOCKETFD < 0)
+        return "";
+
+    auto t = timeval{.tv_sec = 5, .tv_usec = 0};
+    setsockopt(SOCKETFD, SOL_SOCKET, SO_RCVTIMEO, &t, sizeof(t));
+
+    sockaddr_un       serverAddress = {0};
+    serverAddress.sun_family        = AF_UNIX;
+
+    const std::string PATH = runtimeDir() + "/" + m_signature + "/.socket.sock";
+    strncpy(serverAddress.sun_path, PATH.c_str(), sizeof(serverAddress.sun_path) - 1);
+
+    const auto BEGIN = std::chrono::steady_clock::now();
+
+    if (connect(SOCKETFD, (sockaddr*)&serverAddress, SUN_LEN(&serverAddress)) < 0 || write(SOCKETFD, req.c_str(), req.length()) < 0) {
+        close(SOCKETFD);
+        return "";
+    }
+
+    std::string reply;
+    char        buffer[8192];
+
+    // hyprland closes the connection after replying
+    for (ssize_t len = 0; (len = read(SOCKETFD, buffer, sizeof(buffer))) > 0;) {
+        reply.append(buffer, len);
+    }
+
+    close(SOCKETFD);
+
+    if (m_bRecordLatency && !reply.empty())
+        m_vIPCLatenciesUs.emplace_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - BEGIN).count());
+
+    return reply;
+}
+
+const std::string& CInstance::signature() const {
+    return m_signature;
+}
+
+const std::string& CInstance::waylandSocket() const {
+    return m_waylandSocket;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+struct SInstanceOptions {
+    std::string binary   = "Hyprland";
+    std::string config   = ""; // path of the generated config
+    std::string logPath  = ""; // empty to drop Hyprland's stdout/stderr
+    bool        software = false;
+};
+
+// a Hyprland child running on the headless backend, and its IPC socket
+class CInstance {
+  public:
+    CInstance(const SInstanceOptions& options);
+    ~CInstance();
+
+    // spawns Hyprland and waits until its IPC answers
+    bool                start(std::chrono::milliseconds timeout);
+    void                stop();
+    bool                alive();
+
+    // one hyprctl-style request, e.g. "j/monitors" or "dispatch workspace 2". Empty on failure.
+    // While m_bRecordLatency is set, the round trip gets appended to m_vIPCLatenciesUs.
+    std::string         request(const std::string& req);
+
+    const std::string&  signature() const;
+    const std::string&  waylandSocket() const;
+
+    bool                m_bRecordLatency = false;
+    std::vector<double> m_vIPCLatenciesUs;
+
+  private:
+    bool             findInstance();
+
+    SInstanceOptions m_options;
+    pid_t            m_pid = -1;
+    std::string      m_signature;
+    std::string      m_waylandSocket;
+};
+
+std::string runtimeDir();
@@ -0,0 +1,127 @@
+#include "Report.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <glaze/glaze.hpp>
+
+std::string CReport::parseTrace(const std::string& path) {
+    std::ifstream ifs(path);
+    if (!ifs.good())
+        return std::format("couldn't open {}", path);
+
+    std::stringstream content;
+    content << ifs.rdbuf();
+
+    auto json = glz::read_json<glz::json_t>(content.str());
+    if (!json || !json->is_object() || !json->contains("traceEvents"))
+        return std::format("{} is not a trace dump", path);
+
+    std::map<int64_t, std::vector<double>> frameStartsByMonitor;
+    double                                 first = -1, last = 0;
+
+    for (auto& e : (*json)["traceEvents"].get_array()) {
+        if (!e.is_object() || !e.contains("ph") || e["ph"].get<std::string>() != "X")
+            continue;
+
+        const auto NAME  = e["name"].get<std::string>();
+        const auto TS    = e["ts"].get<double>();
+        const auto DUR   = e["dur"].get<double>();
+        const bool GPU   = e["cat"].get<std::string>() == "gpu";
+        int64_t    arg   = -1;
+        double     alloc = -1;
+
+        if (e.contains("args")) {
+            auto& args = e["args"];
+            if (args.contains("arg"))
+                arg = args["arg"].get<double>();
+            if (args.contains("allocs"))
+                alloc = args["allocs"].get<double>();
+        }
+
+        first = first < 0 ? TS : std::min(first, TS);
+        last  = std::max(last, TS + DUR);
+
+        if (GPU) {
+            m_vFrameGPUMs.emplace_back(DUR / 1000.0);
+            continue;
+        }
+
+        m_mStagesUs[NAME].emplace_back(DUR);
+
+        if (NAME != "renderMonitor")
+            continue;
+
+        m_vFrameCPUMs.emplace_back(DUR / 1000.0);
+        frameStartsByMonitor[arg].emplace_back(TS);
+
+        if (alloc >= 0)
+            m_vFrameAllocs.emplace_back(alloc);
+    }
+
+    for (auto& [mon, starts] : frameStartsByMonitor) {
+        std::ranges::sort(starts);
+        for (size_t i = 1; i < starts.size(); ++i) {
+            m_vFrameIntervalMs.emplace_back((starts[i] - starts[i - 1]) / 1000.0);
+        }
+    }
+
+    m_fTraceSpanS = first < 0 ? 0 : (last - first) / 1000000.0;
+
+    if (m_vFrameCPUMs.empty())
+        return "trace has no frames, did anything render?";
+
+    return "";
+}
+
+void CReport::setIPCLatencies(std::vector<double> latenciesUs) {
+    m_vIPCUs = std::move(latenciesUs);
+}
+
+std::string CReport::json(const SRunInfo& info) {
+    const auto FRAMES = m_vFrameCPUMs.size();
+
+    std::string stages = "";
+    for (auto& [name, durations] : m_mStagesUs) {
+        const auto SUMMARY = summarize(durations);
+        stages += std::format(R"#(
+        "{}": {{"perFrameUs": {:.3f}, "us": {}}},)#",
+                              name, FRAMES ? SUMMARY.total / FRAMES : 0.0, summaryToJSON(SUMMARY));
+    }
+
+    if (!stages.empty())
+        stages.pop_back(); // trailing comma
+
+    const auto FPS = m_fTraceSpanS > 0 ? FRAMES / m_fTraceSpanS : 0.0;
+
+    return std::format(R"#({{
+    "hyprland": "{}",
+    "run": {{
+        "windows": {},
+        "layers": {},
+        "commitRate": {:.1f},
+        "durationS": {:.2f},
+        "popups": {},
+        "animations": {},
+        "blur": {},
+        "software": {},
+        "skippedClientFrames": {}
+    }},
+    "frames": {{
+        "count": {},
+        "fps": {:.2f},
+        "cpuMs": {},
+        "intervalMs": {},
+        "gpuMs": {}
+    }},
+    "allocationsPerFrame": {},
+    "ipcUs": {},
+    "stages": {{{}
+    }}
+}})#",
+                       info.version, info.windows, info.layers, info.commitRate, info.durationS, info.popups, info.animations, info.blur, info.software, info.skippedFrames,
+                       FRAMES, FPS, summaryToJSON(summarize(m_vFrameCPUMs)), summaryToJSON(summarize(m_vFrameIntervalMs)),
+                       m_vFrameGPUMs.empty() ? "null" : summaryToJSON(summarize(m_vFrameGPUMs)), m_vFrameAllocs.empty() ? "null" : summaryToJSON(summarize(m_vFrameAllocs)),
+                       summaryToJSON(summarize(m_vIPCUs)), stages);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../helpers/Stats.hpp"
+
+struct SRunInfo {
+    std::string version;
+    size_t      windows       = 0;
+    size_t      layers        = 0;
+    double      commitRate    = 0;
+    double      durationS     = 0;
+    bool        popups        = false;
+    bool        animations    = false;
+    bool        blur          = false;
+    bool        software      = false;
+    size_t      skippedFrames = 0; // client frames dropped because the compositor held every buffer
+};
+
+// everything hyprbench reports, built from a `hyprctl trace dump` and the harness' own IPC timings
+class CReport {
+  public:
+    // reads a Chrome trace JSON written by Hyprland. Returns an error, empty on success.
+    std::string parseTrace(const std::string& path);
+
+    void        setIPCLatencies(std::vector<double> latenciesUs);
+
+    std::string json(const SRunInfo& info);
+
+  private:
+    std::vector<double>                        m_vFrameCPUMs;      // renderMonitor durations
+    std::vector<double>                        m_vFrameIntervalMs; // between renderMonitor starts, per monitor
+    std::vector<double>                        m_vFrameGPUMs;      // GPU timer queries
+    std::vector<double>                        m_vFrameAllocs;     // allocations inside renderMonitor
+    std::map<std::string, std::vector<double>> m_mStagesUs;        // every zone by name
+    std::vector<double>                        m_vIPCUs;
+    double                                     m_fTraceSpanS = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <numeric>
+#include <string>
+#include <vector>
+
+struct SSummary {
+    size_t count = 0;
+    double total = 0;
+    double mean  = 0;
+    double p50   = 0;
+    double p90   = 0;
+    double p99   = 0;
+    double max   = 0;
+};
+
+// nearest rank, values get sorted in place
+inline SSummary summarize(std::vector<double>& values) {
+    SSummary result;
+
+    if (values.empty())
+        return result;
+
+    std::ranges::sort(values);
+
+    const auto percentile = [&values](double p) { return values[std::clamp<size_t>((size_t)std::ceil(p * values.size()), 1, values.size()) - 1]; };
+
+    result.count = values.size();
+    result.total = std::accumulate(values.begin(), values.end(), 0.0);
+    result.mean  = result.total / values.size();
+    result.p50   = percentile(0.5);
+    result.p90   = percentile(0.9);
+    result.p99   = percentile(0.99);
+    result.max   = values.back();
+
+    return result;
+}
+
+inline std::string summaryToJSON(const SSummary& s) {
+    return std::format(R"#({{"count": {}, "total": {:.3f}, "mean": {:.3f}, "p50": {:.3f}, "p90": {:.3f}, "p99": {:.3f}, "max": {:.3f}}})#", s.count, s.total, s.mean, s.p50, s.p90,
+                       s.p99, s.max);
+}
@@ -0,0 +1,319 @@
+#include "core/Instance.hpp"
+#include "core/Clients.hpp"
+#include "core/Report.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <glaze/glaze.hpp>
+
+constexpr std::string_view HELP = R"#(┏ hyprbench, a headless benchmark harness for Hyprland
+┃
+┃ Starts Hyprland on the headless backend, drives synthetic clients against it
+┃ and prints a JSON report built from a frame trace (see hyprctl trace).
+┃ Without a GPU, load vkms or vgem and pass --software to render with llvmpipe.
+┃
+┣ --hyprland PATH        → Hyprland binary to run (default: Hyprland from $PATH)
+┣ --windows N            → xdg toplevels to open (default: 8)
+┣ --rate HZ              → how often every surface commits a new shm buffer (default: 60)
+┣ --duration S           → measured seconds (default: 10)
+┣ --warmup S             → seconds to run before measuring (default: 2)
+┣ --resolution WxH@R     → headless output mode (default: 1920x1080@60)
+┣ --cursor-rate HZ       → cursor moves per second over IPC, 0 to disable (default: 60)
+┣ --workspace-interval S → seconds between workspace switches, 0 to disable (default: 2)
+┣ --no-bar               → don't open the layer-shell bar
+┣ --no-popups            → don't open and close popups
+┣ --float                → float the toplevels instead of tiling them
+┣ --animations           → leave animations on
+┣ --blur                 → enable blur
+┣ --software             → force llvmpipe (LIBGL_ALWAYS_SOFTWARE)
+┣ --output FILE          → write the report to FILE instead of stdout
+┣ --trace FILE           → keep the raw trace at FILE
+┣ --log FILE             → Hyprland's stdout/stderr go to FILE
+┣ --help         | -h    → Show this menu
+┃
+┃ Build Hyprland with ALLOC_STATS (meson: -Dalloc_stats=true) to get allocationsPerFrame.
+┗
+)#";
+
+using namespace std::chrono;
+
+static std::string writeConfig(const std::string& resolution, bool animations, bool blur, bool floating) {
+    char path[] = "/tmp/hyprbench-XXXXXX.conf";
+    int  fd     = mkstemps(path, 5);
+    if (fd < 0)
+        return "";
+    close(fd);
+
+    std::ofstream ofs(path, std::ios::trunc);
+    ofs << std::format(R"#(# generated by hyprbench
+monitor = HYPRBENCH-1, {}, 0x0, 1
+
+animations {{
+    enabled = {}
+}}
+
+decoration {{
+    blur {{
+        enabled = {}
+    }}
+}}
+
+misc {{
+    disable_hyprland_logo = true
+    disable_splash_rendering = true
+    disable_autoreload = true
+}}
+)#",
+                       resolution, animations, blur);
+
+    if (floating)
+        ofs << "\nwindowrulev2 = float, class:^(hyprbench)$\n";
+
+    return path;
+}
+
+static std::string versionString(CInstance& instance) {
+    auto json = glz::read_json<glz::json_t>(instance.request("j/version"));
+    if (!json || !json->is_object() || !json->contains("tag") || !json->contains("commit"))
+        return "unknown";
+
+    auto result = std::format("{} ({})", (*json)["tag"].get<std::string>(), (*json)["commit"].get<std::string>().substr(0, 7));
+    std::erase_if(result, [](char c) { return c == '"' || c == '\\'; });
+    return result;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> ARGS{argv, argv + argc};
+
+    SInstanceOptions         options;
+    size_t                   windows = 8;
+    double                   rate = 60, durationS = 10, warmupS = 2, cursorRate = 60, workspaceInterval = 2;
+    std::string              resolution = "1920x1080@60", outputPath, tracePath;
+    bool                     bar = true, popups = true, floating = false, animations = false, blur = false;
+
+    try {
+        for (size_t i = 1; i < ARGS.size(); ++i) {
+            const auto NEXT = [&]() -> std::string {
+                if (i + 1 >= ARGS.size())
+                    throw std::invalid_argument(ARGS[i] + " needs a value");
+                return ARGS[++i];
+            };
+
+            if (ARGS[i] == "--help" || ARGS[i] == "-h") {
+                std::println("{}", HELP);
+                return 0;
+            } else if (ARGS[i] == "--hyprland")
+                options.binary = NEXT();
+            else if (ARGS[i] == "--windows")
+                windows = std::stoul(NEXT());
+            else if (ARGS[i] == "--rate")
+                rate = std::stod(NEXT());
+            else if (ARGS[i] == "--duration")
+                durationS = std::stod(NEXT());
+            else if (ARGS[i] == "--warmup")
+                warmupS = std::stod(NEXT());
+            else if (ARGS[i] == "--resolution")
+                resolution = NEXT();
+            else if (ARGS[i] == "--cursor-rate")
+                cursorRate = std::stod(NEXT());
+            else if (ARGS[i] == "--workspace-interval")
+                workspaceInterval = std::stod(NEXT());
+            else if (ARGS[i] == "--no-bar")
+                bar = false;
+            else if (ARGS[i] == "--no-popups")
+                popups = false;
+            else if (ARGS[i] == "--float")
+                floating = true;
+            else if (ARGS[i] == "--animations")
+                animations = true;
+            else if (ARGS[i] == "--blur")
+                blur = true;
+            else if (ARGS[i] == "--software")
+                options.software = true;
+            else if (ARGS[i] == "--output")
+                outputPath = NEXT();
+            else if (ARGS[i] == "--trace")
+                tracePath = NEXT();
+            else if (ARGS[i] == "--log")
+                options.logPath = NEXT();
+            else {
+                std::println(stderr, "hyprbench: unrecognized option {}\n\n{}", ARGS[i], HELP);
+                return 1;
+            }
+        }
+    } catch (std::exception& e) {
+        std::println(stderr, "hyprbench: {}", e.what());
+        return 1;
+    }
+
+    if (rate <= 0 || durationS <= 0) {
+        std::println(stderr, "hyprbench: --rate and --duration have to be positive");
+        return 1;
+    }
+
+    int width = 1920, height = 1080;
+    if (sscanf(resolution.c_str(), "%dx%d", &width, &height) != 2) {
+        std::println(stderr, "hyprbench: bad --resolution {}", resolution);
+        return 1;
+    }
+
+    options.config = writeConfig(resolution, animations, blur, floating);
+    if (options.config.empty()) {
+        std::println(stderr, "hyprbench: couldn't write a config");
+        return 1;
+    }
+
+    const bool KEEPTRACE = !tracePath.empty();
+    if (!KEEPTRACE)
+        tracePath = options.config.substr(0, options.config.size() - 5) + ".json";
+
+    // whatever happens, don't leave our temp files behind
+    const auto cleanup = [&]() {
+        std::error_code ec;
+        std::filesystem::remove(options.config, ec);
+        if (!KEEPTRACE)
+            std::filesystem::remove(tracePath, ec);
+    };
+
+    int result = [&]() -> int {
+        CInstance instance(options);
+        if (!instance.start(seconds(15)))
+            return 1;
+
+        instance.request("output create headless HYPRBENCH-1");
+
+        for (auto deadline = steady_clock::now() + seconds(5); !instance.request("monitors").contains("HYPRBENCH-1"); std::this_thread::sleep_for(milliseconds(50))) {
+            if (steady_clock::now() > deadline) {
+                std::println(stderr, "hyprbench: the headless output didn't show up");
+                return 1;
+            }
+        }
+
+        CSyntheticClients clients;
+        if (!clients.connect(instance.waylandSocket()))
+            return 1;
+
+        if (bar)
+            clients.addBar(32);
+
+        for (size_t i = 0; i < windows; ++i) {
+            clients.addToplevel("hyprbench");
+        }
+
+        const size_t SURFACES = windows + (bar ? 1 : 0);
+        for (auto deadline = steady_clock::now() + seconds(5); clients.configured() < SURFACES;) {
+            if (steady_clock::now() > deadline || !clients.dispatch(milliseconds(10))) {
+                std::println(stderr, "hyprbench: only {} of {} surfaces got configured", clients.configured(), SURFACES);
+                return 1;
+            }
+        }
+
+        const auto COMMITPERIOD = duration_cast<steady_clock::duration>(duration<double>(1.0 / rate));
+        const auto CURSORPERIOD = duration_cast<steady_clock::duration>(duration<double>(cursorRate > 0 ? 1.0 / cursorRate : 0));
+        const auto WSPERIOD     = duration_cast<steady_clock::duration>(duration<double>(workspaceInterval));
+        const auto POPUPPERIOD  = duration_cast<steady_clock::duration>(milliseconds(500));
+        const auto START        = steady_clock::now();
+        auto       nextCommit = START, nextCursor = START, nextWorkspace = START + WSPERIOD, nextPopup = START + POPUPPERIOD;
+        int        workspace = 1;
+
+        // one scheduler for the whole run. IPC requests block, so late events get rescheduled from now instead of bunching up.
+        const auto run = [&](steady_clock::time_point until) -> bool {
+            for (auto now = steady_clock::now(); now < until; now = steady_clock::now()) {
+                if (now >= nextCommit) {
+                    clients.commitFrames();
+                    nextCommit = std::max(nextCommit + COMMITPERIOD, now);
+                }
+
+                if (cursorRate > 0 && now >= nextCursor) {
+                    const double T = duration<double>(now - START).count();
+                    instance.request(std::format("dispatch movecursor {} {}", (int)(width / 2.0 + width / 2.5 * std::sin(T * 1.3)), (int)(height / 2.0 + height / 2.5 * std::sin(T * 1.7))));
+                    nextCursor = std::max(nextCursor + CURSORPERIOD, now);
+                }
+
+                if (workspaceInterval > 0 && now >= nextWorkspace) {
+                    workspace = workspace == 1 ? 2 : 1;
+                    instance.request(std::format("dispatch workspace {}", workspace));
+                    nextWorkspace = std::max(nextWorkspace + WSPERIOD, now);
+                }
+
+                if (popups && now >= nextPopup) {
+                    clients.togglePopup();
+                    nextPopup = std::max(nextPopup + POPUPPERIOD, now);
+                }
+
+                auto next = std::min({nextCommit, until, popups ? nextPopup : until, cursorRate > 0 ? nextCursor : until, workspaceInterval > 0 ? nextWorkspace : until});
+                if (!clients.dispatch(std::max(milliseconds(0), duration_cast<milliseconds>(next - steady_clock::now()))) || !instance.alive()) {
+                    std::println(stderr, "hyprbench: lost Hyprland mid-run");
+                    return false;
+                }
+            }
+
+            return true;
+        };
+
+        if (!run(steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(warmupS))))
+            return 1;
+
+        instance.request("trace start");
+        instance.m_bRecordLatency = true;
+
+        if (!run(steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(durationS))))
+            return 1;
+
+        instance.m_bRecordLatency = false;
+        instance.request("trace stop");
+
+        if (const auto REPLY = instance.request("trace dump " + tracePath); REPLY.starts_with("error")) {
+            std::println(stderr, "hyprbench: {}", REPLY);
+            return 1;
+        }
+
+        CReport report;
+        if (const auto ERR = report.parseTrace(tracePath); !ERR.empty()) {
+            std::println(stderr, "hyprbench: {}", ERR);
+            return 1;
+        }
+
+        report.setIPCLatencies(instance.m_vIPCLatenciesUs);
+
+        const auto JSON = report.json(SRunInfo{
+            .version       = versionString(instance),
+            .windows       = windows,
+            .layers        = bar ? 1UL : 0UL,
+            .commitRate    = rate,
+            .durationS     = durationS,
+            .popups        = popups,
+            .animations    = animations,
+            .blur          = blur,
+            .software      = options.software,
+            .skippedFrames = clients.skippedFrames(),
+        });
+
+        if (outputPath.empty())
+            std::println("{}", JSON);
+        else {
+            std::ofstream ofs(outputPath, std::ios::trunc);
+            ofs << JSON << "\n";
+            if (!ofs.good()) {
+                std::println(stderr, "hyprbench: couldn't write {}", outputPath);
+                return 1;
+            }
+        }
+
+        return 0;
+    }();
+
+    cleanup();
+
+    return result;
+}
@@ -21,6 +21,10 @@ commands:
                           dispatcher with arguments
     getoption <option>  → Gets the config option status (values)
     globalshortcuts     → Lists all global shortcuts
+    gpumemory           → Lists estimated framebuffer and texture memory
+                          per monitor and purpose
+    hooks [reset]       → Lists hooked events and their callbacks, with
+                          timings if debug:profile_hooks is set
     hyprpaper ...       → Issue a hyprpaper request
     hyprsunset ...      → Issue a hyprsunset request
     instances           → Lists all running instances of Hyprland with
@@ -52,6 +56,9 @@ commands:
     splash              → Get the current splash
     switchxkblayout ... → Sets the xkb layout index for a keyboard
     systeminfo          → Get system info
+    trace [start|stop|dump [path]] → Controls the frame trace recorder.
+                          dump writes the last few seconds as Chrome trace
+                          JSON, viewable in ui.perfetto.dev
     version             → Prints the hyprland version, meaning flags, commit
                           and branch of build.
     workspacerules      → Lists all workspace rules
@@ -139,8 +139,6 @@ int rollingRead(const int socket) {
             std::println("{}", std::string(buffer.data(), sizeWritten));
             buffer.fill('\0');
         }
-
-        usleep(100000);
     }
     close(socket);
     return 0;
@@ -3,6 +3,7 @@
 
 #include "Compositor.hpp"
 #include "debug/Log.hpp"
+#include "debug/Trace.hpp"
 #include "desktop/DesktopTypes.hpp"
 #include "helpers/Splashes.hpp"
 #include "config/ConfigValue.hpp"
@@ -53,6 +54,7 @@
 #include "config/ConfigManager.hpp"
 #include "render/OpenGL.hpp"
 #include "managers/input/InputManager.hpp"
+#include "devices/KeymapCache.hpp"
 #include "managers/AnimationManager.hpp"
 #include "managers/EventManager.hpp"
 #include "managers/HookSystemManager.hpp"
@@ -166,6 +168,10 @@ void CCompositor::restoreNofile() {
         Debug::log(ERR, "Failed restoring NOFILE limits");
 }
 
+const rlimit& CCompositor::originalNofile() const {
+    return m_sOriginalNofile;
+}
+
 void CCompositor::setMallocThreshold() {
 #ifdef M_TRIM_THRESHOLD
     // The default is 128 pages,
@@ -570,6 +576,7 @@ void CCompositor::cleanup() {
     removeAllSignals();
 
     g_pInputManager.reset();
+    g_pKeymapCache.reset();
     g_pDynamicPermissionManager.reset();
     g_pDecorationPositioner.reset();
     g_pCursorManager.reset();
@@ -661,6 +668,9 @@ void CCompositor::initManagers(eManagersInitStage stage) {
             Debug::log(LOG, "Creating CHyprCtl");
             g_pHyprCtl = makeUnique<CHyprCtl>();
 
+            Debug::log(LOG, "Creating the KeymapCache!");
+            g_pKeymapCache = makeUnique<CKeymapCache>();
+
             Debug::log(LOG, "Creating the InputManager!");
             g_pInputManager = makeUnique<CInputManager>();
 
@@ -864,6 +874,8 @@ bool CCompositor::monitorExists(PHLMONITOR pMonitor) {
 }
 
 PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t properties, PHLWINDOW pIgnoreWindow) {
+    TRACE_ZONE("vectorToWindowUnified", "input");
+
     const auto  PMONITOR          = getMonitorFromVector(pos);
     static auto PRESIZEONBORDER   = CConfigValue<Hyprlang::INT>("general:resize_on_border");
     static auto PBORDERSIZE       = CConfigValue<Hyprlang::INT>("general:border_size");
@@ -899,40 +911,41 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
                 if (!w->m_pWorkspace)
                     continue;
 
+                // cheap checks first, the box is only needed for candidates
+                if (!w->m_bIsFloating || !w->m_bIsMapped || !w->m_pWorkspace->isVisible() || w->isHidden() || w->m_bPinned || w->m_sWindowData.noFocus.valueOrDefault() ||
+                    w == pIgnoreWindow || (aboveFullscreen && !w->m_bCreatedOverFullscreen))
+                    continue;
+
+                // OR windows should add focus to parent
+                if (w->m_bX11ShouldntFocus && !w->isX11OverrideRedirect())
+                    continue;
+
                 const auto PWINDOWMONITOR = w->m_pMonitor.lock();
+                const auto BB             = w->getWindowBoxUnified(properties);
 
                 // to avoid focusing windows behind special workspaces from other monitors
                 if (!*PSPECIALFALLTHRU && PWINDOWMONITOR && PWINDOWMONITOR->activeSpecialWorkspace && w->m_pWorkspace != PWINDOWMONITOR->activeSpecialWorkspace) {
-                    const auto BB = w->getWindowBoxUnified(properties);
                     if (BB.x >= PWINDOWMONITOR->vecPosition.x && BB.y >= PWINDOWMONITOR->vecPosition.y &&
                         BB.x + BB.width <= PWINDOWMONITOR->vecPosition.x + PWINDOWMONITOR->vecSize.x &&
                         BB.y + BB.height <= PWINDOWMONITOR->vecPosition.y + PWINDOWMONITOR->vecSize.y)
                         continue;
                 }
 
-                if (w->m_bIsFloating && w->m_bIsMapped && w->m_pWorkspace->isVisible() && !w->isHidden() && !w->m_bPinned && !w->m_sWindowData.noFocus.valueOrDefault() &&
-                    w != pIgnoreWindow && (!aboveFullscreen || w->m_bCreatedOverFullscreen)) {
-                    // OR windows should add focus to parent
-                    if (w->m_bX11ShouldntFocus && !w->isX11OverrideRedirect())
-                        continue;
+                CBox box = BB.copy().expand(!w->isX11OverrideRedirect() ? BORDER_GRAB_AREA : 0);
+                if (box.containsPoint(g_pPointerManager->position())) {
 
-                    const auto BB  = w->getWindowBoxUnified(properties);
-                    CBox       box = BB.copy().expand(!w->isX11OverrideRedirect() ? BORDER_GRAB_AREA : 0);
-                    if (box.containsPoint(g_pPointerManager->position())) {
+                    if (w->m_bIsX11 && w->isX11OverrideRedirect() && !w->m_pXWaylandSurface->wantsFocus()) {
+                        // Override Redirect
+                        return g_pCompositor->m_lastWindow.lock(); // we kinda trick everything here.
+                        // TODO: this is wrong, we should focus the parent, but idk how to get it considering it's nullptr in most cases.
+                    }
 
-                        if (w->m_bIsX11 && w->isX11OverrideRedirect() && !w->m_pXWaylandSurface->wantsFocus()) {
-                            // Override Redirect
-                            return g_pCompositor->m_lastWindow.lock(); // we kinda trick everything here.
-                            // TODO: this is wrong, we should focus the parent, but idk how to get it considering it's nullptr in most cases.
-                        }
+                    return w;
+                }
 
+                if (!w->m_bIsX11) {
+                    if (w->hasPopupAt(pos))
                         return w;
-                    }
-
-                    if (!w->m_bIsX11) {
-                        if (w->hasPopupAt(pos))
-                            return w;
-                    }
                 }
             }
 
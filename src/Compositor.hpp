@@ -55,6 +55,7 @@ class CCompositor {
     void                                         cleanup();
     void                                         bumpNofile();
     void                                         restoreNofile();
+    const rlimit&                                originalNofile() const; // rlim_max is 0 if unknown
 
     WP<CWLSurfaceResource>                       m_lastFocus;
     PHLWINDOWREF                                 m_lastWindow;
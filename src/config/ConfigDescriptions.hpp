@@ -355,6 +355,13 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_FLOAT,
         .data        = SConfigOptionDescription::SFloatData{0.2, 0, 1},
     },
+    SConfigOptionDescription{
+        .value       = "decoration:blur:cache_size",
+        .description = "GPU memory in MiB for keeping the blurred background behind floating windows and layers that new_optimizations doesn't cover, so it's only re-blurred when "
+                       "what's behind them changes. 0 disables the cache.",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{64, 0, 1024},
+    },
 
     /*
      * animations:
@@ -1241,6 +1248,18 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_INT,
         .data        = SConfigOptionDescription::SRangeData{1, 1, 10},
     },
+    SConfigOptionDescription{
+        .value       = "misc:socket2_max_queued_events",
+        .description = "how many events a socket2 client may fall behind before the oldest ones are dropped and replaced with an eventsdropped event",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{1024, 1, 4096},
+    },
+    SConfigOptionDescription{
+        .value       = "misc:timer_slack",
+        .description = "how early, in microseconds, a timer may fire to be coalesced with an earlier one. 0 disables coalescing",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{0, 0, 10000},
+    },
 
     /*
      * binds:
@@ -1635,6 +1654,18 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_BOOL,
         .data        = SConfigOptionDescription::SBoolData{true},
     },
+    SConfigOptionDescription{
+        .value       = "debug:async_logs",
+        .description = "writes logs from a separate thread. Logging never blocks, but messages are dropped if a thread logs faster than they can be written.",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{false},
+    },
+    SConfigOptionDescription{
+        .value       = "debug:profile_hooks",
+        .description = "times every hook callback, see hyprctl hooks.",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{false},
+    },
     SConfigOptionDescription{
         .value       = "debug:log_damage",
         .description = "enables logging the damage.",
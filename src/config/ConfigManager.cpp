@@ -45,6 +45,7 @@
 #include <sstream>
 #include <ranges>
 #include <unordered_set>
+#include <typeindex>
 #include <hyprutils/string/String.hpp>
 #include <filesystem>
 #include <memory>
@@ -211,6 +212,8 @@ static Hyprlang::CParseResult handleMonitor(const char* c, const char* v) {
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
+    g_pConfigManager->recordKeyword(COMMAND, VALUE);
+
     const auto             RESULT = g_pConfigManager->handleMonitor(COMMAND, VALUE);
 
     Hyprlang::CParseResult result;
@@ -271,6 +274,8 @@ static Hyprlang::CParseResult handleWindowRule(const char* c, const char* v) {
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
+    g_pConfigManager->recordKeyword(COMMAND, VALUE);
+
     const auto             RESULT = g_pConfigManager->handleWindowRule(COMMAND, VALUE);
 
     Hyprlang::CParseResult result;
@@ -283,6 +288,8 @@ static Hyprlang::CParseResult handleLayerRule(const char* c, const char* v) {
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
+    g_pConfigManager->recordKeyword(COMMAND, VALUE);
+
     const auto             RESULT = g_pConfigManager->handleLayerRule(COMMAND, VALUE);
 
     Hyprlang::CParseResult result;
@@ -295,6 +302,8 @@ static Hyprlang::CParseResult handleWindowRuleV2(const char* c, const char* v) {
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
+    g_pConfigManager->recordKeyword(COMMAND, VALUE);
+
     const auto             RESULT = g_pConfigManager->handleWindowRule(COMMAND, VALUE);
 
     Hyprlang::CParseResult result;
@@ -307,6 +316,8 @@ static Hyprlang::CParseResult handleBlurLS(const char* c, const char* v) {
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
+    g_pConfigManager->recordKeyword(COMMAND, VALUE);
+
     const auto             RESULT = g_pConfigManager->handleBlurLS(COMMAND, VALUE);
 
     Hyprlang::CParseResult result;
@@ -319,6 +330,8 @@ static Hyprlang::CParseResult handleWorkspaceRules(const char* c, const char* v)
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
+    g_pConfigManager->recordKeyword(COMMAND, VALUE);
+
     const auto             RESULT = g_pConfigManager->handleWorkspaceRules(COMMAND, VALUE);
 
     Hyprlang::CParseResult result;
@@ -389,29 +402,39 @@ static Hyprlang::CParseResult handlePermission(const char* c, const char* v) {
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::INT& val) {
     m_configValueNumber++;
+    m_registeredConfigVars.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::FLOAT& val) {
     m_configValueNumber++;
+    m_registeredConfigVars.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::VEC2& val) {
     m_configValueNumber++;
+    m_registeredConfigVars.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::STRING& val) {
     m_configValueNumber++;
+    m_registeredConfigVars.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, Hyprlang::CUSTOMTYPE&& val) {
     m_configValueNumber++;
+    m_registeredConfigVars.emplace_back(name);
     m_config->addConfigValue(name, std::move(val));
 }
 
+void CConfigManager::registerDeviceConfigVar(const char* name, const Hyprlang::CConfigValue& val) {
+    m_deviceConfigVars.emplace_back(name);
+    m_config->addSpecialConfigValue("device", name, val);
+}
+
 CConfigManager::CConfigManager() {
     const auto ERR = verifyConfigExists();
 
@@ -474,6 +497,8 @@ CConfigManager::CConfigManager() {
     registerConfigVar("misc:lockdead_screen_delay", Hyprlang::INT{1000});
     registerConfigVar("misc:enable_anr_dialog", Hyprlang::INT{1});
     registerConfigVar("misc:anr_missed_pings", Hyprlang::INT{1});
+    registerConfigVar("misc:socket2_max_queued_events", Hyprlang::INT{1024});
+    registerConfigVar("misc:timer_slack", Hyprlang::INT{0});
 
     registerConfigVar("group:insert_after_current", Hyprlang::INT{1});
     registerConfigVar("group:focus_removed_window", Hyprlang::INT{1});
@@ -517,6 +542,8 @@ CConfigManager::CConfigManager() {
     registerConfigVar("debug:error_position", Hyprlang::INT{0});
     registerConfigVar("debug:disable_scale_checks", Hyprlang::INT{0});
     registerConfigVar("debug:colored_stdout_logs", Hyprlang::INT{1});
+    registerConfigVar("debug:async_logs", Hyprlang::INT{0});
+    registerConfigVar("debug:profile_hooks", Hyprlang::INT{0});
     registerConfigVar("debug:full_cm_proto", Hyprlang::INT{0});
 
     registerConfigVar("decoration:rounding", Hyprlang::INT{0});
@@ -537,6 +564,7 @@ CConfigManager::CConfigManager() {
     registerConfigVar("decoration:blur:popups_ignorealpha", {0.2F});
     registerConfigVar("decoration:blur:input_methods", Hyprlang::INT{0});
     registerConfigVar("decoration:blur:input_methods_ignorealpha", {0.2F});
+    registerConfigVar("decoration:blur:cache_size", Hyprlang::INT{64});
     registerConfigVar("decoration:active_opacity", {1.F});
     registerConfigVar("decoration:inactive_opacity", {1.F});
     registerConfigVar("decoration:fullscreen_opacity", {1.F});
@@ -723,43 +751,43 @@ CConfigManager::CConfigManager() {
 
     // devices
     m_config->addSpecialCategory("device", {"name"});
-    m_config->addSpecialConfigValue("device", "sensitivity", {0.F});
-    m_config->addSpecialConfigValue("device", "accel_profile", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_file", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_layout", {"us"});
-    m_config->addSpecialConfigValue("device", "kb_variant", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_options", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_rules", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_model", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "repeat_rate", Hyprlang::INT{25});
-    m_config->addSpecialConfigValue("device", "repeat_delay", Hyprlang::INT{600});
-    m_config->addSpecialConfigValue("device", "natural_scroll", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "tap_button_map", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "numlock_by_default", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "resolve_binds_by_sym", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "disable_while_typing", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "clickfinger_behavior", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "middle_button_emulation", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "tap-to-click", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "tap-and-drag", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "drag_lock", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "left_handed", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_method", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "scroll_button", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_button_lock", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_points", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "transform", Hyprlang::INT{-1});
-    m_config->addSpecialConfigValue("device", "output", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
-    m_config->addSpecialConfigValue("device", "region_position", Hyprlang::VEC2{0, 0});      // only for tablets
-    m_config->addSpecialConfigValue("device", "absolute_region_position", Hyprlang::INT{0}); // only for tablets
-    m_config->addSpecialConfigValue("device", "region_size", Hyprlang::VEC2{0, 0});          // only for tablets
-    m_config->addSpecialConfigValue("device", "relative_input", Hyprlang::INT{0});           // only for tablets
-    m_config->addSpecialConfigValue("device", "active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
-    m_config->addSpecialConfigValue("device", "active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
-    m_config->addSpecialConfigValue("device", "flip_x", Hyprlang::INT{0});                   // only for touchpads
-    m_config->addSpecialConfigValue("device", "flip_y", Hyprlang::INT{0});                   // only for touchpads
-    m_config->addSpecialConfigValue("device", "keybinds", Hyprlang::INT{1});                 // enable/disable keybinds
+    registerDeviceConfigVar("sensitivity", {0.F});
+    registerDeviceConfigVar("accel_profile", {STRVAL_EMPTY});
+    registerDeviceConfigVar("kb_file", {STRVAL_EMPTY});
+    registerDeviceConfigVar("kb_layout", {"us"});
+    registerDeviceConfigVar("kb_variant", {STRVAL_EMPTY});
+    registerDeviceConfigVar("kb_options", {STRVAL_EMPTY});
+    registerDeviceConfigVar("kb_rules", {STRVAL_EMPTY});
+    registerDeviceConfigVar("kb_model", {STRVAL_EMPTY});
+    registerDeviceConfigVar("repeat_rate", Hyprlang::INT{25});
+    registerDeviceConfigVar("repeat_delay", Hyprlang::INT{600});
+    registerDeviceConfigVar("natural_scroll", Hyprlang::INT{0});
+    registerDeviceConfigVar("tap_button_map", {STRVAL_EMPTY});
+    registerDeviceConfigVar("numlock_by_default", Hyprlang::INT{0});
+    registerDeviceConfigVar("resolve_binds_by_sym", Hyprlang::INT{0});
+    registerDeviceConfigVar("disable_while_typing", Hyprlang::INT{1});
+    registerDeviceConfigVar("clickfinger_behavior", Hyprlang::INT{0});
+    registerDeviceConfigVar("middle_button_emulation", Hyprlang::INT{0});
+    registerDeviceConfigVar("tap-to-click", Hyprlang::INT{1});
+    registerDeviceConfigVar("tap-and-drag", Hyprlang::INT{1});
+    registerDeviceConfigVar("drag_lock", Hyprlang::INT{0});
+    registerDeviceConfigVar("left_handed", Hyprlang::INT{0});
+    registerDeviceConfigVar("scroll_method", {STRVAL_EMPTY});
+    registerDeviceConfigVar("scroll_button", Hyprlang::INT{0});
+    registerDeviceConfigVar("scroll_button_lock", Hyprlang::INT{0});
+    registerDeviceConfigVar("scroll_points", {STRVAL_EMPTY});
+    registerDeviceConfigVar("transform", Hyprlang::INT{-1});
+    registerDeviceConfigVar("output", {STRVAL_EMPTY});
+    registerDeviceConfigVar("enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
+    registerDeviceConfigVar("region_position", Hyprlang::VEC2{0, 0});      // only for tablets
+    registerDeviceConfigVar("absolute_region_position", Hyprlang::INT{0}); // only for tablets
+    registerDeviceConfigVar("region_size", Hyprlang::VEC2{0, 0});          // only for tablets
+    registerDeviceConfigVar("relative_input", Hyprlang::INT{0});           // only for tablets
+    registerDeviceConfigVar("active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
+    registerDeviceConfigVar("active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
+    registerDeviceConfigVar("flip_x", Hyprlang::INT{0});                   // only for touchpads
+    registerDeviceConfigVar("flip_y", Hyprlang::INT{0});                   // only for touchpads
+    registerDeviceConfigVar("keybinds", Hyprlang::INT{1});                 // enable/disable keybinds
 
     // keywords
     m_config->registerHandler(&::handleExec, "exec", {false});
@@ -882,14 +910,186 @@ std::string CConfigManager::getErrors() {
     return m_configErrors;
 }
 
-void CConfigManager::reload() {
+void CConfigManager::reload(bool incremental) {
     EMIT_HOOK_EVENT("preConfigReload", nullptr);
+
+    // hyprlang has no partial parse, so we always parse everything, but only refresh what depends on what changed.
+    const auto BEFORE = incremental && !m_isFirstLaunch ? snapshotConfig() : SConfigSnapshot{};
+
     setDefaultAnimationVars();
     resetHLConfig();
     m_configCurrentPath                   = getMainConfigPath();
     const auto ERR                        = m_config->parse();
     m_lastConfigVerificationWasSuccessful = !ERR.error;
-    postConfigReload(ERR);
+    m_hasRuntimeKeywords                  = false;
+
+    uint32_t changes = CONFIG_CHANGE_ALL;
+    if (incremental && !m_isFirstLaunch) {
+        changes = diffConfig(BEFORE, snapshotConfig());
+        Debug::log(LOG, "CConfigManager: incremental reload, changes: {:#x}", changes);
+    }
+
+    updateFileHashes();
+
+    postConfigReload(ERR, changes);
+}
+
+void CConfigManager::recordKeyword(const std::string& command, const std::string& value) {
+    auto& entry = m_parsedKeywords[command];
+    entry += value;
+    entry += '\n';
+}
+
+static std::string configValueToString(Hyprlang::CConfigValue* val) {
+    if (!val)
+        return "";
+
+    const auto VAL  = val->getValue();
+    const auto TYPE = std::type_index(VAL.type());
+
+    if (TYPE == typeid(Hyprlang::INT))
+        return std::to_string(std::any_cast<Hyprlang::INT>(VAL));
+    else if (TYPE == typeid(Hyprlang::FLOAT))
+        return std::format("{}", std::any_cast<Hyprlang::FLOAT>(VAL));
+    else if (TYPE == typeid(Hyprlang::VEC2)) {
+        const auto V = std::any_cast<Hyprlang::VEC2>(VAL);
+        return std::format("{} {}", V.x, V.y);
+    } else if (TYPE == typeid(Hyprlang::STRING))
+        return std::any_cast<Hyprlang::STRING>(VAL);
+    else if (TYPE == typeid(void*))
+        return ((ICustomConfigValueData*)std::any_cast<void*>(VAL))->toString();
+
+    return "";
+}
+
+CConfigManager::SConfigSnapshot CConfigManager::snapshotConfig() {
+    SConfigSnapshot snapshot;
+
+    snapshot.values.reserve(m_registeredConfigVars.size() + m_pluginVariables.size());
+
+    for (const auto& name : m_registeredConfigVars) {
+        snapshot.values[name] = configValueToString(m_config->getConfigValuePtr(name.c_str()));
+    }
+
+    for (const auto& v : m_pluginVariables) {
+        snapshot.values[v.name] = configValueToString(m_config->getConfigValuePtr(v.name.c_str()));
+    }
+
+    // devices without a block fall back to the input: values, which are covered above
+    if (g_pInputManager) {
+        for (const auto& hid : g_pInputManager->m_vHIDs) {
+            if (!hid || !deviceConfigExists(hid->hlName))
+                continue;
+
+            for (const auto& key : m_deviceConfigVars) {
+                snapshot.devices[hid->hlName + ":" + key] = configValueToString(getConfigValueSafeDevice(hid->hlName, key, ""));
+            }
+        }
+    }
+
+    snapshot.keywords = m_parsedKeywords;
+
+    return snapshot;
+}
+
+static uint32_t changesForValue(const std::string& name) {
+    if (name.starts_with("input:"))
+        return CONFIG_CHANGE_INPUT;
+    if (name.starts_with("general:"))
+        return CONFIG_CHANGE_LAYOUT | CONFIG_CHANGE_DECORATIONS | CONFIG_CHANGE_RENDER;
+    if (name.starts_with("dwindle:") || name.starts_with("master:"))
+        return CONFIG_CHANGE_LAYOUT;
+    if (name.starts_with("decoration:"))
+        return CONFIG_CHANGE_DECORATIONS | CONFIG_CHANGE_RENDER;
+    if (name.starts_with("group:"))
+        return CONFIG_CHANGE_LAYOUT | CONFIG_CHANGE_DECORATIONS;
+    if (name.starts_with("plugin:"))
+        return CONFIG_CHANGE_LAYOUT | CONFIG_CHANGE_DECORATIONS | CONFIG_CHANGE_RENDER; // plugins can be layouts or decorations
+    // applied to the outputs in ensureVRR() / performMonitorReload()
+    if (name == "misc:vrr" || name.starts_with("render:"))
+        return CONFIG_CHANGE_MONITORS | CONFIG_CHANGE_RENDER;
+    // force_zero_scaling changes xwayland window and monitor scales
+    if (name.starts_with("xwayland:"))
+        return CONFIG_CHANGE_MONITORS | CONFIG_CHANGE_LAYOUT | CONFIG_CHANGE_RENDER;
+    // read when used, a redraw is enough
+    if (name.starts_with("animations:") || name.starts_with("binds:") || name.starts_with("gestures:") || name.starts_with("debug:") || name.starts_with("cursor:"))
+        return CONFIG_CHANGE_RENDER;
+
+    // unclassified, don't guess what it needs
+    return CONFIG_CHANGE_ALL;
+}
+
+static uint32_t changesForKeyword(const std::string& keyword) {
+    if (keyword == "monitor")
+        return CONFIG_CHANGE_MONITORS | CONFIG_CHANGE_LAYOUT | CONFIG_CHANGE_RENDER;
+    if (keyword == "workspace")
+        return CONFIG_CHANGE_RULES | CONFIG_CHANGE_LAYOUT;
+    if (keyword == "blurls")
+        return CONFIG_CHANGE_RULES | CONFIG_CHANGE_RENDER;
+
+    // windowrule, windowrulev2, layerrule
+    return CONFIG_CHANGE_RULES;
+}
+
+uint32_t CConfigManager::diffConfig(const SConfigSnapshot& before, const SConfigSnapshot& after) {
+    uint32_t changes = CONFIG_CHANGE_NONE;
+
+    for (const auto& [name, value] : after.values) {
+        const auto IT = before.values.find(name);
+        if (IT != before.values.end() && IT->second == value)
+            continue;
+
+        Debug::log(TRACE, "CConfigManager: {} changed", name);
+        changes |= changesForValue(name);
+    }
+
+    // a plugin value went away
+    if (before.values.size() != after.values.size())
+        changes |= changesForValue("plugin:");
+
+    if (before.devices != after.devices)
+        changes |= CONFIG_CHANGE_INPUT;
+
+    for (const auto& [keyword, value] : after.keywords) {
+        const auto IT = before.keywords.find(keyword);
+        if (IT == before.keywords.end() || IT->second != value)
+            changes |= changesForKeyword(keyword);
+    }
+
+    for (const auto& [keyword, value] : before.keywords) {
+        if (!after.keywords.contains(keyword))
+            changes |= changesForKeyword(keyword);
+    }
+
+    return changes;
+}
+
+static std::optional<size_t> hashConfigFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open())
+        return std::nullopt;
+
+    const std::string CONTENT{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    return std::hash<std::string>{}(CONTENT);
+}
+
+bool CConfigManager::configFileChanged(const std::string& path) {
+    const auto HASH = hashConfigFile(path);
+    const auto IT   = m_configFileHashes.find(path);
+
+    if (!HASH || IT == m_configFileHashes.end())
+        return true;
+
+    return IT->second != *HASH;
+}
+
+void CConfigManager::updateFileHashes() {
+    m_configFileHashes.clear();
+
+    for (const auto& path : m_configPaths) {
+        if (const auto HASH = hashConfigFile(path); HASH)
+            m_configFileHashes[path] = *HASH;
+    }
 }
 
 std::string CConfigManager::verify() {
@@ -950,6 +1150,7 @@ void CConfigManager::setDefaultAnimationVars() {
 std::optional<std::string> CConfigManager::resetHLConfig() {
     m_monitorRules.clear();
     m_windowRules.clear();
+    m_windowRuleMatcher.dirty = true;
     g_pKeybindManager->clearKeybinds();
     g_pAnimationManager->removeAllBeziers();
     g_pAnimationManager->addBezierWithName("linear", Vector2D(0.0, 0.0), Vector2D(1.0, 1.0));
@@ -960,8 +1161,10 @@ std::optional<std::string> CConfigManager::resetHLConfig() {
     setDefaultAnimationVars(); // reset anims
     m_declaredPlugins.clear();
     m_layerRules.clear();
+    m_layerRuleMatcher.dirty = true;
     m_failedPluginConfigValues.clear();
     m_finalExecRequests.clear();
+    m_parsedKeywords.clear();
 
     g_pDynamicPermissionManager->clearConfigPermissions();
 
@@ -981,26 +1184,36 @@ void CConfigManager::updateWatcher() {
     g_pConfigWatcher->setWatchList(*PDISABLEAUTORELOAD ? std::vector<std::string>{} : m_configPaths);
 }
 
-void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
+void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result, uint32_t changes) {
     static const auto PENABLEEXPLICIT     = CConfigValue<Hyprlang::INT>("render:explicit_sync");
     static int        prevEnabledExplicit = *PENABLEEXPLICIT;
 
     updateWatcher();
 
-    for (auto const& w : g_pCompositor->m_windows) {
-        w->uncacheWindowDecos();
+    if (changes & CONFIG_CHANGE_DECORATIONS) {
+        for (auto const& w : g_pCompositor->m_windows) {
+            w->uncacheWindowDecos();
+        }
     }
 
-    for (auto const& m : g_pCompositor->m_monitors)
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
+    if (changes & CONFIG_CHANGE_LAYOUT) {
+        for (auto const& m : g_pCompositor->m_monitors)
+            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
+    }
 
     // Update the keyboard layout to the cfg'd one if this is not the first launch
-    if (!m_isFirstLaunch) {
+    if (!m_isFirstLaunch && (changes & CONFIG_CHANGE_INPUT)) {
+        // kb_file contents or the xkb data might have changed
+        if (g_pKeymapCache)
+            g_pKeymapCache->invalidate();
+
         g_pInputManager->setKeyboardLayout();
         g_pInputManager->setPointerConfigs();
         g_pInputManager->setTouchDeviceConfigs();
         g_pInputManager->setTabletConfigs();
+    }
 
+    if (!m_isFirstLaunch && (changes & CONFIG_CHANGE_RENDER)) {
         g_pHyprOpenGL->m_bReloadScreenShader = true;
 
         g_pHyprOpenGL->ensureBackgroundTexturePresence();
@@ -1029,7 +1242,7 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     // not on first launch because monitors might not exist yet
     // and they'll be taken care of in the newMonitor event
     // ignore if nomonitorreload is set
-    if (!m_isFirstLaunch && !m_noMonitorReload) {
+    if (!m_isFirstLaunch && !m_noMonitorReload && (changes & CONFIG_CHANGE_MONITORS)) {
         // check
         performMonitorReload();
         ensureMonitorStatus();
@@ -1049,22 +1262,25 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
         g_pCompositor->m_wantsXwayland = PENABLEXWAYLAND;
 #endif
 
-    if (!m_isFirstLaunch && !g_pCompositor->m_unsafeState)
+    if (!m_isFirstLaunch && !g_pCompositor->m_unsafeState && (changes & CONFIG_CHANGE_DECORATIONS))
         refreshGroupBarGradients();
 
     // Updates dynamic window and workspace rules
-    for (auto const& w : g_pCompositor->m_workspaces) {
-        if (w->inert())
-            continue;
-        w->updateWindows();
-        w->updateWindowData();
-    }
+    if (changes & (CONFIG_CHANGE_RULES | CONFIG_CHANGE_LAYOUT | CONFIG_CHANGE_DECORATIONS)) {
+        for (auto const& w : g_pCompositor->m_workspaces) {
+            if (w->inert())
+                continue;
+            w->updateWindows();
+            w->updateWindowData();
+        }
 
-    // Update window border colors
-    g_pCompositor->updateAllWindowsAnimatedDecorationValues();
+        // Update window border colors
+        g_pCompositor->updateAllWindowsAnimatedDecorationValues();
+    }
 
     // update layout
-    g_pLayoutManager->switchToLayout(std::any_cast<Hyprlang::STRING>(m_config->getConfigValue("general:layout")));
+    if (changes & CONFIG_CHANGE_LAYOUT)
+        g_pLayoutManager->switchToLayout(std::any_cast<Hyprlang::STRING>(m_config->getConfigValue("general:layout")));
 
     // manual crash
     if (std::any_cast<Hyprlang::INT>(m_config->getConfigValue("debug:manual_crash")) && !m_manualCrashInitiated) {
@@ -1082,18 +1298,29 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
 
     Debug::m_coloredLogs = reinterpret_cast<int64_t* const*>(m_config->getConfigValuePtr("debug:colored_stdout_logs")->getDataStaticPtr());
 
-    for (auto const& m : g_pCompositor->m_monitors) {
-        // mark blur dirty
-        g_pHyprOpenGL->markBlurDirtyForMonitor(m);
+    Debug::setAsync(std::any_cast<Hyprlang::INT>(m_config->getConfigValue("debug:async_logs")));
+
+    if (g_pHookSystem)
+        g_pHookSystem->m_bProfiling = std::any_cast<Hyprlang::INT>(m_config->getConfigValue("debug:profile_hooks"));
+
+    if (g_pEventLoopManager)
+        g_pEventLoopManager->setTimerSlack(std::chrono::microseconds(std::any_cast<Hyprlang::INT>(m_config->getConfigValue("misc:timer_slack"))));
+
+    // nothing visible changed, no need to redraw everything
+    if (changes != CONFIG_CHANGE_NONE) {
+        for (auto const& m : g_pCompositor->m_monitors) {
+            // mark blur dirty
+            g_pHyprOpenGL->markBlurDirtyForMonitor(m);
 
-        g_pCompositor->scheduleFrameForMonitor(m);
+            g_pCompositor->scheduleFrameForMonitor(m);
 
-        // Force the compositor to fully re-render all monitors
-        m->forceFullFrames = 2;
+            // Force the compositor to fully re-render all monitors
+            m->forceFullFrames = 2;
 
-        // also force mirrors, as the aspect ratio could've changed
-        for (auto const& mirror : m->mirrors)
-            mirror->forceFullFrames = 3;
+            // also force mirrors, as the aspect ratio could've changed
+            for (auto const& mirror : m->mirrors)
+                mirror->forceFullFrames = 3;
+        }
     }
 
     // Reset no monitor reload
@@ -1103,7 +1330,7 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     handlePluginLoads();
 
     // update persistent workspaces
-    if (!m_isFirstLaunch)
+    if (!m_isFirstLaunch && (changes & (CONFIG_CHANGE_RULES | CONFIG_CHANGE_MONITORS)))
         ensurePersistentWorkspacesPresent();
 
     EMIT_HOOK_EVENT("configReloaded", nullptr);
@@ -1114,8 +1341,14 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
 void CConfigManager::init() {
 
     g_pConfigWatcher->setOnChange([this](const CConfigWatcher::SConfigWatchEvent& e) {
+        // editors like to touch or rewrite files with the same contents. A save still resets hyprctl keyword values though, like it always did.
+        if (!m_hasRuntimeKeywords && !configFileChanged(e.file)) {
+            Debug::log(LOG, "CConfigManager: file {} touched but unchanged, ignoring", e.file);
+            return;
+        }
+
         Debug::log(LOG, "CConfigManager: file {} modified, reloading", e.file);
-        reload();
+        reload(true);
     });
 
     const std::string CONFIGPATH = getMainConfigPath();
@@ -1129,6 +1362,7 @@ std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::
     static int        prevEnabledExplicit = *PENABLEEXPLICIT;
 
     const auto        RET = m_config->parseDynamic(COMMAND.c_str(), VALUE.c_str());
+    m_hasRuntimeKeywords  = true;
 
     // invalidate layouts if they changed
     if (COMMAND == "monitor" || COMMAND.contains("gaps_") || COMMAND.starts_with("dwindle:") || COMMAND.starts_with("master:")) {
@@ -1313,16 +1547,93 @@ SWorkspaceRule CConfigManager::mergeWorkspaceRules(const SWorkspaceRule& rule1,
     return mergedRule;
 }
 
+void CConfigManager::compileWindowRules() {
+    auto& m = m_windowRuleMatcher;
+
+    m.rules.clear();
+    m.classes.clear();
+    m.titles.clear();
+    m.initialClasses.clear();
+    m.initialTitles.clear();
+
+    m.rules.reserve(m_windowRules.size());
+
+    for (auto const& rule : m_windowRules) {
+        auto& c = m.rules.emplace_back(SCompiledWindowRule{.rule = rule});
+
+        if (!rule->v2)
+            continue;
+
+        if (!rule->szClass.empty())
+            c.classIdx = m.classes.add(rule->szClass);
+        if (!rule->szTitle.empty())
+            c.titleIdx = m.titles.add(rule->szTitle);
+        if (!rule->szInitialClass.empty())
+            c.initialClassIdx = m.initialClasses.add(rule->szInitialClass);
+        if (!rule->szInitialTitle.empty())
+            c.initialTitleIdx = m.initialTitles.add(rule->szInitialTitle);
+
+        try {
+            if (!rule->szFullscreenState.empty()) {
+                const auto ARGS = CVarList(rule->szFullscreenState, 2, ' ');
+
+                if (ARGS[0] != "*") {
+                    if (!isNumber(ARGS[0]))
+                        throw std::runtime_error("szFullscreenState internal mode not valid");
+                    c.fullscreenInternal = (eFullscreenMode)std::stoi(ARGS[0]);
+                }
+
+                if (ARGS[1] != "*") {
+                    if (!isNumber(ARGS[1]))
+                        throw std::runtime_error("szFullscreenState client mode not valid");
+                    c.fullscreenClient = (eFullscreenMode)std::stoi(ARGS[1]);
+                }
+            }
+
+            if (!rule->szWorkspace.empty()) {
+                if (rule->szWorkspace.starts_with("name:"))
+                    c.workspaceName = rule->szWorkspace.substr(5);
+                else {
+                    // number
+                    if (!isNumber(rule->szWorkspace))
+                        throw std::runtime_error("szWorkspace not name: or number");
+
+                    c.workspaceID = std::stoll(rule->szWorkspace);
+                }
+            }
+        } catch (std::exception& e) {
+            Debug::log(ERR, "Window rule {} -> {} will never match: {}", rule->szRule, rule->szValue, e.what());
+            c.invalid = true;
+        }
+
+        if (!rule->szContentType.empty()) {
+            try {
+                c.contentType = NContentType::fromString(rule->szContentType);
+            } catch (std::exception& e) { Debug::log(ERR, "Rule \"content:{}\" failed with: {}", rule->szContentType, e.what()); }
+        }
+    }
+
+    m.classes.compile();
+    m.titles.compile();
+    m.initialClasses.compile();
+    m.initialTitles.compile();
+
+    m.dirty = false;
+}
+
 std::vector<SP<CWindowRule>> CConfigManager::getMatchingRules(PHLWINDOW pWindow, bool dynamic, bool shadowExec) {
     if (!valid(pWindow))
         return std::vector<SP<CWindowRule>>();
 
+    if (m_windowRuleMatcher.dirty)
+        compileWindowRules();
+
     // if the window is unmapped, don't process exec rules yet.
     shadowExec = shadowExec || !pWindow->m_bIsMapped;
 
     std::vector<SP<CWindowRule>> returns;
 
-    Debug::log(LOG, "Searching for matching rules for {} (title: {})", pWindow->m_szClass, pWindow->m_szTitle);
+    Debug::log(TRACE, "Searching for matching rules for {} (title: {})", pWindow->m_szClass, pWindow->m_szTitle);
 
     // since some rules will be applied later, we need to store some flags
     bool hasFloating   = pWindow->m_bIsFloating;
@@ -1331,7 +1642,20 @@ std::vector<SP<CWindowRule>> CConfigManager::getMatchingRules(PHLWINDOW pWindow,
     // local tags for dynamic tag rule match
     auto tags = pWindow->m_tags;
 
-    for (auto const& rule : m_windowRules) {
+    // every regex of a field is matched in one go, results are cached per string, so title changes only rematch titles
+    auto&       m                   = m_windowRuleMatcher;
+    const auto  EMPTY               = std::vector<bool>{};
+    const auto& CLASSMATCHES        = m.classes.empty() ? EMPTY : m.classes.match(pWindow->m_szClass);
+    const auto& TITLEMATCHES        = m.titles.empty() ? EMPTY : m.titles.match(pWindow->m_szTitle);
+    const auto& INITIALCLASSMATCHES = m.initialClasses.empty() ? EMPTY : m.initialClasses.match(pWindow->m_szInitialClass);
+    const auto& INITIALTITLEMATCHES = m.initialTitles.empty() ? EMPTY : m.initialTitles.match(pWindow->m_szInitialTitle);
+
+    const auto  PWORKSPACE = pWindow->m_pWorkspace;
+    const bool  FOCUSED    = g_pCompositor->m_lastWindow.lock() == pWindow;
+
+    for (auto const& c : m.rules) {
+        const auto& rule = c.rule;
+
         // check if we have a matching rule
         if (!rule->v2) {
             try {
@@ -1349,121 +1673,65 @@ std::vector<SP<CWindowRule>> CConfigManager::getMatchingRules(PHLWINDOW pWindow,
                 continue;
             }
         } else {
-            try {
-                if (rule->bX11 != -1) {
-                    if (pWindow->m_bIsX11 != rule->bX11)
-                        continue;
-                }
-
-                if (rule->bFloating != -1) {
-                    if (hasFloating != rule->bFloating)
-                        continue;
-                }
-
-                if (rule->bFullscreen != -1) {
-                    if (hasFullscreen != rule->bFullscreen)
-                        continue;
-                }
-
-                if (rule->bPinned != -1) {
-                    if (pWindow->m_bPinned != rule->bPinned)
-                        continue;
-                }
-
-                if (rule->bFocus != -1) {
-                    if (rule->bFocus != (g_pCompositor->m_lastWindow.lock() == pWindow))
-                        continue;
-                }
-
-                if (!rule->szFullscreenState.empty()) {
-                    const auto ARGS = CVarList(rule->szFullscreenState, 2, ' ');
-                    //
-                    std::optional<eFullscreenMode> internalMode, clientMode;
-
-                    if (ARGS[0] == "*")
-                        internalMode = std::nullopt;
-                    else if (isNumber(ARGS[0]))
-                        internalMode = (eFullscreenMode)std::stoi(ARGS[0]);
-                    else
-                        throw std::runtime_error("szFullscreenState internal mode not valid");
-
-                    if (ARGS[1] == "*")
-                        clientMode = std::nullopt;
-                    else if (isNumber(ARGS[1]))
-                        clientMode = (eFullscreenMode)std::stoi(ARGS[1]);
-                    else
-                        throw std::runtime_error("szFullscreenState client mode not valid");
+            if (c.invalid)
+                continue;
 
-                    if (internalMode.has_value() && pWindow->m_sFullscreenState.internal != internalMode)
-                        continue;
+            if (rule->bX11 != -1 && pWindow->m_bIsX11 != rule->bX11)
+                continue;
 
-                    if (clientMode.has_value() && pWindow->m_sFullscreenState.client != clientMode)
-                        continue;
-                }
+            if (rule->bFloating != -1 && hasFloating != rule->bFloating)
+                continue;
 
-                if (!rule->szOnWorkspace.empty()) {
-                    const auto PWORKSPACE = pWindow->m_pWorkspace;
-                    if (!PWORKSPACE || !PWORKSPACE->matchesStaticSelector(rule->szOnWorkspace))
-                        continue;
-                }
+            if (rule->bFullscreen != -1 && hasFullscreen != rule->bFullscreen)
+                continue;
 
-                if (!rule->szContentType.empty()) {
-                    try {
-                        const auto contentType = NContentType::fromString(rule->szContentType);
-                        if (pWindow->getContentType() != contentType)
-                            continue;
-                    } catch (std::exception& e) { Debug::log(ERR, "Rule \"content:{}\" failed with: {}", rule->szContentType, e.what()); }
-                }
+            if (rule->bPinned != -1 && pWindow->m_bPinned != rule->bPinned)
+                continue;
 
-                if (!rule->szXdgTag.empty()) {
-                    if (pWindow->xdgTag().value_or("") != rule->szXdgTag)
-                        continue;
-                }
+            if (rule->bFocus != -1 && rule->bFocus != FOCUSED)
+                continue;
 
-                if (!rule->szWorkspace.empty()) {
-                    const auto PWORKSPACE = pWindow->m_pWorkspace;
+            if (c.fullscreenInternal.has_value() && pWindow->m_sFullscreenState.internal != c.fullscreenInternal)
+                continue;
 
-                    if (!PWORKSPACE)
-                        continue;
+            if (c.fullscreenClient.has_value() && pWindow->m_sFullscreenState.client != c.fullscreenClient)
+                continue;
 
-                    if (rule->szWorkspace.starts_with("name:")) {
-                        if (PWORKSPACE->m_szName != rule->szWorkspace.substr(5))
-                            continue;
-                    } else {
-                        // number
-                        if (!isNumber(rule->szWorkspace))
-                            throw std::runtime_error("szWorkspace not name: or number");
+            if (!rule->szOnWorkspace.empty() && (!PWORKSPACE || !PWORKSPACE->matchesStaticSelector(rule->szOnWorkspace)))
+                continue;
 
-                        const int64_t ID = std::stoll(rule->szWorkspace);
+            if (c.contentType.has_value() && pWindow->getContentType() != c.contentType)
+                continue;
 
-                        if (PWORKSPACE->m_iID != ID)
-                            continue;
-                    }
-                }
+            if (!rule->szXdgTag.empty() && pWindow->xdgTag().value_or("") != rule->szXdgTag)
+                continue;
 
-                if (!rule->szTag.empty() && !tags.isTagged(rule->szTag))
+            if (!rule->szWorkspace.empty()) {
+                if (!PWORKSPACE)
                     continue;
 
-                if (!rule->szClass.empty() && !rule->rClass.passes(pWindow->m_szClass))
+                if (c.workspaceID.has_value() ? PWORKSPACE->m_iID != *c.workspaceID : PWORKSPACE->m_szName != c.workspaceName)
                     continue;
+            }
 
-                if (!rule->szTitle.empty() && !rule->rTitle.passes(pWindow->m_szTitle))
-                    continue;
+            if (!rule->szTag.empty() && !tags.isTagged(rule->szTag))
+                continue;
 
-                if (!rule->szInitialTitle.empty() && !rule->rInitialTitle.passes(pWindow->m_szInitialTitle))
-                    continue;
+            if (c.classIdx != -1 && !CLASSMATCHES[c.classIdx])
+                continue;
 
-                if (!rule->szInitialClass.empty() && !rule->rInitialClass.passes(pWindow->m_szInitialClass))
-                    continue;
+            if (c.titleIdx != -1 && !TITLEMATCHES[c.titleIdx])
+                continue;
 
-            } catch (std::exception& e) {
-                Debug::log(ERR, "Regex error at {} ({})", rule->szValue, e.what());
+            if (c.initialTitleIdx != -1 && !INITIALTITLEMATCHES[c.initialTitleIdx])
+                continue;
+
+            if (c.initialClassIdx != -1 && !INITIALCLASSMATCHES[c.initialClassIdx])
                 continue;
-            }
         }
 
         // applies. Read the rule and behave accordingly
-        Debug::log(LOG, "Window rule {} -> {} matched {}", rule->szRule, rule->szValue, pWindow);
+        Debug::log(TRACE, "Window rule {} -> {} matched {}", rule->szRule, rule->szValue, pWindow);
 
         returns.emplace_back(rule);
 
@@ -1502,17 +1770,42 @@ std::vector<SP<CWindowRule>> CConfigManager::getMatchingRules(PHLWINDOW pWindow,
     return returns;
 }
 
+void CConfigManager::compileLayerRules() {
+    auto& m = m_layerRuleMatcher;
+
+    m.namespaces.clear();
+    m.namespaceIdx.clear();
+    m.namespaceIdx.reserve(m_layerRules.size());
+
+    for (auto const& lr : m_layerRules) {
+        m.namespaceIdx.push_back(lr->targetNamespace.starts_with("address:0x") ? -1 : m.namespaces.add(lr->targetNamespace));
+    }
+
+    m.namespaces.compile();
+
+    m.dirty = false;
+}
+
 std::vector<SP<CLayerRule>> CConfigManager::getMatchingRules(PHLLS pLS) {
     std::vector<SP<CLayerRule>> returns;
 
     if (!pLS->layerSurface || pLS->fadingOut)
         return returns;
 
-    for (auto const& lr : m_layerRules) {
-        if (lr->targetNamespace.starts_with("address:0x")) {
+    if (m_layerRuleMatcher.dirty)
+        compileLayerRules();
+
+    const auto  EMPTY   = std::vector<bool>{};
+    const auto& MATCHES = m_layerRuleMatcher.namespaces.empty() ? EMPTY : m_layerRuleMatcher.namespaces.match(pLS->layerSurface->layerNamespace);
+
+    for (size_t i = 0; i < m_layerRules.size(); ++i) {
+        const auto& lr  = m_layerRules[i];
+        const auto  IDX = m_layerRuleMatcher.namespaceIdx[i];
+
+        if (IDX == -1) {
             if (std::format("address:0x{:x}", (uintptr_t)pLS.get()) != lr->targetNamespace)
                 continue;
-        } else if (!lr->targetNamespaceRegex.passes(pLS->layerSurface->layerNamespace))
+        } else if (!MATCHES[IDX])
             continue;
 
         // hit
@@ -2581,6 +2874,7 @@ std::optional<std::string> CConfigManager::handleWindowRule(const std::string& c
                 return true;
             }
         });
+        m_windowRuleMatcher.dirty = true;
         return {};
     }
 
@@ -2589,6 +2883,8 @@ std::optional<std::string> CConfigManager::handleWindowRule(const std::string& c
     else
         m_windowRules.push_back(rule);
 
+    m_windowRuleMatcher.dirty = true;
+
     return {};
 }
 
@@ -2602,6 +2898,7 @@ std::optional<std::string> CConfigManager::handleLayerRule(const std::string& co
 
     if (RULE == "unset") {
         std::erase_if(m_layerRules, [&](const auto& other) { return other->targetNamespace == VALUE; });
+        m_layerRuleMatcher.dirty = true;
         return {};
     }
 
@@ -2615,6 +2912,7 @@ std::optional<std::string> CConfigManager::handleLayerRule(const std::string& co
     rule->targetNamespaceRegex = {VALUE};
 
     m_layerRules.emplace_back(rule);
+    m_layerRuleMatcher.dirty = true;
 
     for (auto const& m : g_pCompositor->m_monitors)
         for (auto const& lsl : m->m_aLayerSurfaceLayers)
@@ -159,12 +159,24 @@ namespace std {
     };
 }
 
+// what a reload touched, used to only refresh the subsystems that depend on it
+enum eConfigChange : uint32_t {
+    CONFIG_CHANGE_NONE        = 0,
+    CONFIG_CHANGE_INPUT       = (1 << 0), // input:, device blocks
+    CONFIG_CHANGE_LAYOUT      = (1 << 1), // anything the layouts read
+    CONFIG_CHANGE_DECORATIONS = (1 << 2), // borders, shadows, groupbars
+    CONFIG_CHANGE_RENDER      = (1 << 3), // shaders, background, blur
+    CONFIG_CHANGE_MONITORS    = (1 << 4), // monitor rules
+    CONFIG_CHANGE_RULES       = (1 << 5), // window, layer and workspace rules
+    CONFIG_CHANGE_ALL         = UINT32_MAX,
+};
+
 class CConfigManager {
   public:
     CConfigManager();
 
     void                                                            init();
-    void                                                            reload();
+    void                                                            reload(bool incremental = false);
     std::string                                                     verify();
 
     int                                                             getDeviceInt(const std::string&, const std::string&, const std::string& fallback = "");
@@ -246,6 +258,8 @@ class CConfigManager {
     std::optional<std::string> handlePlugin(const std::string&, const std::string&);
     std::optional<std::string> handlePermission(const std::string&, const std::string&);
 
+    void                       recordKeyword(const std::string& command, const std::string& value);
+
     std::string                m_configCurrentPath;
 
     bool                       m_wantsMonitorReload                  = false;
@@ -279,6 +293,37 @@ class CConfigManager {
     std::vector<SP<CLayerRule>>                      m_layerRules;
     std::vector<std::string>                         m_blurLSNamespaces;
 
+    // window rules with their predicates parsed, and regexes grouped into sets per field.
+    // rebuilt lazily after the rules change.
+    struct SCompiledWindowRule {
+        SP<CWindowRule>                           rule;
+        int                                       classIdx        = -1;
+        int                                       titleIdx        = -1;
+        int                                       initialClassIdx = -1;
+        int                                       initialTitleIdx = -1;
+        bool                                      invalid         = false; // a predicate failed to parse, never matches
+        std::optional<eFullscreenMode>            fullscreenInternal;
+        std::optional<eFullscreenMode>            fullscreenClient;
+        std::optional<NContentType::eContentType> contentType;
+        std::optional<int64_t>                    workspaceID;
+        std::string                               workspaceName;
+    };
+
+    struct {
+        std::vector<SCompiledWindowRule> rules;
+        CRuleRegexSet                    classes;
+        CRuleRegexSet                    titles;
+        CRuleRegexSet                    initialClasses;
+        CRuleRegexSet                    initialTitles;
+        bool                             dirty = true;
+    } m_windowRuleMatcher;
+
+    struct {
+        std::vector<int> namespaceIdx; // per layer rule, -1 for address: rules
+        CRuleRegexSet    namespaces;
+        bool             dirty = true;
+    } m_layerRuleMatcher;
+
     bool                                             m_firstExecDispatched  = false;
     bool                                             m_manualCrashInitiated = false;
 
@@ -290,20 +335,40 @@ class CConfigManager {
 
     uint32_t                                         m_configValueNumber = 0;
 
+    // for incremental reloads
+    struct SConfigSnapshot {
+        std::unordered_map<std::string, std::string> values;   // registered and plugin values, stringified
+        std::unordered_map<std::string, std::string> devices;  // "device:key" for connected devices with a device block
+        std::unordered_map<std::string, std::string> keywords; // all values per tracked keyword, in order
+    };
+
+    std::vector<std::string>                         m_registeredConfigVars;
+    std::vector<std::string>                         m_deviceConfigVars;
+    std::unordered_map<std::string, std::string>     m_parsedKeywords;
+    std::unordered_map<std::string, size_t>          m_configFileHashes;
+    bool                                             m_hasRuntimeKeywords = false; // set by hyprctl keyword, a reload drops those
+
     // internal methods
     void                                      updateBlurredLS(const std::string&, const bool);
     void                                      setDefaultAnimationVars();
     std::optional<std::string>                resetHLConfig();
     std::optional<std::string>                generateConfig(std::string configPath);
     std::optional<std::string>                verifyConfigExists();
-    void                                      postConfigReload(const Hyprlang::CParseResult& result);
+    void                                      postConfigReload(const Hyprlang::CParseResult& result, uint32_t changes = CONFIG_CHANGE_ALL);
+    SConfigSnapshot                           snapshotConfig();
+    uint32_t                                  diffConfig(const SConfigSnapshot& before, const SConfigSnapshot& after);
+    bool                                      configFileChanged(const std::string& path);
+    void                                      updateFileHashes();
     SWorkspaceRule                            mergeWorkspaceRules(const SWorkspaceRule&, const SWorkspaceRule&);
+    void                                      compileWindowRules();
+    void                                      compileLayerRules();
 
     void                                      registerConfigVar(const char* name, const Hyprlang::INT& val);
     void                                      registerConfigVar(const char* name, const Hyprlang::FLOAT& val);
     void                                      registerConfigVar(const char* name, const Hyprlang::VEC2& val);
     void                                      registerConfigVar(const char* name, const Hyprlang::STRING& val);
     void                                      registerConfigVar(const char* name, Hyprlang::CUSTOMTYPE&& val);
+    void                                      registerDeviceConfigVar(const char* name, const Hyprlang::CConfigValue& val);
 
     std::unordered_map<SFloatCache, Vector2D> m_mStoredFloatingSizes;
 
@@ -0,0 +1,48 @@
+#include "AllocStats.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+// counts every C++ allocation in the process. Not free, hence only built with ALLOC_STATS, meant for hyprbench builds.
+static thread_local uint64_t threadAllocs = 0;
+
+uint64_t AllocStats::threadAllocations() {
+    return threadAllocs;
+}
+
+void* operator new(size_t size) {
+    threadAllocs++;
+
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+    threadAllocs++;
+
+    const auto ALIGN = std::max<size_t>((size_t)align, sizeof(void*));
+    void*      p     = nullptr;
+    if (posix_memalign(&p, ALIGN, size ? size : 1) == 0)
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
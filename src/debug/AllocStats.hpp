@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+    Global operator new / delete replacements that count allocations per thread.
+    AllocStats.cpp is only built with HYPRLAND_ALLOC_STATS (-DALLOC_STATS=ON, -Dalloc_stats=true),
+    nothing here exists otherwise. Go through Trace::threadAllocations().
+*/
+// NOLINTNEXTLINE(readability-identifier-naming)
+namespace AllocStats {
+    // operator new calls made by this thread so far
+    uint64_t threadAllocations();
+};
@@ -242,5 +242,6 @@ void NCrashReporter::createAndSaveCrash(int sig) {
 
     finalCrashReport += "\n\nLog tail:\n";
 
-    finalCrashReport += std::string_view(Debug::m_rollingLog).substr(Debug::m_rollingLog.find('\n') + 1);
+    const auto ROLLINGLOG = Debug::m_rollingLog.strForCrashReport();
+    finalCrashReport += std::string_view(ROLLINGLOG).substr(ROLLINGLOG.find('\n') + 1);
 }
@@ -14,7 +14,7 @@
 #include <sys/utsname.h>
 #include <sys/un.h>
 #include <unistd.h>
-#include <sys/poll.h>
+#include <fcntl.h>
 #include <filesystem>
 #include <ranges>
 
@@ -37,7 +37,6 @@ using namespace Hyprutils::OS;
 #include "../devices/ITouch.hpp"
 #include "../devices/Tablet.hpp"
 #include "../protocols/GlobalShortcuts.hpp"
-#include "debug/RollingLogFollow.hpp"
 #include "config/ConfigManager.hpp"
 #include "helpers/MiscFunctions.hpp"
 #include "../desktop/LayerSurface.hpp"
@@ -49,7 +48,9 @@ using namespace Hyprutils::OS;
 #include "../managers/LayoutManager.hpp"
 #include "../plugins/PluginSystem.hpp"
 #include "../managers/AnimationManager.hpp"
+#include "../managers/HookSystemManager.hpp"
 #include "../debug/HyprNotificationOverlay.hpp"
+#include "../debug/Trace.hpp"
 #include "../render/Renderer.hpp"
 #include "../render/OpenGL.hpp"
 
@@ -805,15 +806,168 @@ static std::string rollinglogRequest(eHyprCtlOutputFormat format, std::string re
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[\n\"log\":\"";
-        result += escapeJSONStrings(Debug::m_rollingLog);
+        result += escapeJSONStrings(Debug::m_rollingLog.str());
         result += "\"]";
     } else {
-        result = Debug::m_rollingLog;
+        result = Debug::m_rollingLog.str();
     }
 
     return result;
 }
 
+static std::string gpuMemoryRequest(eHyprCtlOutputFormat format, std::string request) {
+    // sizes are estimated from the dimensions and formats, drivers may pad / compress
+    std::vector<std::pair<std::string, std::vector<std::pair<std::string, size_t>>>> groups;
+
+    for (auto& [mon, data] : g_pHyprOpenGL->m_mMonitorRenderResources) {
+        const auto PMONITOR = mon.lock();
+        if (!PMONITOR)
+            continue;
+
+        const auto                                  BGIT    = g_pHyprOpenGL->m_mMonitorBGFBs.find(mon);
+        std::vector<std::pair<std::string, size_t>> entries = {
+            {"offload", data.offloadFB.bytes()},
+            {"monitorMirror", data.monitorMirrorFB.bytes()},
+            {"blur", data.blurFB.bytes()},
+            {"stencil", data.offloadFB.isAllocated() ? (size_t)data.offloadFB.m_vSize.x * data.offloadFB.m_vSize.y * 4 : 0},
+            {"background", BGIT != g_pHyprOpenGL->m_mMonitorBGFBs.end() ? BGIT->second.bytes() : 0},
+        };
+
+        groups.emplace_back(PMONITOR->szName, std::move(entries));
+    }
+
+    size_t windowBytes = 0, layerBytes = 0;
+    for (auto& [w, snapshot] : g_pHyprOpenGL->m_mWindowFramebuffers) {
+        windowBytes += snapshot.fb ? snapshot.fb->bytes() : 0;
+    }
+    for (auto& [l, snapshot] : g_pHyprOpenGL->m_mLayerFramebuffers) {
+        layerBytes += snapshot.fb ? snapshot.fb->bytes() : 0;
+    }
+
+    groups.emplace_back("shared",
+                        std::vector<std::pair<std::string, size_t>>{
+                            // effect buffers (mirror, mirrorSwap, offMain) live here between frames
+                            {"pool", g_pHyprOpenGL->m_pFramebufferPool->bytes()},
+                            {"blurCache", g_pHyprOpenGL->m_pBlurCache->bytes()},
+                            {"shmReadback", g_pHyprOpenGL->m_pShmReadback->bytes()},
+                            {"textCache", g_pHyprOpenGL->m_pTextCache->bytes()},
+                            {"windowSnapshots", windowBytes},
+                            {"layerSnapshots", layerBytes},
+                        });
+
+    std::string result = "";
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        result += "{";
+        for (auto const& [name, entries] : groups) {
+            size_t total = 0;
+            result += std::format("\n    \"{}\": {{", escapeJSONStrings(name));
+            for (auto const& [purpose, bytes] : entries) {
+                result += std::format("\n        \"{}\": {},", purpose, bytes);
+                total += bytes;
+            }
+            result += std::format("\n        \"total\": {}\n    }},", total);
+        }
+        trimTrailingComma(result);
+        result += "\n}\n";
+    } else {
+        for (auto const& [name, entries] : groups) {
+            size_t total = 0;
+            result += std::format("{}:\n", name);
+            for (auto const& [purpose, bytes] : entries) {
+                result += std::format("\t{}: {:.2f} MiB\n", purpose, bytes / 1048576.0);
+                total += bytes;
+            }
+            result += std::format("\ttotal: {:.2f} MiB\n\n", total / 1048576.0);
+        }
+    }
+
+    return result;
+}
+
+static std::string hooksRequest(eHyprCtlOutputFormat format, std::string request) {
+    if (request.substr(request.find_last_of(' ') + 1) == "reset") {
+        g_pHookSystem->resetProfile();
+        return "ok";
+    }
+
+    std::string result = "";
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+        result += "[";
+    else if (!g_pHookSystem->m_bProfiling)
+        result += "note: debug:profile_hooks is off, timings are not being collected\n\n";
+
+    for (auto const& [event, callbacks] : g_pHookSystem->getRegisteredHooks()) {
+        if (callbacks.empty())
+            continue;
+
+        if (format != eHyprCtlOutputFormat::FORMAT_JSON)
+            result += std::format("{}:\n", event);
+
+        for (auto const& cb : callbacks) {
+            const auto        PPLUGIN = cb.handle ? g_pPluginSystem->getPluginByHandle(cb.handle) : nullptr;
+            const std::string OWNER   = PPLUGIN ? PPLUGIN->name : (cb.handle ? "unknown plugin" : "hyprland");
+            const double      TOTALUS = cb.totalNs / 1000.0;
+            const double      AVGUS   = cb.calls ? TOTALUS / cb.calls : 0.0;
+
+            if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+                result += std::format(R"#(
+{{
+    "event": "{}",
+    "owner": "{}",
+    "calls": {},
+    "totalUs": {:.2f},
+    "avgUs": {:.2f},
+    "maxUs": {:.2f}
+}},)#",
+                                      escapeJSONStrings(event), escapeJSONStrings(OWNER), cb.calls, TOTALUS, AVGUS, cb.maxNs / 1000.0);
+            } else
+                result += std::format("\t{}: {} calls, total {:.2f}µs, avg {:.2f}µs, max {:.2f}µs\n", OWNER, cb.calls, TOTALUS, AVGUS, cb.maxNs / 1000.0);
+        }
+    }
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        trimTrailingComma(result);
+        result += "]";
+    }
+
+    return result;
+}
+
+static std::string traceRequest(eHyprCtlOutputFormat format, std::string request) {
+    CVarList   vars(request, 0, ' ');
+    const auto ACTION = vars.size() > 1 ? vars[1] : "status";
+
+    if (ACTION == "start") {
+        Trace::start();
+        return "ok";
+    } else if (ACTION == "stop") {
+        Trace::stop();
+        return "ok";
+    } else if (ACTION == "dump") {
+        // the rest is the path, it may contain spaces
+        const auto PATH  = vars.size() > 2 ? trim(request.substr(request.find("dump") + 4)) : g_pCompositor->m_instancePath + "/trace.json";
+        const auto ERROR = Trace::dump(PATH);
+
+        if (!ERROR.empty())
+            return "error: " + ERROR;
+
+        return format == eHyprCtlOutputFormat::FORMAT_JSON ? std::format(R"#({{"path": "{}"}})#", escapeJSONStrings(PATH)) : PATH;
+    } else if (ACTION != "status")
+        return "error: unknown action, expected start, stop, dump [path] or status";
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+        return std::format(R"#({{
+    "recording": {},
+    "gpuTimings": {},
+    "events": {}
+}})#",
+                           Trace::enabled() ? "true" : "false", g_pHyprOpenGL->m_sExts.EXT_disjoint_timer_query ? "true" : "false", Trace::eventCount());
+
+    return std::format("recording: {}\ngpu timings: {}\nevents: {}\n", Trace::enabled() ? "yes" : "no", g_pHyprOpenGL->m_sExts.EXT_disjoint_timer_query ? "yes" : "no",
+                       Trace::eventCount());
+}
+
 static std::string globalShortcutsRequest(eHyprCtlOutputFormat format, std::string request) {
     std::string ret       = "";
     const auto  SHORTCUTS = PROTO::globalShortcuts->getAllShortcuts();
@@ -843,7 +997,7 @@ static std::string globalShortcutsRequest(eHyprCtlOutputFormat format, std::stri
 static std::string bindsRequest(eHyprCtlOutputFormat format, std::string request) {
     std::string ret = "";
     if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
-        for (auto const& kb : g_pKeybindManager->m_vKeybinds) {
+        for (auto const& kb : g_pKeybindManager->getKeybinds()) {
             ret += "bind";
             if (kb->locked)
                 ret += "l";
@@ -864,7 +1018,7 @@ static std::string bindsRequest(eHyprCtlOutputFormat format, std::string request
     } else {
         // json
         ret += "[";
-        for (auto const& kb : g_pKeybindManager->m_vKeybinds) {
+        for (auto const& kb : g_pKeybindManager->getKeybinds()) {
             ret += std::format(
                 R"#(
 {{
@@ -1672,6 +1826,7 @@ CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"systeminfo", true, systemInfoRequest});
     registerCommand(SHyprCtlCommand{"animations", true, animationsRequest});
     registerCommand(SHyprCtlCommand{"rollinglog", true, rollinglogRequest});
+    registerCommand(SHyprCtlCommand{"gpumemory", true, gpuMemoryRequest});
     registerCommand(SHyprCtlCommand{"layouts", true, layoutsRequest});
     registerCommand(SHyprCtlCommand{"configerrors", true, configErrorsRequest});
     registerCommand(SHyprCtlCommand{"locked", true, getIsLocked});
@@ -1693,12 +1848,28 @@ CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"setcursor", false, dispatchSetCursor});
     registerCommand(SHyprCtlCommand{"getoption", false, dispatchGetOption});
     registerCommand(SHyprCtlCommand{"decorations", false, decorationRequest});
+    registerCommand(SHyprCtlCommand{"hooks", false, hooksRequest});
+    registerCommand(SHyprCtlCommand{"trace", false, traceRequest});
     registerCommand(SHyprCtlCommand{"[[BATCH]]", false, dispatchBatch});
 
     startHyprCtlSocket();
 }
 
 CHyprCtl::~CHyprCtl() {
+    for (const auto& client : m_clients) {
+        wl_event_source_remove(client.eventSource);
+    }
+
+    for (const auto& follower : m_logFollowers) {
+        wl_event_source_remove(follower.eventSource);
+    }
+
+    if (!m_logFollowers.empty())
+        Debug::m_rollingLog.setFollowed(false);
+
+    if (m_logWakeSource)
+        wl_event_source_remove(m_logWakeSource);
+
     if (m_eventSource)
         wl_event_source_remove(m_eventSource);
     if (!m_socketPath.empty())
@@ -1714,6 +1885,8 @@ void CHyprCtl::unregisterCommand(const SP<SHyprCtlCommand>& cmd) {
 }
 
 std::string CHyprCtl::getReply(std::string request) {
+    TRACE_ZONE("hyprctl", "ipc");
+
     auto format            = eHyprCtlOutputFormat::FORMAT_NORMAL;
     bool reloadAll         = false;
     m_currentRequestParams = {};
@@ -1815,114 +1988,302 @@ std::string CHyprCtl::makeDynamicCall(const std::string& input) {
     return getReply(input);
 }
 
-static bool successWrite(int fd, const std::string& data, bool needLog = true) {
-    if (write(fd, data.c_str(), data.length()) > 0)
-        return true;
+static bool isFollowUpRollingLogRequest(const std::string& request) {
+    return request.contains("rollinglog") && request.contains("f");
+}
 
-    if (errno == EAGAIN)
-        return true;
+std::string CHyprCtl::replyTo(const std::string& request) {
+    std::string reply = "";
 
-    if (needLog)
-        Debug::log(ERR, "Couldn't write to socket. Error: " + std::string(strerror(errno)));
+    try {
+        reply = getReply(request);
+    } catch (std::exception& e) {
+        Debug::log(ERR, "Error in request: {}", e.what());
+        reply = "Err: " + std::string(e.what());
+    }
 
-    return false;
+    return reply;
 }
 
-static void runWritingDebugLogThread(const int conn) {
-    using namespace std::chrono_literals;
-    Debug::log(LOG, "In followlog thread, got connection, start writing: {}", conn);
-    //will be finished, when reading side close connection
-    std::thread([conn]() {
-        while (Debug::SRollingLogFollow::get().isRunning()) {
-            if (Debug::SRollingLogFollow::get().isEmpty(conn)) {
-                std::this_thread::sleep_for(1000ms);
-                continue;
-            }
-
-            auto line = Debug::SRollingLogFollow::get().getLog(conn);
-            if (!successWrite(conn, line))
-                // We cannot write, when connection is closed. So thread will successfully exit by itself
-                break;
-
-            std::this_thread::sleep_for(100ms);
-        }
-        close(conn);
-        Debug::SRollingLogFollow::get().stopFor(conn);
-    }).detach();
+int CHyprCtl::onServerEvent(int fd, uint32_t mask, void* data) {
+    return g_pHyprCtl->onServerEvent(fd, mask);
 }
 
-static bool isFollowUpRollingLogRequest(const std::string& request) {
-    return request.contains("rollinglog") && request.contains("f");
+int CHyprCtl::onClientEvent(int fd, uint32_t mask, void* data) {
+    return g_pHyprCtl->onClientEvent(fd, mask);
 }
 
-static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
+int CHyprCtl::onServerEvent(int fd, uint32_t mask) {
     if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
         return 0;
 
-    if (!g_pHyprCtl->m_socketFD.isValid())
+    if (!m_socketFD.isValid())
         return 0;
 
-    sockaddr_in            clientAddress;
-    socklen_t              clientSize = sizeof(clientAddress);
+    // the listening socket is non-blocking, drain everything that is queued
+    while (true) {
+        sockaddr_in     clientAddress;
+        socklen_t       clientSize = sizeof(clientAddress);
+        CFileDescriptor ACCEPTEDCONNECTION{accept4(m_socketFD.get(), (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC | SOCK_NONBLOCK)};
 
-    const auto             ACCEPTEDCONNECTION = accept4(g_pHyprCtl->m_socketFD.get(), (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC);
+        if (!ACCEPTEDCONNECTION.isValid()) {
+            if (errno == EINTR)
+                continue;
 
-    std::array<char, 1024> readBuffer;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                Debug::log(ERR, "HyprCtl failed receiving connection, errno: {}", errno);
 
-    //
-    pollfd pollfds[1] = {
-        {
-            .fd     = ACCEPTEDCONNECTION,
-            .events = POLLIN,
-        },
-    };
+            break;
+        }
+
+        if (m_clients.size() >= MAX_CLIENTS) {
+            Debug::log(WARN, "HyprCtl has too many clients ({}), refusing connection", m_clients.size());
+            continue;
+        }
 
-    int ret = poll(pollfds, 1, 5000);
+        auto* eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, ACCEPTEDCONNECTION.get(), WL_EVENT_READABLE, onClientEvent, nullptr);
+        m_clients.emplace_back(SClient{
+            .fd          = std::move(ACCEPTEDCONNECTION),
+            .eventSource = eventSource,
+        });
+    }
+
+    return 0;
+}
 
-    if (ret <= 0) {
-        close(ACCEPTEDCONNECTION);
+int CHyprCtl::onClientEvent(int fd, uint32_t mask) {
+    const auto CLIENTIT = findClientByFD(fd);
+    if (CLIENTIT == m_clients.end())
         return 0;
+
+    auto& client = *CLIENTIT;
+
+    if (mask & WL_EVENT_READABLE && !client.closeAfterWrite) {
+        if (!readFromClient(client)) {
+            removeClientByFD(fd);
+            return 0;
+        }
+
+        handleClientRequests(client);
     }
 
-    std::string request;
+    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP) {
+        removeClientByFD(fd);
+        return 0;
+    }
+
+    if (!flushClient(client)) {
+        removeClientByFD(fd);
+        return 0;
+    }
+
+    if (client.closeAfterWrite && client.writeBuffer.empty()) {
+        if (client.followLog) {
+            wl_event_source_remove(client.eventSource);
+            auto followFD = std::move(client.fd);
+            m_clients.erase(CLIENTIT);
+            startFollowingLog(std::move(followFD));
+        } else
+            removeClientByFD(fd);
+    }
+
+    if (g_pConfigManager->m_wantsMonitorReload)
+        g_pConfigManager->ensureMonitorStatus();
+
+    return 0;
+}
+
+bool CHyprCtl::readFromClient(SClient& client) {
+    std::array<char, 4096> readBuffer;
+
     while (true) {
-        readBuffer.fill(0);
-        auto messageSize = read(ACCEPTEDCONNECTION, readBuffer.data(), 1023);
-        if (messageSize < 1)
-            break;
-        std::string recvd = readBuffer.data();
-        request += recvd;
-        if (messageSize < 1023)
-            break;
+        const auto LEN = read(client.fd.get(), readBuffer.data(), readBuffer.size());
+
+        if (LEN > 0) {
+            client.readBuffer.append(readBuffer.data(), LEN);
+
+            if (client.readBuffer.size() > MAX_REQUEST_BUFFER) {
+                Debug::log(ERR, "HyprCtl client at fd {} exceeded the request size limit, dropping", client.fd.get());
+                return false;
+            }
+
+            continue;
+        }
+
+        if (LEN == 0) {
+            // peer shut down its write side, whatever is buffered is all we are going to get
+            client.closeAfterWrite = true;
+            return client.persistent || !client.readBuffer.empty();
+        }
+
+        if (errno == EINTR)
+            continue;
+
+        return errno == EAGAIN || errno == EWOULDBLOCK;
     }
+}
 
-    std::string reply = "";
+void CHyprCtl::handleClientRequests(SClient& client) {
+    if (client.readBuffer.empty())
+        return;
 
-    try {
-        reply = g_pHyprCtl->getReply(request);
-    } catch (std::exception& e) {
-        Debug::log(ERR, "Error in request: {}", e.what());
-        reply = "Err: " + std::string(e.what());
+    // a persistent client opens with a lone NUL, which no legacy request can start with
+    if (!client.persistent && !client.legacy) {
+        client.persistent = client.readBuffer.front() == '\0';
+        client.legacy     = !client.persistent;
+
+        if (client.persistent)
+            client.readBuffer.erase(0, 1);
     }
 
-    successWrite(ACCEPTEDCONNECTION, reply);
+    if (client.persistent) {
+        // every request is terminated with a NUL, and so is every reply. Anything after the last NUL is an incomplete request.
+        size_t start = 0;
+        for (auto end = client.readBuffer.find('\0'); end != std::string::npos; end = client.readBuffer.find('\0', start)) {
+            client.writeBuffer += replyTo(client.readBuffer.substr(start, end - start));
+            client.writeBuffer += '\0';
+            start = end + 1;
+        }
 
-    if (isFollowUpRollingLogRequest(request)) {
-        Debug::log(LOG, "Followup rollinglog request received. Starting thread to write to socket.");
-        Debug::SRollingLogFollow::get().startFor(ACCEPTEDCONNECTION);
-        runWritingDebugLogThread(ACCEPTEDCONNECTION);
-        Debug::log(LOG, Debug::SRollingLogFollow::get().debugInfo());
-    } else
-        close(ACCEPTEDCONNECTION);
+        client.readBuffer.erase(0, start);
+        return;
+    }
 
-    if (g_pConfigManager->m_wantsMonitorReload)
-        g_pConfigManager->ensureMonitorStatus();
+    // legacy clients send a single unterminated request, we answer and close
+    const auto REQUEST = std::move(client.readBuffer);
+    client.readBuffer.clear();
+
+    client.writeBuffer += replyTo(REQUEST);
+    client.closeAfterWrite = true;
+    client.followLog       = isFollowUpRollingLogRequest(REQUEST);
+}
+
+bool CHyprCtl::flushClient(SClient& client) {
+    while (client.writeOffset < client.writeBuffer.size()) {
+        const auto LEN = send(client.fd.get(), client.writeBuffer.data() + client.writeOffset, client.writeBuffer.size() - client.writeOffset, MSG_NOSIGNAL);
+
+        if (LEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+
+            Debug::log(ERR, "Couldn't write to socket. Error: {}", strerror(errno));
+            return false;
+        }
+
+        client.writeOffset += LEN;
+    }
+
+    if (client.writeOffset >= client.writeBuffer.size()) {
+        client.writeBuffer.clear();
+        client.writeOffset = 0;
+    }
+
+    uint32_t events = client.closeAfterWrite ? 0 : WL_EVENT_READABLE;
+    if (!client.writeBuffer.empty())
+        events |= WL_EVENT_WRITABLE;
+
+    wl_event_source_fd_update(client.eventSource, events);
+
+    return true;
+}
+
+int CHyprCtl::onLogWake(int fd, uint32_t mask, void* data) {
+    Debug::m_rollingLog.consumeWake();
+
+    for (auto it = g_pHyprCtl->m_logFollowers.begin(); it != g_pHyprCtl->m_logFollowers.end();) {
+        if (!g_pHyprCtl->flushFollower(*it)) {
+            wl_event_source_remove(it->eventSource);
+            it = g_pHyprCtl->m_logFollowers.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+
+    if (g_pHyprCtl->m_logFollowers.empty())
+        Debug::m_rollingLog.setFollowed(false);
+
+    return 0;
+}
+
+int CHyprCtl::onFollowerEvent(int fd, uint32_t mask, void* data) {
+    const auto FOLLOWERIT = std::ranges::find_if(g_pHyprCtl->m_logFollowers, [fd](const auto& f) { return f.fd.get() == fd; });
+    if (FOLLOWERIT == g_pHyprCtl->m_logFollowers.end())
+        return 0;
+
+    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP || !g_pHyprCtl->flushFollower(*FOLLOWERIT))
+        g_pHyprCtl->stopFollowingLog(fd);
 
     return 0;
 }
 
+void CHyprCtl::startFollowingLog(CFileDescriptor fd) {
+    if (!m_logWakeSource) {
+        const auto WAKEFD = Debug::m_rollingLog.wakeFD();
+        if (WAKEFD < 0) {
+            Debug::log(ERR, "Couldn't create the rolling log eventfd, can't follow the log");
+            return;
+        }
+
+        m_logWakeSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, WAKEFD, WL_EVENT_READABLE, onLogWake, nullptr);
+    }
+
+    Debug::log(LOG, "Following rolling log to socket {}", fd.get());
+
+    const auto HEADER = std::format("[LOG] Following log to socket: {} started\n", fd.get());
+    send(fd.get(), HEADER.data(), HEADER.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+
+    // hup and error are always polled, writable only while the socket is full
+    auto* eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, fd.get(), 0, onFollowerEvent, nullptr);
+    m_logFollowers.emplace_back(SLogFollower{
+        .fd          = std::move(fd),
+        .eventSource = eventSource,
+        .cursor      = Debug::m_rollingLog.written(),
+    });
+
+    Debug::m_rollingLog.setFollowed(true);
+}
+
+void CHyprCtl::stopFollowingLog(int fd) {
+    const auto FOLLOWERIT = std::ranges::find_if(m_logFollowers, [fd](const auto& f) { return f.fd.get() == fd; });
+    if (FOLLOWERIT == m_logFollowers.end())
+        return;
+
+    wl_event_source_remove(FOLLOWERIT->eventSource);
+    m_logFollowers.erase(FOLLOWERIT);
+
+    if (m_logFollowers.empty())
+        Debug::m_rollingLog.setFollowed(false);
+}
+
+bool CHyprCtl::flushFollower(SLogFollower& follower) {
+    if (!Debug::m_rollingLog.writeTo(follower.fd.get(), follower.cursor))
+        return false;
+
+    wl_event_source_fd_update(follower.eventSource, follower.cursor < Debug::m_rollingLog.written() ? WL_EVENT_WRITABLE : 0);
+
+    return true;
+}
+
+std::vector<CHyprCtl::SClient>::iterator CHyprCtl::findClientByFD(int fd) {
+    return std::ranges::find_if(m_clients, [fd](const auto& client) { return client.fd.get() == fd; });
+}
+
+std::vector<CHyprCtl::SClient>::iterator CHyprCtl::removeClientByFD(int fd) {
+    const auto CLIENTIT = findClientByFD(fd);
+    if (CLIENTIT == m_clients.end())
+        return CLIENTIT;
+
+    wl_event_source_remove(CLIENTIT->eventSource);
+
+    return m_clients.erase(CLIENTIT);
+}
+
 void CHyprCtl::startHyprCtlSocket() {
-    m_socketFD = CFileDescriptor{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    m_socketFD = CFileDescriptor{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)};
 
     if (!m_socketFD.isValid()) {
         Debug::log(ERR, "Couldn't start the Hyprland Socket. (1) IPC will not work.");
@@ -1945,5 +2306,5 @@ void CHyprCtl::startHyprCtlSocket() {
 
     Debug::log(LOG, "Hypr socket started at {}", m_socketPath);
 
-    m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_socketFD.get(), WL_EVENT_READABLE, hyprCtlFDTick, nullptr);
+    m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_socketFD.get(), WL_EVENT_READABLE, onServerEvent, nullptr);
 }
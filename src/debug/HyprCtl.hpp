@@ -32,11 +32,60 @@ class CHyprCtl {
     static std::string getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
 
   private:
-    void                             startHyprCtlSocket();
+    void       startHyprCtlSocket();
+
+    static int onServerEvent(int fd, uint32_t mask, void* data);
+    static int onClientEvent(int fd, uint32_t mask, void* data);
+
+    int        onServerEvent(int fd, uint32_t mask);
+    int        onClientEvent(int fd, uint32_t mask);
+
+    // A connection is either legacy (one unterminated request, reply, close)
+    // or persistent (opens with a NUL, then NUL-terminated requests and replies, any number of them).
+    // The mode is decided by the first byte received.
+    struct SClient {
+        Hyprutils::OS::CFileDescriptor fd;
+        wl_event_source*               eventSource = nullptr;
+        std::string                    readBuffer;
+        std::string                    writeBuffer;
+        size_t                         writeOffset     = 0;
+        bool                           persistent      = false;
+        bool                           legacy          = false;
+        bool                           closeAfterWrite = false;
+        bool                           followLog       = false;
+    };
+
+    // rollinglog -f clients, served from the rolling log buffer whenever it wakes the event loop
+    struct SLogFollower {
+        Hyprutils::OS::CFileDescriptor fd;
+        wl_event_source*               eventSource = nullptr;
+        size_t                         cursor      = 0;
+    };
+
+    static int                       onLogWake(int fd, uint32_t mask, void* data);
+    static int                       onFollowerEvent(int fd, uint32_t mask, void* data);
+
+    void                             startFollowingLog(Hyprutils::OS::CFileDescriptor fd);
+    void                             stopFollowingLog(int fd);
+    bool                             flushFollower(SLogFollower& follower);
+
+    bool                             readFromClient(SClient& client);
+    void                             handleClientRequests(SClient& client);
+    bool                             flushClient(SClient& client);
+    std::string                      replyTo(const std::string& request);
+
+    std::vector<SClient>::iterator   findClientByFD(int fd);
+    std::vector<SClient>::iterator   removeClientByFD(int fd);
 
     std::vector<SP<SHyprCtlCommand>> m_commands;
     wl_event_source*                 m_eventSource = nullptr;
     std::string                      m_socketPath;
+    std::vector<SClient>             m_clients;
+    std::vector<SLogFollower>        m_logFollowers;
+    wl_event_source*                 m_logWakeSource = nullptr;
+
+    static constexpr size_t          MAX_CLIENTS        = 256;
+    static constexpr size_t          MAX_REQUEST_BUFFER = 1024 * 1024;
 };
 
 inline UP<CHyprCtl> g_pHyprCtl;
@@ -1,10 +1,152 @@
 #include "Log.hpp"
 #include "../defines.hpp"
-#include "RollingLogFollow.hpp"
 
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <print>
+#include <thread>
+#include <vector>
 #include <fcntl.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+
+struct SLogRecordHeader {
+    uint32_t  length = 0;
+    eLogLevel level  = LOG;
+};
+
+// single producer (the owning thread), single consumer (the writer thread)
+struct SLogRing {
+    std::array<char, LOG_RING_SIZE> buffer = {};
+    std::atomic<size_t>             head   = 0;
+    std::atomic<size_t>             tail   = 0;
+    std::atomic<uint64_t>           dropped  = 0;
+    std::atomic<bool>               orphaned = false;
+};
+
+struct SThreadLogRing {
+    std::shared_ptr<SLogRing> ring;
+
+    ~SThreadLogRing() {
+        if (ring)
+            ring->orphaned = true;
+    }
+};
+
+static struct {
+    std::atomic<bool>                      enabled = false;
+    std::atomic<bool>                      wake    = false;
+    std::atomic<bool>                      stop    = false;
+    std::thread                            writer;
+
+    std::mutex                             ringsMutex;
+    std::vector<std::shared_ptr<SLogRing>> rings;
+} asyncState;
+
+void Debug::CRollingLog::append(std::string_view data) {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        if (data.size() > m_buffer.size())
+            data = data.substr(data.size() - m_buffer.size());
+
+        const size_t START = m_written % m_buffer.size();
+        const size_t FIRST = std::min(data.size(), m_buffer.size() - START);
+        std::memcpy(m_buffer.data() + START, data.data(), FIRST);
+        std::memcpy(m_buffer.data(), data.data() + FIRST, data.size() - FIRST);
+
+        m_written += data.size();
+    }
+
+    if (!m_followed.load(std::memory_order_relaxed) || m_wakePending.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    const uint64_t ONE = 1;
+    (void)write(m_wakeFD.load(std::memory_order_relaxed), &ONE, sizeof(ONE));
+}
+
+std::string Debug::CRollingLog::str() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return tail();
+}
+
+std::string Debug::CRollingLog::strForCrashReport() {
+    std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+    return tail();
+}
+
+std::string Debug::CRollingLog::tail() {
+    const size_t SIZE  = std::min(m_written, (size_t)ROLLING_LOG_SIZE);
+    const size_t START = (m_written - SIZE) % m_buffer.size();
+    const size_t FIRST = std::min(SIZE, m_buffer.size() - START);
+
+    std::string  result;
+    result.reserve(SIZE);
+    result.append(m_buffer.data() + START, FIRST);
+    result.append(m_buffer.data(), SIZE - FIRST);
+
+    return result;
+}
+
+size_t Debug::CRollingLog::written() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_written;
+}
+
+bool Debug::CRollingLog::writeTo(int fd, size_t& cursor) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    const size_t OLDEST = m_written - std::min(m_written, m_buffer.size());
+    if (cursor < OLDEST) {
+        cursor = OLDEST;
+
+        // skip the line we jumped into the middle of
+        while (cursor < m_written && m_buffer[cursor % m_buffer.size()] != '\n') {
+            cursor++;
+        }
+
+        cursor = std::min(cursor + 1, m_written);
+    }
+
+    if (cursor >= m_written)
+        return true;
+
+    const size_t SIZE  = m_written - cursor;
+    const size_t START = cursor % m_buffer.size();
+    const size_t FIRST = std::min(SIZE, m_buffer.size() - START);
+
+    iovec        iovecs[2] = {
+        {.iov_base = m_buffer.data() + START, .iov_len = FIRST},
+        {.iov_base = m_buffer.data(), .iov_len = SIZE - FIRST},
+    };
+
+    const auto LEN = writev(fd, iovecs, SIZE == FIRST ? 1 : 2);
+    if (LEN < 0)
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+    cursor += LEN;
+    return true;
+}
+
+int Debug::CRollingLog::wakeFD() {
+    if (m_wakeFD.load() < 0)
+        m_wakeFD = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    return m_wakeFD.load();
+}
+
+void Debug::CRollingLog::consumeWake() {
+    uint64_t value = 0;
+    (void)read(m_wakeFD.load(std::memory_order_relaxed), &value, sizeof(value));
+    m_wakePending.store(false, std::memory_order_release);
+}
+
+void Debug::CRollingLog::setFollowed(bool followed) {
+    m_followed.store(followed && wakeFD() >= 0, std::memory_order_release);
+}
 
 void Debug::init(const std::string& IS) {
     m_logFile = IS + (ISDEBUG ? "/hyprlandd.log" : "/hyprland.log");
@@ -14,61 +156,239 @@ void Debug::init(const std::string& IS) {
 }
 
 void Debug::close() {
+    setAsync(false);
     m_logOfs.close();
 }
 
-void Debug::log(eLogLevel level, std::string str) {
-    if (level == TRACE && !m_trace)
-        return;
+std::string& Debug::threadFormatBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
 
-    if (m_shuttingDown)
-        return;
+static void appendLine(std::string& plain, std::string& colored, bool wantColored, eLogLevel level, std::string_view str) {
+    std::string_view prefix = "";
+    std::string_view color  = "";
 
-    std::string coloredStr = str;
     //NOLINTBEGIN
     switch (level) {
-        case LOG:
-            str        = "[LOG] " + str;
-            coloredStr = str;
-            break;
+        case LOG: prefix = "[LOG] "; break;
         case WARN:
-            str        = "[WARN] " + str;
-            coloredStr = "\033[1;33m" + str + "\033[0m"; // yellow
+            prefix = "[WARN] ";
+            color  = "\033[1;33m"; // yellow
             break;
         case ERR:
-            str        = "[ERR] " + str;
-            coloredStr = "\033[1;31m" + str + "\033[0m"; // red
+            prefix = "[ERR] ";
+            color  = "\033[1;31m"; // red
             break;
         case CRIT:
-            str        = "[CRITICAL] " + str;
-            coloredStr = "\033[1;35m" + str + "\033[0m"; // magenta
+            prefix = "[CRITICAL] ";
+            color  = "\033[1;35m"; // magenta
             break;
         case INFO:
-            str        = "[INFO] " + str;
-            coloredStr = "\033[1;32m" + str + "\033[0m"; // green
+            prefix = "[INFO] ";
+            color  = "\033[1;32m"; // green
             break;
         case TRACE:
-            str        = "[TRACE] " + str;
-            coloredStr = "\033[1;34m" + str + "\033[0m"; // blue
+            prefix = "[TRACE] ";
+            color  = "\033[1;34m"; // blue
             break;
         default: break;
     }
     //NOLINTEND
 
-    m_rollingLog += str + "\n";
-    if (m_rollingLog.size() > ROLLING_LOG_SIZE)
-        m_rollingLog = m_rollingLog.substr(m_rollingLog.size() - ROLLING_LOG_SIZE);
+    plain.append(prefix).append(str).append("\n");
 
-    if (SRollingLogFollow::get().isRunning())
-        SRollingLogFollow::get().addLog(str);
+    if (!wantColored)
+        return;
+
+    colored.append(color).append(prefix).append(str);
+    if (!color.empty())
+        colored.append("\033[0m");
+    colored.append("\n");
+}
 
-    if (!m_disableLogs || !**m_disableLogs) {
+static bool wantsColoredStdout() {
+    return !Debug::m_disableStdout && !(Debug::m_coloredLogs && !**Debug::m_coloredLogs);
+}
+
+// writes out a batch of complete lines to every sink
+static void emitLines(const std::string& plain, const std::string& colored) {
+    if (plain.empty())
+        return;
+
+    Debug::m_rollingLog.append(plain);
+
+    if (!Debug::m_disableLogs || !**Debug::m_disableLogs) {
         // log to a file
-        m_logOfs << str << "\n";
-        m_logOfs.flush();
+        Debug::m_logOfs << plain;
+        Debug::m_logOfs.flush();
     }
 
     // log it to the stdout too.
-    if (!m_disableStdout)
-        std::println("{}", ((m_coloredLogs && !**m_coloredLogs) ? str : coloredStr));
+    if (!Debug::m_disableStdout)
+        std::print("{}", wantsColoredStdout() ? colored : plain);
+}
+
+static SLogRing& threadLogRing() {
+    thread_local SThreadLogRing local;
+
+    if (!local.ring) {
+        local.ring = std::make_shared<SLogRing>();
+
+        std::lock_guard<std::mutex> guard(asyncState.ringsMutex);
+        asyncState.rings.emplace_back(local.ring);
+    }
+
+    return *local.ring;
+}
+
+static void copyToRing(SLogRing& ring, size_t pos, const void* data, size_t len) {
+    const size_t START = pos % LOG_RING_SIZE;
+    const size_t FIRST = std::min(len, LOG_RING_SIZE - START);
+    std::memcpy(ring.buffer.data() + START, data, FIRST);
+    std::memcpy(ring.buffer.data(), (const char*)data + FIRST, len - FIRST);
+}
+
+static void copyFromRing(const SLogRing& ring, size_t pos, void* data, size_t len) {
+    const size_t START = pos % LOG_RING_SIZE;
+    const size_t FIRST = std::min(len, LOG_RING_SIZE - START);
+    std::memcpy(data, ring.buffer.data() + START, FIRST);
+    std::memcpy((char*)data + FIRST, ring.buffer.data(), len - FIRST);
+}
+
+static void pushToRing(eLogLevel level, std::string_view str) {
+    auto& ring = threadLogRing();
+
+    // a single message may never hog the ring. Cut it, and say so.
+    constexpr std::string_view TRUNCATED  = " [truncated]";
+    constexpr size_t           MAXMESSAGE = LOG_RING_SIZE / 4;
+
+    const bool                 TRUNCATE = str.size() > MAXMESSAGE;
+    if (TRUNCATE)
+        str = str.substr(0, MAXMESSAGE - TRUNCATED.size());
+
+    const size_t           LENGTH = str.size() + (TRUNCATE ? TRUNCATED.size() : 0);
+    const SLogRecordHeader HEADER = {.length = (uint32_t)LENGTH, .level = level};
+    const size_t           NEEDED = sizeof(HEADER) + LENGTH;
+    const size_t           HEAD   = ring.head.load(std::memory_order_relaxed);
+
+    if (LOG_RING_SIZE - (HEAD - ring.tail.load(std::memory_order_acquire)) < NEEDED) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    copyToRing(ring, HEAD, &HEADER, sizeof(HEADER));
+    copyToRing(ring, HEAD + sizeof(HEADER), str.data(), str.size());
+    if (TRUNCATE)
+        copyToRing(ring, HEAD + sizeof(HEADER) + str.size(), TRUNCATED.data(), TRUNCATED.size());
+    ring.head.store(HEAD + NEEDED, std::memory_order_release);
+
+    if (!asyncState.wake.exchange(true, std::memory_order_acq_rel))
+        asyncState.wake.notify_one();
+}
+
+// drains every registered ring into one batch per sink. Called by the writer thread, or with the writer stopped.
+static void drainRings() {
+    std::vector<std::shared_ptr<SLogRing>> rings;
+
+    {
+        std::lock_guard<std::mutex> guard(asyncState.ringsMutex);
+        rings = asyncState.rings;
+        std::erase_if(asyncState.rings, [](const auto& r) { return r->orphaned && r->head.load() == r->tail.load(); });
+    }
+
+    static std::string plain, colored, message;
+    plain.clear();
+    colored.clear();
+
+    const bool WANTCOLORED = wantsColoredStdout();
+
+    for (auto const& ring : rings) {
+        size_t       tail = ring->tail.load(std::memory_order_relaxed);
+        const size_t HEAD = ring->head.load(std::memory_order_acquire);
+
+        while (tail < HEAD) {
+            SLogRecordHeader header;
+            copyFromRing(*ring, tail, &header, sizeof(header));
+            message.resize(header.length);
+            copyFromRing(*ring, tail + sizeof(header), message.data(), header.length);
+            tail += sizeof(header) + header.length;
+
+            appendLine(plain, colored, WANTCOLORED, header.level, message);
+        }
+
+        ring->tail.store(tail, std::memory_order_release);
+
+        if (const auto DROPPED = ring->dropped.exchange(0, std::memory_order_relaxed); DROPPED > 0)
+            appendLine(plain, colored, WANTCOLORED, WARN, std::format("Log ring overflowed, dropped {} messages", DROPPED));
+    }
+
+    // only contended while switching modes
+    std::lock_guard<std::mutex> guard(Debug::m_logMutex);
+    emitLines(plain, colored);
+}
+
+static void writerThread() {
+    while (true) {
+        asyncState.wake.wait(false, std::memory_order_acquire);
+        asyncState.wake.store(false, std::memory_order_release);
+
+        drainRings();
+
+        if (asyncState.stop.load(std::memory_order_acquire)) {
+            drainRings();
+            break;
+        }
+    }
+}
+
+void Debug::setAsync(bool async) {
+    if (async == asyncState.enabled.load())
+        return;
+
+    if (async) {
+        asyncState.stop   = false;
+        asyncState.writer = std::thread(writerThread);
+        asyncState.enabled.store(true, std::memory_order_release);
+        return;
+    }
+
+    asyncState.enabled.store(false, std::memory_order_release);
+    asyncState.stop.store(true, std::memory_order_release);
+    asyncState.wake.store(true, std::memory_order_release);
+    asyncState.wake.notify_one();
+    asyncState.writer.join();
+
+    // catch whatever raced with the shutdown
+    drainRings();
+}
+
+void Debug::log(eLogLevel level, std::string str) {
+    log(level, std::string_view{str});
+}
+
+void Debug::log(eLogLevel level, const char* str) {
+    log(level, std::string_view{str});
+}
+
+void Debug::log(eLogLevel level, std::string_view str) {
+    if (level == TRACE && !m_trace)
+        return;
+
+    if (m_shuttingDown)
+        return;
+
+    if (asyncState.enabled.load(std::memory_order_acquire)) {
+        pushToRing(level, str);
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(m_logMutex);
+
+    thread_local std::string    plain, colored;
+    plain.clear();
+    colored.clear();
+
+    appendLine(plain, colored, wantsColoredStdout(), level, str);
+    emitLines(plain, colored);
 }
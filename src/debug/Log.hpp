@@ -1,13 +1,19 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <format>
 #include <iostream>
 #include <fstream>
 #include <chrono>
 #include <mutex>
+#include <array>
+#include <atomic>
+#include <iterator>
 
-#define LOGMESSAGESIZE   1024
-#define ROLLING_LOG_SIZE 4096
+#define LOGMESSAGESIZE          1024
+#define ROLLING_LOG_SIZE        4096
+#define ROLLING_LOG_BUFFER_SIZE (64 * 1024)
+#define LOG_RING_SIZE           (64 * 1024)
 
 enum eLogLevel : int8_t {
     NONE = -1,
@@ -21,6 +27,42 @@ enum eLogLevel : int8_t {
 
 // NOLINTNEXTLINE(readability-identifier-naming)
 namespace Debug {
+    // fixed circular byte buffer holding the tail of the log. hyprctl rollinglog shows the last ROLLING_LOG_SIZE
+    // bytes, followers (rollinglog -f) read from their own position in the whole ROLLING_LOG_BUFFER_SIZE.
+    class CRollingLog {
+      public:
+        void append(std::string_view data);
+
+        std::string str();
+
+        // for the crash handler only. The crashing thread may hold the lock forever, so if it's taken this reads
+        // without it, and the result may be torn mid-append. Never use it anywhere that can wait.
+        std::string strForCrashReport();
+
+        // total bytes ever appended, i.e. the position a new follower starts at
+        size_t written();
+
+        // writes everything past cursor to a non-blocking fd with one writev and advances cursor.
+        // A cursor that fell out of the buffer skips ahead to the next complete line. Returns false on write errors.
+        bool writeTo(int fd, size_t& cursor);
+
+        // eventfd signalled once after data was appended while followed, until the next consumeWake()
+        int  wakeFD();
+        void consumeWake();
+        void setFollowed(bool followed);
+
+      private:
+        // the last ROLLING_LOG_SIZE bytes, caller handles locking
+        std::string                               tail();
+
+        std::array<char, ROLLING_LOG_BUFFER_SIZE> m_buffer      = {};
+        size_t                                    m_written     = 0; // total bytes ever appended
+        std::atomic<int>                          m_wakeFD      = -1;
+        std::atomic<bool>                         m_followed    = false;
+        std::atomic<bool>                         m_wakePending = false;
+        std::mutex                                m_mutex;
+    };
+
     inline std::string     m_logFile;
     inline std::ofstream   m_logOfs;
     inline int64_t* const* m_disableLogs   = nullptr;
@@ -30,27 +72,34 @@ namespace Debug {
     inline bool            m_shuttingDown  = false;
     inline int64_t* const* m_coloredLogs   = nullptr;
 
-    inline std::string     m_rollingLog = ""; // rolling log contains the ROLLING_LOG_SIZE tail of the log
+    inline CRollingLog     m_rollingLog;
     inline std::mutex      m_logMutex;
 
     void                   init(const std::string& IS);
     void                   close();
 
+    // in async mode, log() only copies the message into a per-thread ring and a writer thread does the I/O
+    void         setAsync(bool async);
+
+    std::string& threadFormatBuffer();
+
     //
     void log(eLogLevel level, std::string str);
+    void log(eLogLevel level, std::string_view str);
+    void log(eLogLevel level, const char* str);
 
     template <typename... Args>
     //NOLINTNEXTLINE
     void log(eLogLevel level, std::format_string<Args...> fmt, Args&&... args) {
-        std::lock_guard<std::mutex> guard(m_logMutex);
-
         if (level == TRACE && !m_trace)
             return;
 
         if (m_shuttingDown)
             return;
 
-        std::string logMsg = "";
+        // reused per thread, so formatting doesn't allocate once it has grown
+        std::string& logMsg = threadFormatBuffer();
+        logMsg.clear();
 
         // print date and time to the ofs
         if (m_disableTime && !**m_disableTime) {
@@ -62,7 +111,7 @@ namespace Debug {
             // TODO: current clang 17 does not support `zoned_time`, remove this once clang 19 is ready
             const auto hms = std::chrono::hh_mm_ss{std::chrono::system_clock::now() - std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now())};
 #endif
-            logMsg += std::format("[{}] ", hms);
+            std::format_to(std::back_inserter(logMsg), "[{}] ", hms);
         }
 
         // no need for try {} catch {} because std::format_string<Args...> ensures that vformat never throw std::format_error
@@ -70,8 +119,8 @@ namespace Debug {
         // 1. any faulty format specifier that sucks will cause a compilation error.
         // 2. and `std::bad_alloc` is catastrophic, (Almost any operation in stdlib could throw this.)
         // 3. this is actually what std::format in stdlib does
-        logMsg += std::vformat(fmt.get(), std::make_format_args(args...));
+        std::vformat_to(std::back_inserter(logMsg), fmt.get(), std::make_format_args(args...));
 
-        log(level, logMsg);
+        log(level, std::string_view{logMsg});
     }
 };
@@ -0,0 +1,223 @@
+#include "Trace.hpp"
+#include "Log.hpp"
+#include "AllocStats.hpp"
+#include "../helpers/MiscFunctions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+
+struct STraceSlot {
+    std::atomic<uint64_t> seq = 0; // 2 * index + 1 while being written, 2 * index + 2 once done
+    Trace::SEvent         event;
+};
+
+// single producer (the owning thread), read by dump() whenever
+struct STraceRing {
+    std::array<STraceSlot, TRACE_RING_SIZE> slots;
+    std::atomic<uint64_t>                   head     = 0; // total events ever pushed
+    std::atomic<bool>                       orphaned = false;
+    int64_t                                 tid      = 0;
+    std::string                             name;
+
+    void                                    push(const Trace::SEvent& event) {
+        const auto IDX  = head.load(std::memory_order_relaxed);
+        auto&      SLOT = slots[IDX % TRACE_RING_SIZE];
+
+        SLOT.seq.store(IDX * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        SLOT.event = event;
+        SLOT.seq.store(IDX * 2 + 2, std::memory_order_release);
+
+        head.store(IDX + 1, std::memory_order_release);
+    }
+
+    // copies out whatever isn't currently being overwritten
+    void read(std::vector<Trace::SEvent>& out) const {
+        const auto HEAD = head.load(std::memory_order_acquire);
+
+        for (uint64_t i = HEAD - std::min<uint64_t>(HEAD, TRACE_RING_SIZE); i < HEAD; ++i) {
+            const auto& SLOT   = slots[i % TRACE_RING_SIZE];
+            const auto  BEFORE = SLOT.seq.load(std::memory_order_acquire);
+
+            if (BEFORE != i * 2 + 2)
+                continue;
+
+            const auto EVENT = SLOT.event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (SLOT.seq.load(std::memory_order_relaxed) != BEFORE)
+                continue;
+
+            out.emplace_back(EVENT);
+        }
+    }
+};
+
+struct SThreadTraceRing {
+    std::shared_ptr<STraceRing> ring;
+
+    ~SThreadTraceRing() {
+        if (ring)
+            ring->orphaned = true;
+    }
+};
+
+static struct {
+    std::mutex                               ringsMutex;
+    std::vector<std::shared_ptr<STraceRing>> rings;
+    std::shared_ptr<STraceRing>              gpuRing;
+    std::atomic<int64_t>                     nextTid = 1; // trace viewers only need them to be unique
+} traceState;
+
+static std::string currentThreadName() {
+    char name[16] = {0};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) != 0 || name[0] == '\0')
+        return "thread";
+
+    return name;
+}
+
+static std::shared_ptr<STraceRing> makeRing(int64_t tid, std::string name) {
+    auto ring  = std::make_shared<STraceRing>();
+    ring->tid  = tid;
+    ring->name = std::move(name);
+
+    std::lock_guard<std::mutex> guard(traceState.ringsMutex);
+    traceState.rings.emplace_back(ring);
+
+    return ring;
+}
+
+void Trace::start() {
+    {
+        // rings of threads that are gone have been dumped by now or never will be
+        std::lock_guard<std::mutex> guard(traceState.ringsMutex);
+        std::erase_if(traceState.rings, [](const auto& r) { return r->orphaned.load(); });
+    }
+
+    m_enabled = true;
+    Debug::log(LOG, "Trace: recording");
+}
+
+void Trace::stop() {
+    m_enabled = false;
+    Debug::log(LOG, "Trace: stopped, {} events held", eventCount());
+}
+
+uint64_t Trace::threadAllocations() {
+#ifdef HYPRLAND_ALLOC_STATS
+    return AllocStats::threadAllocations();
+#else
+    return 0;
+#endif
+}
+
+int64_t Trace::allocationsSince(uint64_t startAllocs) {
+#ifdef HYPRLAND_ALLOC_STATS
+    return threadAllocations() - startAllocs;
+#else
+    return -1;
+#endif
+}
+
+uint64_t Trace::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::record(const SEvent& event) {
+    thread_local SThreadTraceRing threadRing;
+
+    if (!threadRing.ring)
+        threadRing.ring = makeRing(traceState.nextTid++, currentThreadName());
+
+    threadRing.ring->push(event);
+}
+
+void Trace::recordGPU(const SEvent& event) {
+    if (!traceState.gpuRing)
+        traceState.gpuRing = makeRing(0, "GPU");
+
+    traceState.gpuRing->push(event);
+}
+
+size_t Trace::eventCount() {
+    std::lock_guard<std::mutex> guard(traceState.ringsMutex);
+
+    size_t count = 0;
+    for (const auto& r : traceState.rings) {
+        count += std::min<uint64_t>(r->head.load(std::memory_order_relaxed), TRACE_RING_SIZE);
+    }
+
+    return count;
+}
+
+std::string Trace::dump(const std::string& path) {
+    std::vector<std::shared_ptr<STraceRing>> rings;
+    {
+        std::lock_guard<std::mutex> guard(traceState.ringsMutex);
+        rings = traceState.rings;
+    }
+
+    std::vector<std::vector<SEvent>> events(rings.size());
+    uint64_t                         epoch = UINT64_MAX;
+
+    for (size_t i = 0; i < rings.size(); ++i) {
+        rings[i]->read(events[i]);
+
+        for (const auto& e : events[i]) {
+            epoch = std::min(epoch, e.startNs);
+        }
+    }
+
+    std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+    if (!ofs.good())
+        return std::format("couldn't open {} for writing", path);
+
+    const auto PID     = getpid();
+    const auto toUs    = [epoch](uint64_t ns) { return (ns - epoch) / 1000.0; };
+    size_t     written = 0;
+    bool       first   = true;
+
+    ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (size_t i = 0; i < rings.size(); ++i) {
+        const auto& RING = rings[i];
+
+        ofs << (first ? "" : ",")
+            << std::format(R"#({{"ph":"M","name":"thread_name","pid":{},"tid":{},"args":{{"name":"{}"}}}})#", PID, RING->tid, escapeJSONStrings(RING->name));
+        first = false;
+
+        for (const auto& e : events[i]) {
+            ofs << std::format(R"#(,{{"ph":"X","name":"{}","cat":"{}","pid":{},"tid":{},"ts":{:.3f},"dur":{:.3f})#", e.name, e.category, PID, RING->tid, toUs(e.startNs),
+                               (std::max(e.endNs, e.startNs) - e.startNs) / 1000.0);
+
+            if (e.arg >= 0 && e.allocs >= 0)
+                ofs << std::format(R"#(,"args":{{"arg":{},"allocs":{}}})#", e.arg, e.allocs);
+            else if (e.arg >= 0)
+                ofs << std::format(R"#(,"args":{{"arg":{}}})#", e.arg);
+            else if (e.allocs >= 0)
+                ofs << std::format(R"#(,"args":{{"allocs":{}}})#", e.allocs);
+
+            ofs << "}";
+            written++;
+        }
+    }
+
+    ofs << "]}\n";
+    ofs.close();
+
+    if (!ofs.good())
+        return std::format("failed writing {}", path);
+
+    Debug::log(LOG, "Trace: wrote {} events from {} threads to {}", written, rings.size(), path);
+
+    return "";
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#define TRACE_RING_SIZE 16384 // events kept per thread, older ones get overwritten
+
+/*
+    Flight recorder for frame timing. Always compiled in, but zones only record while
+    tracing is on (hyprctl trace start). Every thread writes to its own ring, so recording
+    never takes a lock, and hyprctl trace dump writes whatever the rings still hold,
+    i.e. the last few seconds before the jank you just saw.
+*/
+// NOLINTNEXTLINE(readability-identifier-naming)
+namespace Trace {
+    struct SEvent {
+        const char* name     = nullptr; // has to be a string literal, only the pointer is stored
+        const char* category = nullptr; // same
+        uint64_t    startNs  = 0;
+        uint64_t    endNs    = 0;
+        int64_t     arg      = -1; // e.g. a monitor id, -1 for none
+        int64_t     allocs   = -1; // operator new calls on this thread during the zone, -1 without HYPRLAND_ALLOC_STATS
+    };
+
+    inline std::atomic<bool> m_enabled = false;
+
+    void                     start();
+    void                     stop();
+
+    inline bool              enabled() {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    uint64_t    nowNs();
+
+    // operator new calls made by this thread so far. Only counted in builds with HYPRLAND_ALLOC_STATS, 0 otherwise.
+    uint64_t    threadAllocations();
+    // what goes into SEvent::allocs for a zone that started at startAllocs, -1 without HYPRLAND_ALLOC_STATS
+    int64_t     allocationsSince(uint64_t startAllocs);
+
+    // appends to the calling thread's ring
+    void        record(const SEvent& event);
+    // appends to the GPU track. Render thread only.
+    void        recordGPU(const SEvent& event);
+
+    // number of events currently held across all rings
+    size_t      eventCount();
+
+    // writes the rings as Chrome trace JSON, which chrome://tracing and ui.perfetto.dev both load.
+    // Returns an error, empty on success.
+    std::string dump(const std::string& path);
+
+    class CZone {
+      public:
+        CZone(const char* name, const char* category, int64_t arg = -1) : m_name(name), m_category(category), m_arg(arg) {
+            if (!enabled())
+                return;
+
+            m_startNs     = nowNs();
+            m_startAllocs = threadAllocations();
+        }
+
+        ~CZone() {
+            if (m_startNs == 0)
+                return;
+
+            record({.name = m_name, .category = m_category, .startNs = m_startNs, .endNs = nowNs(), .arg = m_arg, .allocs = allocationsSince(m_startAllocs)});
+        }
+
+        CZone(const CZone&)            = delete;
+        CZone& operator=(const CZone&) = delete;
+
+      private:
+        const char* m_name        = nullptr;
+        const char* m_category    = nullptr;
+        int64_t     m_arg         = -1;
+        uint64_t    m_startNs     = 0;
+        uint64_t    m_startAllocs = 0;
+    };
+};
+
+#define TRACE_ZONE_CONCAT_IMPL(a, b)         a##b
+#define TRACE_ZONE_CONCAT(a, b)              TRACE_ZONE_CONCAT_IMPL(a, b)
+#define TRACE_ZONE(name, category)           Trace::CZone TRACE_ZONE_CONCAT(traceZone, __LINE__)(name, category)
+#define TRACE_ZONE_ARG(name, category, arg)  Trace::CZone TRACE_ZONE_CONCAT(traceZone, __LINE__)(name, category, arg)
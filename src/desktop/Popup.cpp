@@ -342,6 +342,10 @@ void CPopup::breadthfirst(std::function<void(WP<CPopup>, void*)> fn, void* data)
 }
 
 WP<CPopup> CPopup::at(const Vector2D& globalCoords, bool allowsInput) {
+    // a bare head, which is what most windows have. Hit on every pointer motion, so skip the walk.
+    if (m_vChildren.empty() && !m_pResource)
+        return {};
+
     std::vector<WP<CPopup>> popups;
     breadthfirst([&popups](WP<CPopup> popup, void* data) { popups.push_back(popup); }, &popups);
 
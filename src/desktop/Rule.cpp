@@ -1,4 +1,5 @@
 #include <re2/re2.h>
+#include <re2/set.h>
 #include "../helpers/memory/Memory.hpp"
 #include "Rule.hpp"
 #include "../debug/Log.hpp"
@@ -19,4 +20,95 @@ bool CRuleRegexContainer::passes(const std::string& str) const {
         return false;
 
     return RE2::FullMatch(str, *regex) != negative;
-}
\ No newline at end of file
+}
+
+constexpr static size_t MAX_REGEX_SET_CACHE = 64;
+
+struct CRuleRegexSet::SImpl {
+    RE2::Set                 set{RE2::Options{}, RE2::ANCHOR_BOTH};
+    std::vector<std::string> patterns;
+
+    // used if the set fails to compile, e.g. when it gets too big
+    std::vector<Hyprutils::Memory::CUniquePointer<RE2>> fallback;
+    bool                                                compiled = false;
+};
+
+CRuleRegexSet::CRuleRegexSet() {
+    clear();
+}
+
+CRuleRegexSet::~CRuleRegexSet() = default;
+
+int CRuleRegexSet::add(const std::string& regex_) {
+    const bool NEGATIVE = regex_.starts_with("negative:");
+    const auto PATTERN  = NEGATIVE ? regex_.substr(9) : regex_;
+
+    std::string err;
+    const int   SETIDX = m_impl->set.Add(PATTERN, &err);
+
+    if (SETIDX < 0)
+        Debug::log(ERR, "RuleRegexSet: regex {} failed to parse: {}", regex_, err);
+    else
+        m_impl->patterns.emplace_back(PATTERN);
+
+    m_vNegative.push_back(NEGATIVE);
+    m_vSetIndex.push_back(SETIDX);
+
+    return m_vSetIndex.size() - 1;
+}
+
+void CRuleRegexSet::compile() {
+    m_mCache.clear();
+
+    if (m_impl->patterns.empty())
+        return;
+
+    m_impl->compiled = m_impl->set.Compile();
+
+    if (!m_impl->compiled) {
+        Debug::log(WARN, "RuleRegexSet: couldn't compile a set of {} regexes, matching them one by one", m_impl->patterns.size());
+        for (auto const& p : m_impl->patterns) {
+            m_impl->fallback.emplace_back(makeUnique<RE2>(p));
+        }
+    }
+}
+
+void CRuleRegexSet::clear() {
+    m_impl = makeUnique<SImpl>();
+    m_vNegative.clear();
+    m_vSetIndex.clear();
+    m_mCache.clear();
+}
+
+bool CRuleRegexSet::empty() const {
+    return m_vSetIndex.empty();
+}
+
+const std::vector<bool>& CRuleRegexSet::match(const std::string& str) {
+    if (const auto IT = m_mCache.find(str); IT != m_mCache.end())
+        return IT->second;
+
+    std::vector<bool> inSet(m_impl->patterns.size(), false);
+
+    if (m_impl->compiled) {
+        std::vector<int> hits;
+        m_impl->set.Match(str, &hits);
+        for (const auto& h : hits) {
+            inSet[h] = true;
+        }
+    } else {
+        for (size_t i = 0; i < m_impl->fallback.size(); ++i) {
+            inSet[i] = RE2::FullMatch(str, *m_impl->fallback[i]);
+        }
+    }
+
+    std::vector<bool> result(m_vSetIndex.size(), false);
+    for (size_t i = 0; i < m_vSetIndex.size(); ++i) {
+        result[i] = (m_vSetIndex[i] >= 0 && inSet[m_vSetIndex[i]]) != m_vNegative[i];
+    }
+
+    if (m_mCache.size() >= MAX_REGEX_SET_CACHE)
+        m_mCache.clear();
+
+    return m_mCache.emplace(str, std::move(result)).first->second;
+}
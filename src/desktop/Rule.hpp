@@ -1,6 +1,9 @@
 #pragma once
 
 #include <hyprutils/memory/UniquePtr.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 //NOLINTNEXTLINE
 namespace re2 {
@@ -18,4 +21,27 @@ class CRuleRegexContainer {
   private:
     Hyprutils::Memory::CUniquePointer<re2::RE2> regex;
     bool                                        negative = false;
-};
\ No newline at end of file
+};
+
+// All regexes of one rule field, matched in a single pass.
+// Indices are handed out by add(), results from match() have negative: applied.
+class CRuleRegexSet {
+  public:
+    CRuleRegexSet();
+    ~CRuleRegexSet();
+
+    int                      add(const std::string& regex);
+    void                     compile();
+    void                     clear();
+    bool                     empty() const;
+
+    const std::vector<bool>& match(const std::string& str);
+
+  private:
+    struct SImpl;
+
+    Hyprutils::Memory::CUniquePointer<SImpl>           m_impl;
+    std::vector<bool>                                  m_vNegative;
+    std::vector<int>                                   m_vSetIndex; // -1 if the regex didn't parse, it then never matches
+    std::unordered_map<std::string, std::vector<bool>> m_mCache;
+};
@@ -4,7 +4,6 @@
 #include "../managers/input/InputManager.hpp"
 #include "../managers/SeatManager.hpp"
 #include "../config/ConfigManager.hpp"
-#include <sys/mman.h>
 #include <aquamarine/input/Input.hpp>
 #include <cstring>
 
@@ -50,7 +49,7 @@ void IKeyboard::clearManuallyAllocd() {
     xkbKeymap      = nullptr;
     xkbState       = nullptr;
     xkbStaticState = nullptr;
-    xkbKeymapFD.reset();
+    compiledKeymap.reset();
 }
 
 void IKeyboard::setKeymap(const SStringRuleNames& rules) {
@@ -59,48 +58,28 @@ void IKeyboard::setKeymap(const SStringRuleNames& rules) {
         return;
     }
 
-    currentRules            = rules;
-    xkb_rule_names XKBRULES = {
-        .rules   = rules.rules.c_str(),
-        .model   = rules.model.c_str(),
-        .layout  = rules.layout.c_str(),
-        .variant = rules.variant.c_str(),
-        .options = rules.options.c_str(),
-    };
-
-    const auto CONTEXT = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-
-    if (!CONTEXT) {
-        Debug::log(ERR, "setKeymap: CONTEXT null??");
-        return;
-    }
+    currentRules = rules;
 
     clearManuallyAllocd();
 
     Debug::log(LOG, "Attempting to create a keymap for layout {} with variant {} (rules: {}, model: {}, options: {})", rules.layout, rules.variant, rules.rules, rules.model,
                rules.options);
 
-    if (!xkbFilePath.empty()) {
-        auto path = absolutePath(xkbFilePath, g_pConfigManager->m_configCurrentPath);
-
-        if (FILE* const KEYMAPFILE = fopen(path.c_str(), "r"); !KEYMAPFILE)
-            Debug::log(ERR, "Cannot open input:kb_file= file for reading");
-        else {
-            xkbKeymap = xkb_keymap_new_from_file(CONTEXT, KEYMAPFILE, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
-            fclose(KEYMAPFILE);
-        }
-    }
-
-    if (!xkbKeymap)
-        xkbKeymap = xkb_keymap_new_from_names(CONTEXT, &XKBRULES, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    compiledKeymap = g_pKeymapCache->get(SKeymapCacheKey{
+        .rules   = rules.rules,
+        .model   = rules.model,
+        .layout  = rules.layout,
+        .variant = rules.variant,
+        .options = rules.options,
+        .file    = xkbFilePath.empty() ? "" : absolutePath(xkbFilePath, g_pConfigManager->m_configCurrentPath),
+    });
 
-    if (!xkbKeymap) {
+    if (!compiledKeymap) {
         g_pConfigManager->addParseError("Invalid keyboard layout passed. ( rules: " + rules.rules + ", model: " + rules.model + ", variant: " + rules.variant +
                                         ", options: " + rules.options + ", layout: " + rules.layout + " )");
 
         Debug::log(ERR, "Keyboard layout {} with variant {} (rules: {}, model: {}, options: {}) couldn't have been loaded.", rules.layout, rules.variant, rules.rules, rules.model,
                    rules.options);
-        memset(&XKBRULES, 0, sizeof(XKBRULES));
 
         currentRules.rules   = "";
         currentRules.model   = "";
@@ -108,9 +87,17 @@ void IKeyboard::setKeymap(const SStringRuleNames& rules) {
         currentRules.options = "";
         currentRules.layout  = "us";
 
-        xkbKeymap = xkb_keymap_new_from_names(CONTEXT, &XKBRULES, XKB_KEYMAP_COMPILE_NO_FLAGS);
+        // empty names are xkb's defaults
+        compiledKeymap = g_pKeymapCache->get(SKeymapCacheKey{});
+    }
+
+    if (!compiledKeymap) {
+        Debug::log(ERR, "setKeymap: couldn't compile even the default keymap");
+        return;
     }
 
+    xkbKeymap = xkb_keymap_ref(compiledKeymap->keymap);
+
     updateXKBTranslationState(xkbKeymap);
 
     const auto NUMLOCKON = g_pConfigManager->getDeviceInt(hlName, "numlock_by_default", "input:numlock_by_default");
@@ -136,9 +123,7 @@ void IKeyboard::setKeymap(const SStringRuleNames& rules) {
         Debug::log(LOG, "xkb: Mod index {} (name {}) got index {}", i, MODNAMES[i], modIndexes[i]);
     }
 
-    updateKeymapFD();
-
-    xkb_context_unref(CONTEXT);
+    Debug::log(LOG, "Keyboard {} uses keymap fd {}", deviceName, compiledKeymap->fd.get());
 
     g_pSeatManager->updateActiveKeyboardData();
 }
@@ -146,30 +131,10 @@ void IKeyboard::setKeymap(const SStringRuleNames& rules) {
 void IKeyboard::updateKeymapFD() {
     Debug::log(LOG, "Updating keymap fd for keyboard {}", deviceName);
 
-    if (xkbKeymapFD.isValid())
-        xkbKeymapFD.reset();
-
-    auto cKeymapStr = xkb_keymap_get_as_string(xkbKeymap, XKB_KEYMAP_FORMAT_TEXT_V1);
-    xkbKeymapString = cKeymapStr;
-    free(cKeymapStr);
-
-    CFileDescriptor rw, ro;
-    if (!allocateSHMFilePair(xkbKeymapString.length() + 1, rw, ro))
-        Debug::log(ERR, "IKeyboard: failed to allocate shm pair for the keymap");
-    else {
-        auto keymapFDDest = mmap(nullptr, xkbKeymapString.length() + 1, PROT_READ | PROT_WRITE, MAP_SHARED, rw.get(), 0);
-        rw.reset();
-        if (keymapFDDest == MAP_FAILED) {
-            Debug::log(ERR, "IKeyboard: failed to mmap a shm pair for the keymap");
-            ro.reset();
-        } else {
-            memcpy(keymapFDDest, xkbKeymapString.c_str(), xkbKeymapString.length());
-            munmap(keymapFDDest, xkbKeymapString.length() + 1);
-            xkbKeymapFD = std::move(ro);
-        }
-    }
+    // only for keymaps that didn't come from the cache, e.g. a virtual keyboard's own
+    compiledKeymap = CKeymapCache::fromKeymap(xkbKeymap);
 
-    Debug::log(LOG, "Updated keymap fd to {}", xkbKeymapFD.get());
+    Debug::log(LOG, "Updated keymap fd to {}", compiledKeymap->fd.get());
 }
 
 void IKeyboard::updateXKBTranslationState(xkb_keymap* const keymap) {
@@ -199,48 +164,41 @@ void IKeyboard::updateXKBTranslationState(xkb_keymap* const keymap) {
     const auto STATE      = xkbState;
     const auto LAYOUTSNUM = xkb_keymap_num_layouts(KEYMAP);
 
-    const auto PCONTEXT = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-
     for (uint32_t i = 0; i < LAYOUTSNUM; ++i) {
         if (xkb_state_layout_index_is_active(STATE, i, XKB_STATE_LAYOUT_EFFECTIVE) == 1) {
             Debug::log(LOG, "Updating keyboard {:x}'s translation state from an active index {}", (uintptr_t)this, i);
 
-            CVarList       keyboardLayouts(currentRules.layout, 0, ',');
-            CVarList       keyboardModels(currentRules.model, 0, ',');
-            CVarList       keyboardVariants(currentRules.variant, 0, ',');
+            CVarList        keyboardLayouts(currentRules.layout, 0, ',');
+            CVarList        keyboardModels(currentRules.model, 0, ',');
+            CVarList        keyboardVariants(currentRules.variant, 0, ',');
 
-            xkb_rule_names rules = {.rules = "", .model = "", .layout = "", .variant = "", .options = ""};
+            SKeymapCacheKey key = {
+                .model   = keyboardModels[i % keyboardModels.size()],
+                .layout  = keyboardLayouts[i % keyboardLayouts.size()],
+                .variant = keyboardVariants[i % keyboardVariants.size()],
+            };
 
-            std::string    layout, model, variant;
-            layout  = keyboardLayouts[i % keyboardLayouts.size()];
-            model   = keyboardModels[i % keyboardModels.size()];
-            variant = keyboardVariants[i % keyboardVariants.size()];
-
-            rules.layout  = layout.c_str();
-            rules.model   = model.c_str();
-            rules.variant = variant.c_str();
-
-            auto KEYMAP = xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+            auto KEYMAP = g_pKeymapCache->get(key);
 
             if (!KEYMAP) {
                 Debug::log(ERR, "updateXKBTranslationState: keymap failed 1, fallback without model/variant");
-                rules.model   = "";
-                rules.variant = "";
-                KEYMAP        = xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+                key.model   = "";
+                key.variant = "";
+                KEYMAP      = g_pKeymapCache->get(key);
             }
 
             if (!KEYMAP) {
                 Debug::log(ERR, "updateXKBTranslationState: keymap failed 2, fallback to us");
-                rules.layout = "us";
-                KEYMAP       = xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+                key.layout = "us";
+                KEYMAP     = g_pKeymapCache->get(key);
             }
 
-            xkbState       = xkb_state_new(KEYMAP);
-            xkbStaticState = xkb_state_new(KEYMAP);
-            xkbSymState    = xkb_state_new(KEYMAP);
+            if (!KEYMAP)
+                return;
 
-            xkb_keymap_unref(KEYMAP);
-            xkb_context_unref(PCONTEXT);
+            xkbState       = xkb_state_new(KEYMAP->keymap);
+            xkbStaticState = xkb_state_new(KEYMAP->keymap);
+            xkbSymState    = xkb_state_new(KEYMAP->keymap);
 
             return;
         }
@@ -248,22 +206,20 @@ void IKeyboard::updateXKBTranslationState(xkb_keymap* const keymap) {
 
     Debug::log(LOG, "Updating keyboard {:x}'s translation state from an unknown index", (uintptr_t)this);
 
-    xkb_rule_names rules = {
-        .rules   = currentRules.rules.c_str(),
-        .model   = currentRules.model.c_str(),
-        .layout  = currentRules.layout.c_str(),
-        .variant = currentRules.variant.c_str(),
-        .options = currentRules.options.c_str(),
-    };
-
-    const auto NEWKEYMAP = xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    const auto NEWKEYMAP = g_pKeymapCache->get(SKeymapCacheKey{
+        .rules   = currentRules.rules,
+        .model   = currentRules.model,
+        .layout  = currentRules.layout,
+        .variant = currentRules.variant,
+        .options = currentRules.options,
+    });
 
-    xkbState       = xkb_state_new(NEWKEYMAP);
-    xkbStaticState = xkb_state_new(NEWKEYMAP);
-    xkbSymState    = xkb_state_new(NEWKEYMAP);
+    if (!NEWKEYMAP)
+        return;
 
-    xkb_keymap_unref(NEWKEYMAP);
-    xkb_context_unref(PCONTEXT);
+    xkbState       = xkb_state_new(NEWKEYMAP->keymap);
+    xkbStaticState = xkb_state_new(NEWKEYMAP->keymap);
+    xkbSymState    = xkb_state_new(NEWKEYMAP->keymap);
 }
 
 std::string IKeyboard::getActiveLayout() {
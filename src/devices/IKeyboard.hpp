@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IHID.hpp"
+#include "KeymapCache.hpp"
 #include "../macros.hpp"
 #include "../helpers/math/Math.hpp"
 
@@ -96,9 +97,8 @@ class IKeyboard : public IHID {
     std::array<xkb_mod_index_t, 8> modIndexes = {XKB_MOD_INVALID};
     uint32_t                       leds       = 0;
 
-    std::string                    xkbFilePath     = "";
-    std::string                    xkbKeymapString = "";
-    Hyprutils::OS::CFileDescriptor xkbKeymapFD;
+    std::string                    xkbFilePath = "";
+    SP<SCompiledKeymap>            compiledKeymap; // xkbKeymap serialized, possibly shared with other keyboards
 
     SStringRuleNames               currentRules;
     int                            repeatRate        = 0;
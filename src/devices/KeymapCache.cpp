@@ -0,0 +1,141 @@
+#include "KeymapCache.hpp"
+#include "../debug/Log.hpp"
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <cerrno>
+#include <format>
+
+using namespace Hyprutils::OS;
+
+size_t SKeymapCacheKeyHash::operator()(const SKeymapCacheKey& key) const {
+    size_t     hash    = std::hash<std::string>{}(key.layout);
+    const auto combine = [&hash](size_t v) { hash ^= v + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+
+    combine(std::hash<std::string>{}(key.rules));
+    combine(std::hash<std::string>{}(key.model));
+    combine(std::hash<std::string>{}(key.variant));
+    combine(std::hash<std::string>{}(key.options));
+    combine(std::hash<std::string>{}(key.file));
+
+    return hash;
+}
+
+SCompiledKeymap::~SCompiledKeymap() {
+    if (keymap)
+        xkb_keymap_unref(keymap);
+}
+
+CKeymapCache::CKeymapCache() {
+    m_pContext = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+
+    if (!m_pContext)
+        Debug::log(ERR, "CKeymapCache: couldn't create an xkb context");
+}
+
+CKeymapCache::~CKeymapCache() {
+    m_mKeymaps.clear();
+
+    if (m_pContext)
+        xkb_context_unref(m_pContext);
+}
+
+SP<SCompiledKeymap> CKeymapCache::get(const SKeymapCacheKey& key) {
+    if (auto it = m_mKeymaps.find(key); it != m_mKeymaps.end())
+        return it->second;
+
+    if (!m_pContext)
+        return nullptr;
+
+    xkb_keymap* keymap = nullptr;
+
+    if (!key.file.empty()) {
+        if (FILE* const KEYMAPFILE = fopen(key.file.c_str(), "r"); !KEYMAPFILE)
+            Debug::log(ERR, "Cannot open input:kb_file= file for reading");
+        else {
+            keymap = xkb_keymap_new_from_file(m_pContext, KEYMAPFILE, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+            fclose(KEYMAPFILE);
+        }
+    }
+
+    if (!keymap) {
+        xkb_rule_names XKBRULES = {
+            .rules   = key.rules.c_str(),
+            .model   = key.model.c_str(),
+            .layout  = key.layout.c_str(),
+            .variant = key.variant.c_str(),
+            .options = key.options.c_str(),
+        };
+
+        keymap = xkb_keymap_new_from_names(m_pContext, &XKBRULES, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    }
+
+    if (!keymap)
+        return nullptr;
+
+    auto compiled = fromKeymap(keymap);
+    xkb_keymap_unref(keymap);
+
+    m_mKeymaps[key] = compiled;
+
+    Debug::log(LOG, "CKeymapCache: compiled a keymap for layout {} with variant {} (rules: {}, model: {}, options: {}, file: {}), {} cached", key.layout, key.variant, key.rules,
+               key.model, key.options, key.file, m_mKeymaps.size());
+
+    return compiled;
+}
+
+void CKeymapCache::invalidate() {
+    // keyboards keep theirs until they get a new one
+    m_mKeymaps.clear();
+}
+
+SP<SCompiledKeymap> CKeymapCache::fromKeymap(xkb_keymap* keymap) {
+    auto compiled    = makeShared<SCompiledKeymap>();
+    compiled->keymap = xkb_keymap_ref(keymap);
+
+    auto cKeymapStr  = xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1);
+    compiled->string = cKeymapStr;
+    free(cKeymapStr);
+
+    // one memfd for everyone. Sealed, so a client can't change it under the others.
+    const size_t    SIZE = compiled->string.length() + 1;
+    CFileDescriptor fd{memfd_create("hyprland-keymap", MFD_CLOEXEC | MFD_ALLOW_SEALING)};
+
+    if (!fd.isValid()) {
+        Debug::log(ERR, "CKeymapCache: memfd_create failed");
+        return compiled;
+    }
+
+    // pwrite, the offset is shared with every client the fd is sent to
+    size_t written = 0;
+    while (written < SIZE) {
+        const auto RET = pwrite(fd.get(), compiled->string.c_str() + written, SIZE - written, written);
+        if (RET < 0 && errno == EINTR)
+            continue;
+
+        if (RET <= 0) {
+            Debug::log(ERR, "CKeymapCache: failed writing the keymap to a memfd");
+            return compiled;
+        }
+
+        written += RET;
+    }
+
+    if (fcntl(fd.get(), F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0) {
+        Debug::log(ERR, "CKeymapCache: failed to seal the keymap memfd");
+        return compiled;
+    }
+
+    // clients get a read-only reopen, with its own offset, not the fd we wrote through
+    CFileDescriptor roFd{open(std::format("/proc/self/fd/{}", fd.get()).c_str(), O_RDONLY | O_CLOEXEC)};
+
+    if (!roFd.isValid()) {
+        Debug::log(ERR, "CKeymapCache: failed to reopen the keymap memfd read-only");
+        return compiled;
+    }
+
+    compiled->fd = std::move(roFd);
+
+    return compiled;
+}
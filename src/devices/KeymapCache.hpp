@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <string>
+#include <unordered_map>
+#include <xkbcommon/xkbcommon.h>
+#include <hyprutils/os/FileDescriptor.hpp>
+
+struct SKeymapCacheKey {
+    std::string rules;
+    std::string model;
+    std::string layout;
+    std::string variant;
+    std::string options;
+    std::string file; // absolute path of input:kb_file, if any
+
+    bool        operator==(const SKeymapCacheKey& other) const = default;
+};
+
+struct SKeymapCacheKeyHash {
+    size_t operator()(const SKeymapCacheKey& key) const;
+};
+
+// a compiled keymap with its serialized form. Shared, nobody may modify it.
+struct SCompiledKeymap {
+    ~SCompiledKeymap();
+
+    xkb_keymap*                    keymap = nullptr;
+    std::string                    string;
+    Hyprutils::OS::CFileDescriptor fd; // sealed, read-only memfd holding string, can be sent to any number of clients
+};
+
+/*
+    Compiling a keymap takes 10s of ms, and docks, KVMs and IMEs create a lot of keyboards
+    with the exact same config. Keymaps are compiled once per config and shared.
+    Dropped on config reload, as kb_file contents or the system xkb data might have changed.
+*/
+class CKeymapCache {
+  public:
+    CKeymapCache();
+    ~CKeymapCache();
+
+    // compiles on a miss. nullptr if it doesn't compile.
+    SP<SCompiledKeymap>        get(const SKeymapCacheKey& key);
+    void                       invalidate();
+
+    // for keymaps we didn't compile (e.g. sent by a virtual keyboard). Not cached.
+    static SP<SCompiledKeymap> fromKeymap(xkb_keymap* keymap);
+
+  private:
+    xkb_context*                                                              m_pContext = nullptr;
+    std::unordered_map<SKeymapCacheKey, SP<SCompiledKeymap>, SKeymapCacheKeyHash> m_mKeymaps;
+};
+
+inline UP<CKeymapCache> g_pKeymapCache;
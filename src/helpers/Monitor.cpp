@@ -875,10 +875,20 @@ void CMonitor::addDamage(const pixman_region32_t* rg) {
 }
 
 void CMonitor::addDamage(const CRegion& rg) {
+    addDamage(rg, nullptr);
+}
+
+void CMonitor::addDamage(const CRegion& rg, SP<CWLSurfaceResource> source) {
+    if (g_pHyprOpenGL && g_pHyprOpenGL->m_pBlurCache)
+        g_pHyprOpenGL->m_pBlurCache->onDamage(self.lock(), rg, source);
+
     addDamage(const_cast<CRegion*>(&rg)->pixman());
 }
 
 void CMonitor::addDamage(const CBox& box) {
+    if (g_pHyprOpenGL && g_pHyprOpenGL->m_pBlurCache)
+        g_pHyprOpenGL->m_pBlurCache->onDamage(self.lock(), CRegion{box});
+
     static auto PZOOMFACTOR = CConfigValue<Hyprlang::FLOAT>("cursor:zoom_factor");
     if (*PZOOMFACTOR != 1.f && g_pCompositor->getMonitorFromCursor() == self) {
         damage.damageEntire();
@@ -1575,7 +1585,7 @@ bool CMonitorState::commit() {
     if (!updateSwapchain())
         return false;
 
-    EMIT_HOOK_EVENT("preMonitorCommit", m_pOwner->self.lock());
+    EMIT_TYPED_HOOK_EVENT(HOOK_PRE_MONITOR_COMMIT, m_pOwner->self.lock());
 
     ensureBufferPresent();
 
@@ -186,6 +186,7 @@ class CMonitor {
     bool                                applyMonitorRule(SMonitorRule* pMonitorRule, bool force = false);
     void                                addDamage(const pixman_region32_t* rg);
     void                                addDamage(const CRegion& rg);
+    void                                addDamage(const CRegion& rg, SP<CWLSurfaceResource> source); // source: the surface whose commit caused it, if any
     void                                addDamage(const CBox& box);
     bool                                shouldSkipScheduleFrameOnMouseEvent();
     void                                setMirror(const std::string&);
@@ -22,7 +22,7 @@ CHyprError::CHyprError() {
         m_bMonitorChanged = true;
     });
 
-    static auto P2 = g_pHookSystem->hookDynamic("preRender", [&](void* self, SCallbackInfo& info, std::any param) {
+    static auto P2 = g_pHookSystem->registerTyped<HOOK_PRE_RENDER>([&](SCallbackInfo& info, const PHLMONITOR& pMonitor) {
         if (!m_bIsCreated)
             return;
 
@@ -1,5 +1,7 @@
 #include "EventManager.hpp"
 #include "../Compositor.hpp"
+#include "../config/ConfigValue.hpp"
+#include "../debug/Trace.hpp"
 
 #include <algorithm>
 #include <netinet/in.h>
@@ -7,11 +9,15 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/un.h>
+#include <sys/uio.h>
+#include <climits>
 #include <unistd.h>
 #include <cstring>
 using namespace Hyprutils::OS;
 
 CEventManager::CEventManager() : m_iSocketFD(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)) {
+    m_vEventRing.resize(EVENT_RING_SIZE);
+
     if (!m_iSocketFD.isValid()) {
         Debug::log(ERR, "Couldn't start the Hyprland Socket 2. (1) IPC will not work.");
         return;
@@ -47,6 +53,9 @@ CEventManager::~CEventManager() {
 
     if (m_pEventSource != nullptr)
         wl_event_source_remove(m_pEventSource);
+
+    if (m_pFlushSource != nullptr)
+        wl_event_source_remove(m_pFlushSource);
 }
 
 int CEventManager::onServerEvent(int fd, uint32_t mask, void* data) {
@@ -57,6 +66,20 @@ int CEventManager::onClientEvent(int fd, uint32_t mask, void* data) {
     return g_pEventManager->onServerEvent(fd, mask);
 }
 
+void CEventManager::onFlush(void* data) {
+    g_pEventManager->m_pFlushSource = nullptr;
+
+    for (auto it = g_pEventManager->m_vClients.begin(); it != g_pEventManager->m_vClients.end();) {
+        if (!g_pEventManager->flushClient(*it)) {
+            Debug::log(ERR, "Socket2 fd {} failed writing, removing", it->fd.get());
+            it = g_pEventManager->removeClientByFD(it->fd.get());
+            continue;
+        }
+
+        ++it;
+    }
+}
+
 int CEventManager::onServerEvent(int fd, uint32_t mask) {
     if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP) {
         Debug::log(ERR, "Socket2 hangup?? IPC broke");
@@ -87,9 +110,9 @@ int CEventManager::onServerEvent(int fd, uint32_t mask) {
     // add to event loop so we can close it when we need to
     auto* eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, ACCEPTEDCONNECTION.get(), 0, onServerEvent, nullptr);
     m_vClients.emplace_back(SClient{
-        std::move(ACCEPTEDCONNECTION),
-        {},
-        eventSource,
+        .fd          = std::move(ACCEPTEDCONNECTION),
+        .eventSource = eventSource,
+        .cursor      = m_iNextSeq,
     });
 
     return 0;
@@ -105,18 +128,10 @@ int CEventManager::onClientEvent(int fd, uint32_t mask) {
     if (mask & WL_EVENT_WRITABLE) {
         const auto CLIENTIT = findClientByFD(fd);
 
-        // send all queued events
-        while (!CLIENTIT->events.empty()) {
-            const auto& event = CLIENTIT->events.front();
-            if (write(CLIENTIT->fd.get(), event->c_str(), event->length()) < 0)
-                break;
-
-            CLIENTIT->events.erase(CLIENTIT->events.begin());
+        if (CLIENTIT != m_vClients.end() && !flushClient(*CLIENTIT)) {
+            Debug::log(ERR, "Socket2 fd {} failed writing, removing", fd);
+            removeClientByFD(fd);
         }
-
-        // stop polling when we sent all events
-        if (CLIENTIT->events.empty())
-            wl_event_source_fd_update(CLIENTIT->eventSource, 0);
     }
 
     return 0;
@@ -140,33 +155,135 @@ std::string CEventManager::formatEvent(const SHyprIPCEvent& event) const {
     return eventString;
 }
 
+const SP<std::string>& CEventManager::eventAt(uint64_t seq) const {
+    return m_vEventRing[seq % EVENT_RING_SIZE];
+}
+
+void CEventManager::dropBehind(SClient& client, uint64_t maxQueued) {
+    if (m_iNextSeq - client.cursor <= maxQueued)
+        return;
+
+    // keep the stream line-aligned: finish an event that already went out halfway
+    if (client.offset > 0) {
+        const auto& EVENT = eventAt(client.cursor);
+        client.pending.append(*EVENT, client.offset);
+        client.offset = 0;
+        client.cursor++;
+    }
+
+    const auto NEWCURSOR = m_iNextSeq - maxQueued;
+    if (NEWCURSOR <= client.cursor)
+        return;
+
+    client.droppedEvents += NEWCURSOR - client.cursor;
+    client.cursor = NEWCURSOR;
+}
+
+void CEventManager::consume(SClient& client, size_t len) {
+    const auto PENDING = std::min(len, client.pending.size() - client.pendingOffset);
+    client.pendingOffset += PENDING;
+    len -= PENDING;
+
+    if (client.pendingOffset >= client.pending.size()) {
+        client.pending.clear();
+        client.pendingOffset = 0;
+    }
+
+    while (len > 0 && client.cursor < m_iNextSeq) {
+        const auto LEFT = eventAt(client.cursor)->length() - client.offset;
+
+        if (len < LEFT) {
+            client.offset += len;
+            return;
+        }
+
+        len -= LEFT;
+        client.offset = 0;
+        client.cursor++;
+    }
+}
+
+bool CEventManager::flushClient(SClient& client) {
+    if (client.droppedEvents > 0) {
+        Debug::log(WARN, "Socket2 fd {} is too slow, dropped {} events", client.fd.get(), client.droppedEvents);
+        client.pending += std::format("eventsdropped>>{}\n", client.droppedEvents);
+        client.droppedEvents = 0;
+    }
+
+    while (true) {
+        std::array<iovec, IOV_MAX> iovecs;
+        size_t                     count = 0;
+        size_t                     total = 0;
+
+        if (client.pendingOffset < client.pending.size())
+            iovecs[count++] = {.iov_base = client.pending.data() + client.pendingOffset, .iov_len = client.pending.size() - client.pendingOffset};
+
+        for (uint64_t seq = client.cursor; seq < m_iNextSeq && count < iovecs.size(); ++seq) {
+            const auto& EVENT  = eventAt(seq);
+            const auto  OFFSET = seq == client.cursor ? client.offset : 0;
+            iovecs[count++]    = {.iov_base = EVENT->data() + OFFSET, .iov_len = EVENT->length() - OFFSET};
+        }
+
+        if (count == 0)
+            break;
+
+        for (size_t i = 0; i < count; ++i) {
+            total += iovecs[i].iov_len;
+        }
+
+        const auto LEN = writev(client.fd.get(), iovecs.data(), count);
+
+        if (LEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+
+            return false;
+        }
+
+        consume(client, LEN);
+
+        if ((size_t)LEN < total)
+            break;
+    }
+
+    // poll for write only while something is left over
+    const bool POLLWRITE = client.cursor < m_iNextSeq || !client.pending.empty();
+    if (POLLWRITE != client.pollingWrite) {
+        wl_event_source_fd_update(client.eventSource, POLLWRITE ? WL_EVENT_WRITABLE : 0);
+        client.pollingWrite = POLLWRITE;
+    }
+
+    return true;
+}
+
 void CEventManager::postEvent(const SHyprIPCEvent& event) {
+    TRACE_ZONE("socket2", "ipc");
+
     if (g_pCompositor->m_isShuttingDown) {
         Debug::log(WARN, "Suppressed (shutting down) event of type {}, content: {}", event.event, event.data);
         return;
     }
 
-    const size_t MAX_QUEUED_EVENTS = 64;
-    auto         sharedEvent       = makeShared<std::string>(formatEvent(event));
-    for (auto it = m_vClients.begin(); it != m_vClients.end();) {
-        // try to send the event immediately if the queue is empty
-        const auto QUEUESIZE = it->events.size();
-        if (QUEUESIZE > 0 || write(it->fd.get(), sharedEvent->c_str(), sharedEvent->length()) < 0) {
-            if (QUEUESIZE >= MAX_QUEUED_EVENTS) {
-                // too many events queued, remove the client
-                Debug::log(ERR, "Socket2 fd {} overflowed event queue, removing", it->fd.get());
-                it = removeClientByFD(it->fd.get());
-                continue;
-            }
+    if (m_vClients.empty())
+        return;
 
-            // queue it to send later if failed
-            it->events.push_back(sharedEvent);
+    static auto PMAXQUEUED = CConfigValue<Hyprlang::INT>("misc:socket2_max_queued_events");
 
-            // poll for write if queue was empty
-            if (QUEUESIZE == 0)
-                wl_event_source_fd_update(it->eventSource, WL_EVENT_WRITABLE);
-        }
+    const auto SEQ = m_iNextSeq++;
 
-        ++it;
+    // the ring has to hold everything a client is allowed to lag behind. Move cursors off the slot
+    // we are about to reuse before overwriting it.
+    const auto MAXQUEUED = (uint64_t)std::clamp(*PMAXQUEUED, (Hyprlang::INT)1, (Hyprlang::INT)EVENT_RING_SIZE);
+    for (auto& client : m_vClients) {
+        dropBehind(client, MAXQUEUED);
     }
+
+    m_vEventRing[SEQ % EVENT_RING_SIZE] = makeShared<std::string>(formatEvent(event));
+
+    // batch everything posted during this dispatch into one writev per client
+    if (!m_pFlushSource)
+        m_pFlushSource = wl_event_loop_add_idle(g_pCompositor->m_wlEventLoop, onFlush, nullptr);
 }
@@ -21,24 +21,46 @@ class CEventManager {
 
     static int  onServerEvent(int fd, uint32_t mask, void* data);
     static int  onClientEvent(int fd, uint32_t mask, void* data);
+    static void onFlush(void* data);
 
     int         onServerEvent(int fd, uint32_t mask);
     int         onClientEvent(int fd, uint32_t mask);
 
     struct SClient {
         Hyprutils::OS::CFileDescriptor fd;
-        std::vector<SP<std::string>>   events;
-        wl_event_source*               eventSource = nullptr;
+        wl_event_source*               eventSource  = nullptr;
+        bool                           pollingWrite = false;
+
+        // sequence number of the next event in the ring to send, and how much of it went out already
+        uint64_t cursor = 0;
+        size_t   offset = 0;
+
+        // bytes that have to go out before the ring, i.e. the tail of a cut event and the drop marker
+        std::string pending;
+        size_t      pendingOffset = 0;
+        uint64_t    droppedEvents = 0;
     };
 
     std::vector<SClient>::iterator findClientByFD(int fd);
     std::vector<SClient>::iterator removeClientByFD(int fd);
 
+    const SP<std::string>&         eventAt(uint64_t seq) const;
+    void                           dropBehind(SClient& client, uint64_t maxQueued);
+    bool                           flushClient(SClient& client);
+    void                           consume(SClient& client, size_t len);
+
   private:
     Hyprutils::OS::CFileDescriptor m_iSocketFD;
     wl_event_source*               m_pEventSource = nullptr;
+    wl_event_source*               m_pFlushSource = nullptr;
 
     std::vector<SClient>           m_vClients;
+
+    // shared ring of formatted events, indexed by sequence number. Every client only keeps a cursor into it.
+    std::vector<SP<std::string>>   m_vEventRing;
+    uint64_t                       m_iNextSeq = 0;
+
+    static constexpr size_t        EVENT_RING_SIZE = 4096;
 };
 
 inline UP<CEventManager> g_pEventManager;
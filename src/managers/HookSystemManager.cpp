@@ -1,6 +1,7 @@
 #include "HookSystemManager.hpp"
 
 #include "../plugins/PluginSystem.hpp"
+#include "../helpers/time/Time.hpp"
 
 CHookSystemManager::CHookSystemManager() {
     ; //
@@ -15,6 +16,16 @@ SP<HOOK_CALLBACK_FN> CHookSystemManager::hookDynamic(const std::string& event, H
 
 void CHookSystemManager::unhook(SP<HOOK_CALLBACK_FN> fn) {
     for (auto& [k, v] : m_mRegisteredHooks) {
+        if (m_iEmitDepth > 0) {
+            // an emit is going over these by index, erasing would shift the next callback under it. Drop the pointer, emit() cleans up after.
+            for (auto& other : v) {
+                if (other.fn.lock().get() == fn.get())
+                    other.fn = {};
+            }
+
+            continue;
+        }
+
         std::erase_if(v, [&](const auto& other) {
             SP<HOOK_CALLBACK_FN> fn_ = other.fn.lock();
 
@@ -23,50 +34,76 @@ void CHookSystemManager::unhook(SP<HOOK_CALLBACK_FN> fn) {
     }
 }
 
-void CHookSystemManager::emit(std::vector<SCallbackFNPtr>* const callbacks, SCallbackInfo& info, std::any data) {
+void CHookSystemManager::emit(std::vector<SCallbackFNPtr>* const callbacks, SCallbackInfo& info, const std::any& data) {
     if (callbacks->empty())
         return;
 
     std::vector<HANDLE> faultyHandles;
     volatile bool       needsDeadCleanup = false;
 
-    for (auto const& cb : *callbacks) {
+    // the vector can grow under us if a callback hooks, so go by index and check the entry is still ours. Unhooking while we're here doesn't erase.
+    const auto recordTime = [callbacks](size_t idx, HOOK_CALLBACK_FN* fn, const Time::steady_tp& start) {
+        if (idx >= callbacks->size() || (*callbacks)[idx].fn.lock().get() != fn)
+            return;
+
+        const uint64_t NS = std::chrono::duration_cast<std::chrono::nanoseconds>(Time::steadyNow() - start).count();
+        auto&          cb = (*callbacks)[idx];
+        cb.calls++;
+        cb.totalNs += NS;
+        cb.maxNs = std::max(cb.maxNs, NS);
+    };
+
+    m_iEmitDepth++;
+
+    for (size_t i = 0; i < callbacks->size(); ++i) {
+        const auto           PHANDLE = (*callbacks)[i].handle;
+        SP<HOOK_CALLBACK_FN> fn      = (*callbacks)[i].fn.lock();
 
         m_bCurrentEventPlugin = false;
 
-        if (!cb.handle) {
+        if (!fn) {
+            needsDeadCleanup = true;
+            continue;
+        }
+
+        const auto START = m_bProfiling ? Time::steadyNow() : Time::steady_tp{};
+
+        if (!PHANDLE) {
             // we don't guard hl hooks
+            (*fn)(fn.get(), info, data);
 
-            if (SP<HOOK_CALLBACK_FN> fn = cb.fn.lock())
-                (*fn)(fn.get(), info, data);
-            else
-                needsDeadCleanup = true;
+            if (m_bProfiling)
+                recordTime(i, fn.get(), START);
             continue;
         }
 
         m_bCurrentEventPlugin = true;
 
-        if (std::find(faultyHandles.begin(), faultyHandles.end(), cb.handle) != faultyHandles.end())
+        if (std::find(faultyHandles.begin(), faultyHandles.end(), PHANDLE) != faultyHandles.end())
             continue;
 
         try {
-            if (!setjmp(m_jbHookFaultJumpBuf)) {
-                if (SP<HOOK_CALLBACK_FN> fn = cb.fn.lock())
-                    (*fn)(fn.get(), info, data);
-                else
-                    needsDeadCleanup = true;
-            } else {
+            if (!setjmp(m_jbHookFaultJumpBuf))
+                (*fn)(fn.get(), info, data);
+            else {
                 // this module crashed.
                 throw std::exception();
             }
         } catch (std::exception& e) {
             // TODO: this works only once...?
-            faultyHandles.push_back(cb.handle);
-            Debug::log(ERR, "[hookSystem] Hook from plugin {:x} caused a SIGSEGV, queueing for unloading.", (uintptr_t)cb.handle);
+            faultyHandles.push_back(PHANDLE);
+            Debug::log(ERR, "[hookSystem] Hook from plugin {:x} caused a SIGSEGV, queueing for unloading.", (uintptr_t)PHANDLE);
+            continue;
         }
+
+        if (m_bProfiling)
+            recordTime(i, fn.get(), START);
     }
 
-    if (needsDeadCleanup)
+    m_iEmitDepth--;
+
+    // a nested emit can't clean up, the outer one is still going. Whatever's left is found dead next time.
+    if (needsDeadCleanup && m_iEmitDepth == 0)
         std::erase_if(*callbacks, [](const auto& fn) { return !fn.fn.lock(); });
 
     if (!faultyHandles.empty()) {
@@ -75,6 +112,20 @@ void CHookSystemManager::emit(std::vector<SCallbackFNPtr>* const callbacks, SCal
     }
 }
 
+const std::unordered_map<std::string, std::vector<SCallbackFNPtr>>& CHookSystemManager::getRegisteredHooks() {
+    return m_mRegisteredHooks;
+}
+
+void CHookSystemManager::resetProfile() {
+    for (auto& [k, v] : m_mRegisteredHooks) {
+        for (auto& cb : v) {
+            cb.calls   = 0;
+            cb.totalNs = 0;
+            cb.maxNs   = 0;
+        }
+    }
+}
+
 std::vector<SCallbackFNPtr>* CHookSystemManager::getVecForEvent(const std::string& event) {
     if (!m_mRegisteredHooks.contains(event))
         Debug::log(LOG, "[hookSystem] New hook event registered: {}", event);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../defines.hpp"
+#include "../helpers/math/Math.hpp"
 
 #include <unordered_map>
 #include <any>
@@ -18,22 +19,83 @@ typedef std::function<void(void*, SCallbackInfo& info, std::any data)> HOOK_CALL
 struct SCallbackFNPtr {
     WP<HOOK_CALLBACK_FN> fn;
     HANDLE               handle = nullptr;
+
+    // only counted with debug:profile_hooks
+    uint64_t calls   = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs   = 0;
 };
 
+// the event is looked up once per call site. The payload isn't even evaluated if nothing is hooked.
 #define EMIT_HOOK_EVENT(name, param)                                                                                                                                               \
     {                                                                                                                                                                              \
         static auto* const PEVENTVEC = g_pHookSystem->getVecForEvent(name);                                                                                                        \
-        SCallbackInfo      info;                                                                                                                                                   \
-        g_pHookSystem->emit(PEVENTVEC, info, param);                                                                                                                               \
+        if (!PEVENTVEC->empty()) {                                                                                                                                                 \
+            SCallbackInfo info;                                                                                                                                                    \
+            g_pHookSystem->emit(PEVENTVEC, info, param);                                                                                                                           \
+        }                                                                                                                                                                          \
     }
 
 #define EMIT_HOOK_EVENT_CANCELLABLE(name, param)                                                                                                                                   \
     {                                                                                                                                                                              \
         static auto* const PEVENTVEC = g_pHookSystem->getVecForEvent(name);                                                                                                        \
-        SCallbackInfo      info;                                                                                                                                                   \
-        g_pHookSystem->emit(PEVENTVEC, info, param);                                                                                                                               \
-        if (info.cancelled)                                                                                                                                                        \
-            return;                                                                                                                                                                \
+        if (!PEVENTVEC->empty()) {                                                                                                                                                 \
+            SCallbackInfo info;                                                                                                                                                    \
+            g_pHookSystem->emit(PEVENTVEC, info, param);                                                                                                                           \
+            if (info.cancelled)                                                                                                                                                    \
+                return;                                                                                                                                                            \
+        }                                                                                                                                                                          \
+    }
+
+// hot events with internal subscribers. Those are called with the payload as is, it's only boxed into a std::any
+// for the plugin callbacks hooked on the same event name.
+enum eHookEvent : uint8_t {
+    HOOK_PRE_RENDER = 0,
+    HOOK_PRE_MONITOR_COMMIT,
+    HOOK_MOUSE_MOVE,
+};
+
+template <eHookEvent EVENT>
+struct SHookEvent;
+
+template <>
+struct SHookEvent<HOOK_PRE_RENDER> {
+    using Payload                     = PHLMONITOR;
+    static constexpr const char* NAME = "preRender";
+};
+
+template <>
+struct SHookEvent<HOOK_PRE_MONITOR_COMMIT> {
+    using Payload                     = PHLMONITOR;
+    static constexpr const char* NAME = "preMonitorCommit";
+};
+
+template <>
+struct SHookEvent<HOOK_MOUSE_MOVE> {
+    using Payload                     = Vector2D;
+    static constexpr const char* NAME = "mouseMove";
+};
+
+template <eHookEvent EVENT>
+using HOOK_TYPED_FN = std::function<void(SCallbackInfo& info, const typename SHookEvent<EVENT>::Payload& data)>;
+
+// like the above, for the typed events. The payload is evaluated only if something is hooked.
+#define EMIT_TYPED_HOOK_EVENT(event, param)                                                                                                                                        \
+    {                                                                                                                                                                              \
+        if (g_pHookSystem->hasSubscribers<event>()) {                                                                                                                              \
+            SCallbackInfo info;                                                                                                                                                    \
+            g_pHookSystem->emitTyped<event>(info, param);                                                                                                                          \
+        }                                                                                                                                                                          \
+    }
+
+#define EMIT_TYPED_HOOK_EVENT_CANCELLABLE(event, param)                                                                                                                            \
+    {                                                                                                                                                                              \
+        if (g_pHookSystem->hasSubscribers<event>()) {                                                                                                                              \
+            SCallbackInfo info;                                                                                                                                                    \
+            g_pHookSystem->emitTyped<event>(info, param);                                                                                                                          \
+            if (info.cancelled)                                                                                                                                                    \
+                return;                                                                                                                                                            \
+        }                                                                                                                                                                          \
     }
 
 class CHookSystemManager {
@@ -47,14 +109,74 @@ class CHookSystemManager {
                                                                                                              HANDLE handle = nullptr);
     void                                                                                         unhook(SP<HOOK_CALLBACK_FN> fn);
 
-    void                         emit(std::vector<SCallbackFNPtr>* const callbacks, SCallbackInfo& info, std::any data = 0);
+    void                         emit(std::vector<SCallbackFNPtr>* const callbacks, SCallbackInfo& info, const std::any& data = 0);
     std::vector<SCallbackFNPtr>* getVecForEvent(const std::string& event);
 
-    bool                         m_bCurrentEventPlugin = false;
-    jmp_buf                      m_jbHookFaultJumpBuf;
+    // internal only, plugins go through hookDynamic. Same as there, losing the pointer unregisters the callback.
+    template <eHookEvent EVENT>
+    [[nodiscard("Losing this pointer instantly unregisters the callback")]] SP<HOOK_TYPED_FN<EVENT>> registerTyped(HOOK_TYPED_FN<EVENT> fn) {
+        auto hookFN = makeShared<HOOK_TYPED_FN<EVENT>>(std::move(fn));
+        typedHooks<EVENT>().emplace_back(hookFN);
+        return hookFN;
+    }
+
+    template <eHookEvent EVENT>
+    bool hasSubscribers() {
+        return !typedHooks<EVENT>().empty() || !pluginHooks<EVENT>()->empty();
+    }
+
+    template <eHookEvent EVENT>
+    void emitTyped(SCallbackInfo& info, const typename SHookEvent<EVENT>::Payload& data) {
+        auto& callbacks        = typedHooks<EVENT>();
+        bool  needsDeadCleanup = false;
+
+        m_iEmitDepth++;
+
+        // by index, a callback might register another one
+        for (size_t i = 0; i < callbacks.size(); ++i) {
+            const auto FN = callbacks[i].lock();
+
+            if (!FN) {
+                needsDeadCleanup = true;
+                continue;
+            }
+
+            (*FN)(info, data);
+        }
+
+        m_iEmitDepth--;
+
+        if (needsDeadCleanup && m_iEmitDepth == 0)
+            std::erase_if(callbacks, [](const auto& fn) { return fn.expired(); });
+
+        if (const auto PLUGINHOOKS = pluginHooks<EVENT>(); !PLUGINHOOKS->empty())
+            emit(PLUGINHOOKS, info, std::any{data});
+    }
+
+    const std::unordered_map<std::string, std::vector<SCallbackFNPtr>>& getRegisteredHooks();
+    void                                                                resetProfile();
+
+    bool                                                                m_bCurrentEventPlugin = false;
+    bool                                                                m_bProfiling          = false;
+    jmp_buf                                                             m_jbHookFaultJumpBuf;
 
   private:
+    template <eHookEvent EVENT>
+    static std::vector<WP<HOOK_TYPED_FN<EVENT>>>& typedHooks() {
+        static std::vector<WP<HOOK_TYPED_FN<EVENT>>> callbacks;
+        return callbacks;
+    }
+
+    template <eHookEvent EVENT>
+    std::vector<SCallbackFNPtr>* pluginHooks() {
+        static auto* const PEVENTVEC = getVecForEvent(SHookEvent<EVENT>::NAME);
+        return PEVENTVEC;
+    }
+
     std::unordered_map<std::string, std::vector<SCallbackFNPtr>> m_mRegisteredHooks;
+
+    // emit() and emitTyped() go over the callbacks by index, don't erase from under them
+    int m_iEmitDepth = 0;
 };
 
 inline UP<CHookSystemManager> g_pHookSystem;
@@ -12,6 +12,7 @@
 #include "TokenManager.hpp"
 #include "eventLoop/EventLoopManager.hpp"
 #include "debug/Log.hpp"
+#include "debug/Trace.hpp"
 #include "../managers/HookSystemManager.hpp"
 #include "../managers/input/InputManager.hpp"
 #include "../managers/LayoutManager.hpp"
@@ -32,16 +33,21 @@ using namespace Hyprutils::String;
 using namespace Hyprutils::OS;
 
 #include <sys/ioctl.h>
+#include <sys/wait.h>
 #include <fcntl.h>
+#include <spawn.h>
 #include <vector>
 #if defined(__linux__)
 #include <linux/vt.h>
+#include <sys/syscall.h>
 #elif defined(__NetBSD__) || defined(__OpenBSD__)
 #include <dev/wscons/wsdisplay_usl_io.h>
 #elif defined(__DragonFly__) || defined(__FreeBSD__)
 #include <sys/consio.h>
 #endif
 
+extern "C" char** environ;
+
 static std::vector<std::pair<std::string, std::string>> getHyprlandLaunchEnv(PHLWORKSPACE pInitialWorkspace) {
     static auto PINITIALWSTRACKING = CConfigValue<Hyprlang::INT>("misc:initial_workspace_tracking");
 
@@ -211,6 +217,7 @@ CKeybindManager::~CKeybindManager() {
 
 void CKeybindManager::addKeybind(SKeybind kb) {
     m_vKeybinds.emplace_back(makeShared<SKeybind>(kb));
+    m_pKeybindTable.reset();
 
     m_vActiveKeybinds.clear();
     m_pLastLongPressKeybind.reset();
@@ -218,6 +225,7 @@ void CKeybindManager::addKeybind(SKeybind kb) {
 
 void CKeybindManager::removeKeybind(uint32_t mod, const SParsedKey& key) {
     std::erase_if(m_vKeybinds, [&mod, &key](const auto& el) { return el->modmask == mod && el->key == key.key && el->keycode == key.keycode && el->catchAll == key.catchAll; });
+    m_pKeybindTable.reset();
 
     m_vActiveKeybinds.clear();
     m_pLastLongPressKeybind.reset();
@@ -649,7 +657,72 @@ std::string CKeybindManager::getCurrentSubmap() {
     return m_szCurrentSelectedSubmap;
 }
 
+size_t CKeybindManager::SKeybindLookupKeyHash::operator()(const SKeybindLookupKey& key) const {
+    size_t hash = std::hash<uint64_t>{}(((uint64_t)key.submap << 32) | key.modmask);
+    hash ^= std::hash<uint32_t>{}(key.code) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+static eKeybindHandler handlerKindFromName(const std::string& handler) {
+    if (handler == "global")
+        return KEYBIND_HANDLER_GLOBAL;
+    if (handler == "pass")
+        return KEYBIND_HANDLER_PASS;
+    if (handler == "sendshortcut")
+        return KEYBIND_HANDLER_SENDSHORTCUT;
+    if (handler == "mouse")
+        return KEYBIND_HANDLER_MOUSE;
+    if (handler == "submap")
+        return KEYBIND_HANDLER_SUBMAP;
+    return KEYBIND_HANDLER_OTHER;
+}
+
+SP<CKeybindManager::SKeybindTable> CKeybindManager::keybindTable() {
+    if (m_pKeybindTable)
+        return m_pKeybindTable;
+
+    auto table = makeShared<SKeybindTable>();
+    table->binds.reserve(m_vKeybinds.size());
+
+    for (const auto& k : m_vKeybinds) {
+        const uint32_t IDX = table->binds.size();
+
+        auto&          compiled = table->binds.emplace_back(SCompiledKeybind{.bind = k});
+        compiled.handler        = handlerKindFromName(k->handler);
+        compiled.special        = compiled.handler == KEYBIND_HANDLER_GLOBAL || compiled.handler == KEYBIND_HANDLER_PASS || compiled.handler == KEYBIND_HANDLER_SENDSHORTCUT ||
+            compiled.handler == KEYBIND_HANDLER_MOUSE;
+
+        // resolving names costs a few µs each, do it once here instead of on every key event
+        compiled.keysym         = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_NO_FLAGS);
+        compiled.keysymLower    = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+        table->indices[k.get()] = IDX;
+
+        if (k->multiKey || k->catchAll || k->ignoreMods) {
+            table->unkeyed.emplace_back(IDX);
+            continue;
+        }
+
+        const uint32_t SUBMAP = table->submaps.try_emplace(k->submap, table->submaps.size()).first->second;
+
+        table->byName[k->key].emplace_back(IDX);
+
+        if (k->keycode != 0)
+            table->byKeycode[{.submap = SUBMAP, .modmask = k->modmask, .code = k->keycode}].emplace_back(IDX);
+        else {
+            if (compiled.keysym != XKB_KEY_NoSymbol)
+                table->byKeysym[{.submap = SUBMAP, .modmask = k->modmask, .code = compiled.keysym}].emplace_back(IDX);
+            if (compiled.keysymLower != XKB_KEY_NoSymbol && compiled.keysymLower != compiled.keysym)
+                table->byKeysym[{.submap = SUBMAP, .modmask = k->modmask, .code = compiled.keysymLower}].emplace_back(IDX);
+        }
+    }
+
+    m_pKeybindTable = table;
+    return table;
+}
+
 SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SPressedKeyWithMods& key, bool pressed) {
+    TRACE_ZONE("keybinds", "input");
+
     static auto     PDISABLEINHIBIT = CConfigValue<Hyprlang::INT>("binds:disable_keybind_grabbing");
     static auto     PDRAGTHRESHOLD  = CConfigValue<Hyprlang::INT>("binds:drag_threshold");
 
@@ -668,9 +741,42 @@ SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SP
             m_sMkKeys.erase(key.keysym);
     }
 
-    for (auto& k : m_vKeybinds) {
-        const bool SPECIALDISPATCHER = k->handler == "global" || k->handler == "pass" || k->handler == "sendshortcut" || k->handler == "mouse";
-        const bool SPECIALTRIGGERED =
+    // held by value, a dispatcher might change the binds under us
+    const auto            TABLE = keybindTable();
+
+    std::vector<uint32_t> candidates = TABLE->unkeyed;
+
+    const auto            appendCandidates = [&candidates](const auto& map, const auto& lookupKey) {
+        if (const auto IT = map.find(lookupKey); IT != map.end())
+            candidates.insert(candidates.end(), IT->second.begin(), IT->second.end());
+    };
+
+    if (!key.keyName.empty())
+        appendCandidates(TABLE->byName, key.keyName);
+    else if (const auto SUBMAP = TABLE->submaps.find(m_szCurrentSelectedSubmap); SUBMAP != TABLE->submaps.end()) {
+        if (key.keycode != 0)
+            appendCandidates(TABLE->byKeycode, SKeybindLookupKey{.submap = SUBMAP->second, .modmask = modmask, .code = key.keycode});
+        if (key.keysym != XKB_KEY_NoSymbol)
+            appendCandidates(TABLE->byKeysym, SKeybindLookupKey{.submap = SUBMAP->second, .modmask = modmask, .code = key.keysym});
+    }
+
+    // special binds are released regardless of the current mods and submap
+    if (!pressed) {
+        for (const auto& special : m_vPressedSpecialBinds) {
+            if (const auto IT = TABLE->indices.find(special.get()); IT != TABLE->indices.end())
+                candidates.emplace_back(IT->second);
+        }
+    }
+
+    // keep the config order, earlier binds can affect later ones
+    std::ranges::sort(candidates);
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (const auto IDX : candidates) {
+        const auto& COMPILED          = TABLE->binds[IDX];
+        const auto& k                 = COMPILED.bind;
+        const bool  SPECIALDISPATCHER = COMPILED.special;
+        const bool  SPECIALTRIGGERED =
             std::find_if(m_vPressedSpecialBinds.begin(), m_vPressedSpecialBinds.end(), [&](const auto& other) { return other == k; }) != m_vPressedSpecialBinds.end();
         const bool IGNORECONDITIONS =
             SPECIALDISPATCHER && !pressed && SPECIALTRIGGERED; // ignore mods. Pass, global dispatchers should be released immediately once the key is released.
@@ -705,10 +811,8 @@ SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SP
             if (key.keysym == XKB_KEY_NoSymbol)
                 continue;
 
-            // oMg such performance hit!!11!
-            // this little maneouver is gonna cost us 4µs
-            const auto KBKEY      = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_NO_FLAGS);
-            const auto KBKEYLOWER = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+            const auto KBKEY      = COMPILED.keysym;
+            const auto KBKEYLOWER = COMPILED.keysymLower;
 
             if (KBKEY == XKB_KEY_NoSymbol && KBKEYLOWER == XKB_KEY_NoSymbol) {
                 // Keysym failed to resolve from the key name of the currently iterated bind.
@@ -789,14 +893,14 @@ SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SP
             m_iPassPressed = (int)pressed;
 
             // if the dispatchers says to pass event then we will
-            if (k->handler == "mouse")
+            if (COMPILED.handler == KEYBIND_HANDLER_MOUSE)
                 res = DISPATCHER->second((pressed ? "1" : "0") + k->arg);
             else
                 res = DISPATCHER->second(k->arg);
 
             m_iPassPressed = -1;
 
-            if (k->handler == "submap")
+            if (COMPILED.handler == KEYBIND_HANDLER_SUBMAP)
                 break;
         }
 
@@ -830,17 +934,20 @@ SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SP
 void CKeybindManager::shadowKeybinds(const xkb_keysym_t& doesntHave, const uint32_t doesntHaveCode) {
     // shadow disables keybinds after one has been triggered
 
-    for (auto& k : m_vKeybinds) {
+    const auto TABLE = keybindTable();
 
-        bool shadow = false;
+    for (const auto& compiled : TABLE->binds) {
+        const auto& k = compiled.bind;
 
-        if (k->handler == "global" || k->transparent)
+        bool        shadow = false;
+
+        if (compiled.handler == KEYBIND_HANDLER_GLOBAL || k->transparent)
             continue; // can't be shadowed
 
         if (k->multiKey && (mkBindMatches(k) == MK_FULL_MATCH))
             shadow = true;
         else {
-            const auto KBKEY      = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+            const auto KBKEY      = compiled.keysymLower;
             const auto KBKEYUPPER = xkb_keysym_to_upper(KBKEY);
 
             for (auto const& pk : m_dPressedKeys) {
@@ -960,12 +1067,129 @@ SDispatchResult CKeybindManager::spawnRaw(std::string args) {
     return {.success = PROC > 0, .error = std::format("Failed to start process {}", args)};
 }
 
+// a pidfd lets us reap a directly spawned child from the event loop.
+static CFileDescriptor openPidFD(pid_t pid) {
+#if defined(__linux__) && defined(SYS_pidfd_open)
+    return CFileDescriptor{(int)syscall(SYS_pidfd_open, pid, 0)};
+#else
+    return {};
+#endif
+}
+
+static bool canSpawnDirectly() {
+    static const bool SUPPORTED = openPidFD(getpid()).isValid();
+    return SUPPORTED;
+}
+
+// children we couldn't get a pidfd for (e.g. out of fds), polled until they're reaped
+static std::vector<pid_t>  unreapedChildren;
+static SP<CEventLoopTimer> reapTimer;
+
+static void reapLater(pid_t pid) {
+    unreapedChildren.emplace_back(pid);
+
+    if (!reapTimer) {
+        reapTimer = makeShared<CEventLoopTimer>(
+            std::nullopt,
+            [](SP<CEventLoopTimer> self, void* data) {
+                std::erase_if(unreapedChildren, [](pid_t child) { return waitpid(child, nullptr, WNOHANG) != 0; });
+
+                if (!unreapedChildren.empty())
+                    self->updateTimeout(std::chrono::seconds(1));
+            },
+            nullptr);
+        g_pEventLoopManager->addTimer(reapTimer);
+    }
+
+    if (!reapTimer->armed())
+        reapTimer->updateTimeout(std::chrono::seconds(1));
+}
+
+// posix_spawn doesn't copy the compositor's address space like fork does, so it stays cheap no matter how much we have mapped.
+static pid_t spawnDirectly(const std::string& args, const std::vector<std::pair<std::string, std::string>>& envOverrides) {
+    std::vector<std::string> env;
+    for (char** e = environ; e && *e; ++e) {
+        const std::string_view ENTRY = *e;
+        const auto             KEY   = ENTRY.substr(0, ENTRY.find('='));
+        if (std::ranges::any_of(envOverrides, [&](const auto& o) { return o.first == KEY; }))
+            continue;
+        env.emplace_back(ENTRY);
+    }
+
+    for (auto const& [k, v] : envOverrides) {
+        env.emplace_back(k + "=" + v);
+    }
+
+    std::vector<char*> envp;
+    envp.reserve(env.size() + 1);
+    for (auto& e : env) {
+        envp.push_back(e.data());
+    }
+    envp.push_back(nullptr);
+
+    // the child should get the original NOFILE limit. posix_spawn can't set one, and lowering ours around the spawn would race with our other threads,
+    // so the shell drops it before running the command. bumpNofile() only raises the soft limit.
+    std::string   script        = args;
+    const rlimit& NOFILE        = g_pCompositor->originalNofile();
+    rlimit        currentNofile = {};
+    if (NOFILE.rlim_max > 0 && !getrlimit(RLIMIT_NOFILE, &currentNofile) && currentNofile.rlim_cur != NOFILE.rlim_cur)
+        script = std::format("ulimit -Sn {} 2>/dev/null\n{}", NOFILE.rlim_cur == RLIM_INFINITY ? std::string{"unlimited"} : std::to_string(NOFILE.rlim_cur), args);
+
+    const char*                argv[] = {"/bin/sh", "-c", script.c_str(), nullptr};
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t set;
+    sigemptyset(&set);
+    posix_spawnattr_setsigmask(&attr, &set);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+    pid_t     pid = -1;
+    const int RET = posix_spawn(&pid, "/bin/sh", &actions, &attr, (char* const*)argv, envp.data());
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (RET != 0) {
+        Debug::log(ERR, "posix_spawn failed: {}", strerror(RET));
+        return -1;
+    }
+
+    // we're the parent now, instead of init. Reap it when it exits.
+    // doOnReadable would call us right away with an invalid fd, long before the child is done, so poll for it instead.
+    if (auto pidfd = openPidFD(pid); pidfd.isValid())
+        g_pEventLoopManager->doOnReadable(std::move(pidfd), [pid]() { waitpid(pid, nullptr, WNOHANG); });
+    else
+        reapLater(pid);
+
+    return pid;
+}
+
 uint64_t CKeybindManager::spawnRawProc(std::string args, PHLWORKSPACE pInitialWorkspace) {
     Debug::log(LOG, "Executing {}", args);
 
     const auto HLENV = getHyprlandLaunchEnv(pInitialWorkspace);
 
-    int        socket[2];
+    if (canSpawnDirectly()) {
+        auto env = HLENV;
+        env.emplace_back("WAYLAND_DISPLAY", g_pCompositor->m_wlDisplaySocket);
+
+        const pid_t PID = spawnDirectly(args, env);
+        if (PID <= 0)
+            return 0;
+
+        Debug::log(LOG, "Process Created with pid {}", PID);
+
+        return PID;
+    }
+
+    // no pidfds, double fork so init reaps it
+    int socket[2];
     if (pipe(socket) != 0) {
         Debug::log(LOG, "Unable to create pipe for fork");
     }
@@ -1120,6 +1344,11 @@ SDispatchResult CKeybindManager::signalWindow(std::string args) {
 
 void CKeybindManager::clearKeybinds() {
     m_vKeybinds.clear();
+    m_pKeybindTable.reset();
+}
+
+const std::vector<SP<SKeybind>>& CKeybindManager::getKeybinds() const {
+    return m_vKeybinds;
 }
 
 static SDispatchResult toggleActiveFloatingCore(std::string args, std::optional<bool> floatState) {
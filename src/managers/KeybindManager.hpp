@@ -79,6 +79,15 @@ enum eMultiKeyCase : uint8_t {
     MK_FULL_MATCH
 };
 
+enum eKeybindHandler : uint8_t {
+    KEYBIND_HANDLER_OTHER = 0,
+    KEYBIND_HANDLER_GLOBAL,
+    KEYBIND_HANDLER_PASS,
+    KEYBIND_HANDLER_SENDSHORTCUT,
+    KEYBIND_HANDLER_MOUSE,
+    KEYBIND_HANDLER_SUBMAP,
+};
+
 class CKeybindManager {
   public:
     CKeybindManager();
@@ -97,6 +106,8 @@ class CKeybindManager {
     uint32_t                                                                     stringToModMask(std::string);
     uint32_t                                                                     keycodeToModifier(xkb_keycode_t);
     void                                                                         clearKeybinds();
+    // go through add/remove/clear to change them, the lookup tables are built from these
+    const std::vector<SP<SKeybind>>&                                             getKeybinds() const;
     void                                                                         shadowKeybinds(const xkb_keysym_t& doesntHave = 0, const uint32_t doesntHaveCode = 0);
     std::string                                                                  getCurrentSubmap();
 
@@ -104,8 +115,6 @@ class CKeybindManager {
 
     bool                                                                         m_bGroupsLocked = false;
 
-    std::vector<SP<SKeybind>>                                                    m_vKeybinds;
-
     //since we cant find keycode through keyname in xkb:
     //on sendshortcut call, we once search for keyname (e.g. "g") the correct keycode (e.g. 42)
     //and cache it in this map to make sendshortcut calls faster
@@ -115,6 +124,8 @@ class CKeybindManager {
     static SDispatchResult                         changeMouseBindMode(const eMouseBindMode mode);
 
   private:
+    std::vector<SP<SKeybind>>        m_vKeybinds;
+
     std::vector<SPressedKeyWithMods> m_dPressedKeys;
 
     inline static std::string        m_szCurrentSelectedSubmap = "";
@@ -140,6 +151,41 @@ class CKeybindManager {
     eMultiKeyCase                    mkBindMatches(const SP<SKeybind>);
     eMultiKeyCase                    mkKeysymSetMatches(const std::set<xkb_keysym_t>, const std::set<xkb_keysym_t>);
 
+    // binds precompiled into lookup tables keyed by (submap, modmask, keysym / keycode).
+    // rebuilt lazily after the binds change.
+    struct SKeybindLookupKey {
+        uint32_t submap  = 0;
+        uint32_t modmask = 0;
+        uint32_t code    = 0; // keysym or keycode
+
+        bool     operator==(const SKeybindLookupKey&) const = default;
+    };
+
+    struct SKeybindLookupKeyHash {
+        size_t operator()(const SKeybindLookupKey& key) const;
+    };
+
+    struct SCompiledKeybind {
+        SP<SKeybind>    bind;
+        xkb_keysym_t    keysym      = XKB_KEY_NoSymbol;
+        xkb_keysym_t    keysymLower = XKB_KEY_NoSymbol; // resolved case insensitively
+        eKeybindHandler handler     = KEYBIND_HANDLER_OTHER;
+        bool            special     = false; // global, pass, sendshortcut and mouse get released regardless of mods
+    };
+
+    struct SKeybindTable {
+        std::vector<SCompiledKeybind>                                                       binds; // same order as m_vKeybinds
+        std::unordered_map<std::string, uint32_t>                                           submaps;
+        std::unordered_map<SKeybindLookupKey, std::vector<uint32_t>, SKeybindLookupKeyHash> byKeysym;
+        std::unordered_map<SKeybindLookupKey, std::vector<uint32_t>, SKeybindLookupKeyHash> byKeycode;
+        std::unordered_map<std::string, std::vector<uint32_t>>                              byName;  // mouse, switch and scroll events
+        std::vector<uint32_t>                                                               unkeyed; // catchall, multikey and ignoremods, checked on every event
+        std::unordered_map<const SKeybind*, uint32_t>                                       indices;
+    };
+
+    SP<SKeybindTable>                m_pKeybindTable; // null when dirty
+    SP<SKeybindTable>                keybindTable();
+
     bool                             handleInternalKeybinds(xkb_keysym_t);
     bool                             handleVT(xkb_keysym_t);
 
@@ -39,8 +39,8 @@ CPointerManager::CPointerManager() {
             nullptr);
     });
 
-    hooks.monitorPreRender = g_pHookSystem->hookDynamic("preMonitorCommit", [this](void* self, SCallbackInfo& info, std::any data) {
-        auto state = stateFor(std::any_cast<PHLMONITOR>(data));
+    hooks.monitorPreRender = g_pHookSystem->registerTyped<HOOK_PRE_MONITOR_COMMIT>([this](SCallbackInfo& info, const PHLMONITOR& pMonitor) {
+        auto state = stateFor(pMonitor);
         if (!state)
             return;
 
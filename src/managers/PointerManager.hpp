@@ -7,6 +7,7 @@
 #include "../desktop/WLSurface.hpp"
 #include "../helpers/sync/SyncTimeline.hpp"
 #include "../helpers/time/Time.hpp"
+#include "HookSystemManager.hpp"
 #include <tuple>
 
 class CMonitor;
@@ -180,8 +181,8 @@ class CPointerManager {
     bool                                  setHWCursorBuffer(SP<SMonitorPointerState> state, SP<Aquamarine::IBuffer> buf);
 
     struct {
-        SP<HOOK_CALLBACK_FN> monitorAdded;
-        SP<HOOK_CALLBACK_FN> monitorPreRender;
+        SP<HOOK_CALLBACK_FN>                       monitorAdded;
+        SP<HOOK_TYPED_FN<HOOK_PRE_MONITOR_COMMIT>> monitorPreRender;
     } hooks;
 };
 
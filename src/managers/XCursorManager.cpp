@@ -106,81 +106,196 @@ CXCursorManager::CXCursorManager() {
 
     hyprCursor->images.push_back(image);
     hyprCursor->shape = "left_ptr";
-    defaultCursor     = hyprCursor;
+}
+
+CXCursorManager::~CXCursorManager() {
+    stopPreload();
 }
 
 void CXCursorManager::loadTheme(std::string const& name, int size, float scale) {
-    if (lastLoadSize == (size * std::ceil(scale)) && themeName == name && lastLoadScale == scale)
+    const auto NEWNAME = name.empty() ? "default" : name;
+    const int  NEWSIZE = size * std::ceil(scale);
+
+    if (lastLoadSize == NEWSIZE && themeName == NEWNAME && lastLoadScale == scale)
         return;
 
-    lastLoadSize  = size * std::ceil(scale);
+    lastLoadSize  = NEWSIZE;
     lastLoadScale = scale;
-    themeName     = name.empty() ? "default" : name;
-    defaultCursor.reset();
-    cursors.clear();
-
-    auto paths = themePaths(themeName);
-    if (paths.empty()) {
-        Debug::log(ERR, "XCursor librarypath is empty loading standard XCursors");
-        cursors = loadStandardCursors(themeName, lastLoadSize);
-    } else {
-        for (auto const& p : paths) {
-            try {
-                auto dirCursors = loadAllFromDir(p, lastLoadSize);
-                std::copy_if(dirCursors.begin(), dirCursors.end(), std::back_inserter(cursors),
-                             [this](auto const& p) { return std::none_of(cursors.begin(), cursors.end(), [&p](auto const& dp) { return dp->shape == p->shape; }); });
-            } catch (std::exception& e) { Debug::log(ERR, "XCursor path {} can't be loaded: threw error {}", p, e.what()); }
+
+    if (themeName != NEWNAME) {
+        stopPreload();
+
+        themeName = NEWNAME;
+        shapeIndex.clear();
+
+        {
+            std::lock_guard<std::mutex> lg(cacheMutex);
+            cache.clear();
+        }
+
+        auto paths = themePaths(themeName);
+        if (paths.empty()) {
+            Debug::log(ERR, "XCursor librarypath is empty loading standard XCursors");
+            indexStandardCursors();
+        } else {
+            for (auto const& p : paths) {
+                try {
+                    indexDir(p);
+                } catch (std::exception& e) { Debug::log(ERR, "XCursor path {} can't be loaded: threw error {}", p, e.what()); }
+            }
         }
+
+        if (shapeIndex.empty())
+            Debug::log(ERR, "XCursor failed finding any shapes in theme \"{}\".", themeName);
+        else
+            Debug::log(LOG, "XCursor indexed {} shapes in theme \"{}\"", shapeIndex.size(), themeName);
     }
 
-    if (cursors.empty()) {
-        Debug::log(ERR, "XCursor failed finding any shapes in theme \"{}\".", themeName);
-        defaultCursor = hyprCursor;
-        return;
+    startPreload(lastLoadSize);
+
+    syncGsettings();
+}
+
+SP<SXCursors> CXCursorManager::getShape(std::string const& shape, int size, float scale) {
+    // nothing is reloaded on a size change, every size just has its own cache
+    const int LOADSIZE = size * std::ceil(scale);
+
+    if (auto cursor = getOrLoad(shape, LOADSIZE))
+        return cursor;
+
+    Debug::log(WARN, "XCursor couldn't find shape {} , using default cursor instead", shape);
+
+    for (auto const& fallback : {"left_ptr", "arrow"}) {
+        if (auto cursor = getOrLoad(fallback, LOADSIZE))
+            return cursor;
     }
 
-    for (auto const& shape : CURSOR_SHAPE_NAMES) {
-        auto legacyName = getLegacyShapeName(shape);
-        if (legacyName.empty())
-            continue;
+    // broken theme.. just use anything.
+    if (!shapeIndex.empty()) {
+        if (auto cursor = getOrLoad(shapeIndex.begin()->first, LOADSIZE))
+            return cursor;
+    }
 
-        auto it = std::find_if(cursors.begin(), cursors.end(), [&legacyName](auto const& c) { return c->shape == legacyName; });
+    return hyprCursor;
+}
 
-        if (it == cursors.end()) {
-            Debug::log(LOG, "XCursor failed to find a legacy shape with name {}, skipping", legacyName);
-            continue;
-        }
+SP<SXCursors> CXCursorManager::getOrLoad(std::string const& shape, int size) {
+    {
+        std::lock_guard<std::mutex> lg(cacheMutex);
+        if (auto it = cache[size].find(shape); it != cache[size].end())
+            return it->second;
+    }
 
-        if (std::any_of(cursors.begin(), cursors.end(), [&shape](auto const& dp) { return dp->shape == shape; })) {
-            Debug::log(LOG, "XCursor already has a shape {} loaded, skipping", shape);
-            continue;
+    SP<SXCursors> cursor;
+
+    if (auto it = shapeIndex.find(shape); it != shapeIndex.end())
+        cursor = loadShape(shape, it->second, size);
+    else if (auto legacyName = getLegacyShapeName(shape); !legacyName.empty() && legacyName != shape)
+        cursor = getOrLoad(legacyName, size);
+
+    if (!cursor)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lg(cacheMutex);
+    cache[size][shape] = cursor;
+    return cursor;
+}
+
+SP<SXCursors> CXCursorManager::loadShape(std::string const& shape, SShapeSource const& source, int size) {
+    XcursorImages* xImages = nullptr;
+
+    if (source.standardIndex >= 0) {
+        xImages = XcursorShapeLoadImages(source.standardIndex << 1 /* wtf xcursor? */, themeName.c_str(), size);
+
+        if (!xImages) {
+            Debug::log(WARN, "XCursor failed to find a shape with name {}, trying size 24.", shape);
+            xImages = XcursorShapeLoadImages(source.standardIndex << 1 /* wtf xcursor? */, themeName.c_str(), 24);
         }
+    } else {
+        using PcloseType = int (*)(FILE*);
+        const std::unique_ptr<FILE, PcloseType> f(fopen(source.path.c_str(), "r"), static_cast<PcloseType>(fclose));
 
-        auto cursor    = makeShared<SXCursors>();
-        cursor->images = it->get()->images;
-        cursor->shape  = shape;
+        if (!f)
+            return nullptr;
 
-        cursors.emplace_back(cursor);
+        xImages = XcursorFileLoadImages(f.get(), size);
+
+        if (!xImages) {
+            Debug::log(WARN, "XCursor failed to load image {}, trying size 24.", source.path);
+            xImages = XcursorFileLoadImages(f.get(), 24);
+        }
     }
 
-    syncGsettings();
+    if (!xImages) {
+        Debug::log(WARN, "XCursor failed to load shape {}, skipping", shape);
+        return nullptr;
+    }
+
+    auto cursor = createCursor(shape, xImages);
+
+    XcursorImagesDestroy(xImages);
+
+    return cursor;
 }
 
-SP<SXCursors> CXCursorManager::getShape(std::string const& shape, int size, float scale) {
-    // monitor scaling changed etc, so reload theme with new size.
-    if ((size * std::ceil(scale)) != lastLoadSize || scale != lastLoadScale)
-        loadTheme(themeName, size, scale);
+void CXCursorManager::startPreload(int size) {
+    stopPreload();
 
-    // try to get an icon we know if we have one
-    for (auto const& c : cursors) {
-        if (c->shape != shape)
+    // the shapes clients actually ask for, decoded in the background so the first use of each doesn't hit the disk.
+    // the thread works on its own copies and only touches the cache once, under the lock,
+    // our SPs aren't atomic.
+    std::vector<std::pair<std::string, SShapeSource>> sources;
+    for (auto const& shape : CURSOR_SHAPE_NAMES) {
+        auto name = std::string{shape};
+        auto it   = shapeIndex.find(name);
+        if (it == shapeIndex.end())
+            it = shapeIndex.find(getLegacyShapeName(name));
+        if (it == shapeIndex.end())
             continue;
 
-        return c;
+        sources.emplace_back(name, it->second);
     }
 
-    Debug::log(WARN, "XCursor couldn't find shape {} , using default cursor instead", shape);
-    return defaultCursor;
+    if (auto it = shapeIndex.find("left_ptr"); it != shapeIndex.end())
+        sources.emplace_back("left_ptr", it->second);
+
+    preloadAbort  = false;
+    preloadThread = std::thread([this, size, sources = std::move(sources)]() {
+        std::unordered_map<std::string, SP<SXCursors>> loaded;
+        std::unordered_map<std::string, SP<SXCursors>> byPath;
+
+        for (auto const& [shape, source] : sources) {
+            if (preloadAbort)
+                return;
+
+            // legacy names share the file they map to
+            const auto KEY = source.standardIndex >= 0 ? std::to_string(source.standardIndex) : source.path;
+            if (!byPath.contains(KEY))
+                byPath[KEY] = loadShape(shape, source, size);
+
+            if (byPath[KEY])
+                loaded[shape] = byPath[KEY];
+        }
+
+        std::lock_guard<std::mutex> lg(cacheMutex);
+        auto&                       sizeCache = cache[size];
+        for (auto& [shape, cursor] : loaded) {
+            if (!sizeCache.contains(shape))
+                sizeCache[shape] = std::move(cursor);
+        }
+
+        // drop our references while we still hold the lock
+        loaded.clear();
+        byPath.clear();
+    });
+}
+
+void CXCursorManager::stopPreload() {
+    if (!preloadThread.joinable())
+        return;
+
+    preloadAbort = true;
+    preloadThread.join();
 }
 
 SP<SXCursors> CXCursorManager::createCursor(std::string const& shape, void* ximages) {
@@ -483,86 +598,26 @@ static std::array<const char*, 77> XCURSOR_STANDARD_NAMES = {
 };
 // clang-format on
 
-std::vector<SP<SXCursors>> CXCursorManager::loadStandardCursors(std::string const& name, int size) {
-    std::vector<SP<SXCursors>> newCursors;
-
-    // load the default xcursor shapes that exist in the theme
+void CXCursorManager::indexStandardCursors() {
     for (size_t i = 0; i < XCURSOR_STANDARD_NAMES.size(); ++i) {
-        std::string shape{XCURSOR_STANDARD_NAMES[i]};
-        auto        xImages = XcursorShapeLoadImages(i << 1 /* wtf xcursor? */, name.c_str(), size);
-
-        if (!xImages) {
-            Debug::log(WARN, "XCursor failed to find a shape with name {}, trying size 24.", shape);
-            xImages = XcursorShapeLoadImages(i << 1 /* wtf xcursor? */, name.c_str(), 24);
-
-            if (!xImages) {
-                Debug::log(WARN, "XCursor failed to find a shape with name {}, skipping", shape);
-                continue;
-            }
-        }
-
-        auto cursor = createCursor(shape, xImages);
-        newCursors.emplace_back(cursor);
-
-        if (!defaultCursor && (shape == "left_ptr" || shape == "arrow"))
-            defaultCursor = cursor;
-
-        XcursorImagesDestroy(xImages);
+        shapeIndex.emplace(XCURSOR_STANDARD_NAMES[i], SShapeSource{.standardIndex = (int)i});
     }
-
-    // broken theme.. just set it.
-    if (!newCursors.empty() && !defaultCursor)
-        defaultCursor = newCursors.front();
-
-    return newCursors;
 }
 
-std::vector<SP<SXCursors>> CXCursorManager::loadAllFromDir(std::string const& path, int size) {
-    std::vector<SP<SXCursors>> newCursors;
-
-    if (std::filesystem::exists(path) && std::filesystem::is_directory(path)) {
-        for (const auto& entry : std::filesystem::directory_iterator(path)) {
-            std::error_code e1, e2;
-            if ((!entry.is_regular_file(e1) && !entry.is_symlink(e2)) || e1 || e2) {
-                Debug::log(WARN, "XCursor failed to load shape {}: {}", entry.path().stem().string(), e1 ? e1.message() : e2.message());
-                continue;
-            }
-
-            auto const& full = entry.path().string();
-            using PcloseType = int (*)(FILE*);
-            const std::unique_ptr<FILE, PcloseType> f(fopen(full.c_str(), "r"), static_cast<PcloseType>(fclose));
-
-            if (!f)
-                continue;
-
-            auto xImages = XcursorFileLoadImages(f.get(), size);
-
-            if (!xImages) {
-                Debug::log(WARN, "XCursor failed to load image {}, trying size 24.", full);
-                xImages = XcursorFileLoadImages(f.get(), 24);
-
-                if (!xImages) {
-                    Debug::log(WARN, "XCursor failed to load image {}, skipping", full);
-                    continue;
-                }
-            }
-
-            auto const& shape  = entry.path().filename().string();
-            auto        cursor = createCursor(shape, xImages);
-            newCursors.emplace_back(cursor);
-
-            if (!defaultCursor && (shape == "left_ptr" || shape == "arrow"))
-                defaultCursor = cursor;
+void CXCursorManager::indexDir(std::string const& path) {
+    if (!std::filesystem::exists(path) || !std::filesystem::is_directory(path))
+        return;
 
-            XcursorImagesDestroy(xImages);
+    for (const auto& entry : std::filesystem::directory_iterator(path)) {
+        std::error_code e1, e2;
+        if ((!entry.is_regular_file(e1) && !entry.is_symlink(e2)) || e1 || e2) {
+            Debug::log(WARN, "XCursor failed to load shape {}: {}", entry.path().stem().string(), e1 ? e1.message() : e2.message());
+            continue;
         }
-    }
 
-    // broken theme.. just set it.
-    if (!newCursors.empty() && !defaultCursor)
-        defaultCursor = newCursors.front();
-
-    return newCursors;
+        // earlier theme dirs take precedence
+        shapeIndex.emplace(entry.path().filename().string(), SShapeSource{.path = entry.path().string()});
+    }
 }
 
 void CXCursorManager::syncGsettings() {
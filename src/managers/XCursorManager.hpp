@@ -4,6 +4,10 @@
 #include <set>
 #include <array>
 #include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <hyprutils/math/Vector2D.hpp>
 #include "helpers/memory/Memory.hpp"
 
@@ -23,23 +27,41 @@ struct SXCursors {
 class CXCursorManager {
   public:
     CXCursorManager();
-    ~CXCursorManager() = default;
+    ~CXCursorManager();
 
+    // only indexes the theme, shapes are decoded when first asked for (or preloaded in the background)
     void          loadTheme(const std::string& name, int size, float scale);
     SP<SXCursors> getShape(std::string const& shape, int size, float scale);
     void          syncGsettings();
 
   private:
-    SP<SXCursors>              createCursor(std::string const& shape, void* /* XcursorImages* */ xImages);
-    std::set<std::string>      themePaths(std::string const& theme);
-    std::string                getLegacyShapeName(std::string const& shape);
-    std::vector<SP<SXCursors>> loadStandardCursors(std::string const& name, int size);
-    std::vector<SP<SXCursors>> loadAllFromDir(std::string const& path, int size);
-
-    int                        lastLoadSize  = 0;
-    float                      lastLoadScale = 0;
-    std::string                themeName     = "";
-    SP<SXCursors>              defaultCursor;
-    SP<SXCursors>              hyprCursor;
-    std::vector<SP<SXCursors>> cursors;
+    // a file in one of the theme dirs, or an index into libXcursor's standard shapes
+    struct SShapeSource {
+        std::string path;
+        int         standardIndex = -1;
+    };
+
+    SP<SXCursors>                                 createCursor(std::string const& shape, void* /* XcursorImages* */ xImages);
+    std::set<std::string>                         themePaths(std::string const& theme);
+    std::string                                   getLegacyShapeName(std::string const& shape);
+    void                                          indexStandardCursors();
+    void                                          indexDir(std::string const& path);
+    SP<SXCursors>                                 loadShape(std::string const& shape, SShapeSource const& source, int size);
+    SP<SXCursors>                                 getOrLoad(std::string const& shape, int size);
+    void                                          startPreload(int size);
+    void                                          stopPreload();
+
+    int                                           lastLoadSize  = 0;
+    float                                         lastLoadScale = 0;
+    std::string                                   themeName     = "";
+    SP<SXCursors>                                 hyprCursor;
+
+    std::unordered_map<std::string, SShapeSource> shapeIndex; // only touched with the preload thread stopped
+
+    // loaded size -> shape -> cursor, shared with the preload thread
+    std::mutex                                                              cacheMutex;
+    std::unordered_map<int, std::unordered_map<std::string, SP<SXCursors>>> cache;
+
+    std::thread                                                             preloadThread;
+    std::atomic<bool>                                                       preloadAbort = false;
 };
@@ -16,6 +16,7 @@ using namespace Hyprutils::OS;
 #define TIMESPEC_NSEC_PER_SEC 1000000000L
 
 CEventLoopManager::CEventLoopManager(wl_display* display, wl_event_loop* wlEventLoop) {
+    m_sTimers.heap     = makeUnique<CTimerHeap>([this] { nudgeTimers(); });
     m_sTimers.timerfd  = CFileDescriptor{timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC)};
     m_sWayland.loop    = wlEventLoop;
     m_sWayland.display = display;
@@ -101,24 +102,27 @@ void CEventLoopManager::enterLoop() {
 }
 
 void CEventLoopManager::onTimerFire() {
-    for (auto const& t : m_sTimers.timers) {
-        if (t.strongRef() > 1 /* if it's 1, it was lost. Don't call it. */ && t->passed() && !t->cancelled())
-            t->call(t);
-    }
+    m_sTimers.heap->fire(Time::steadyNow());
 
     nudgeTimers();
 }
 
 void CEventLoopManager::addTimer(SP<CEventLoopTimer> timer) {
-    m_sTimers.timers.push_back(timer);
+    m_sTimers.heap->add(timer);
+
     nudgeTimers();
 }
 
 void CEventLoopManager::removeTimer(SP<CEventLoopTimer> timer) {
-    std::erase_if(m_sTimers.timers, [timer](const auto& t) { return timer == t; });
+    m_sTimers.heap->remove(timer);
+
     nudgeTimers();
 }
 
+void CEventLoopManager::setTimerSlack(Time::steady_dur slack) {
+    m_sTimers.heap->setSlack(slack);
+}
+
 static void timespecAddNs(timespec* pTimespec, int64_t delta) {
     auto delta_ns_low = delta % TIMESPEC_NSEC_PER_SEC;
     auto delta_s_high = delta / TIMESPEC_NSEC_PER_SEC;
@@ -133,15 +137,10 @@ static void timespecAddNs(timespec* pTimespec, int64_t delta) {
 }
 
 void CEventLoopManager::nudgeTimers() {
-    // remove timers that have gone missing
-    std::erase_if(m_sTimers.timers, [](const auto& t) { return t.strongRef() <= 1; });
-
     long nextTimerUs = 10L * 1000 * 1000; // 10s
 
-    for (auto const& t : m_sTimers.timers) {
-        if (auto const& µs = t->leftUs(); µs < nextTimerUs)
-            nextTimerUs = µs;
-    }
+    if (const auto NEXT = m_sTimers.heap->next(); NEXT)
+        nextTimerUs = std::min(nextTimerUs, (long)std::chrono::duration_cast<std::chrono::microseconds>(*NEXT - Time::steadyNow()).count());
 
     nextTimerUs = std::clamp(nextTimerUs + 1, 1L, std::numeric_limits<long>::max());
 
@@ -9,6 +9,7 @@
 #include <hyprutils/os/FileDescriptor.hpp>
 
 #include "EventLoopTimer.hpp"
+#include "TimerHeap.hpp"
 
 namespace Aquamarine {
     struct SPollFD;
@@ -27,9 +28,12 @@ class CEventLoopManager {
 
     void onTimerFire();
 
-    // recalculates timers
+    // re-arms the timerfd for the soonest timer
     void nudgeTimers();
 
+    // timers due within this of the soonest one are fired together with it
+    void setTimerSlack(Time::steady_dur slack);
+
     // schedules a function to run later, aka in a wayland idle event.
     void doLater(const std::function<void()>& fn);
 
@@ -65,8 +69,8 @@ class CEventLoopManager {
     } m_sWayland;
 
     struct {
-        std::vector<SP<CEventLoopTimer>> timers;
-        Hyprutils::OS::CFileDescriptor   timerfd;
+        UP<CTimerHeap>                 heap;
+        Hyprutils::OS::CFileDescriptor timerfd;
     } m_sTimers;
 
     SIdleData                        m_sIdle;
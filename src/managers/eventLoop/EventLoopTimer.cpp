@@ -1,6 +1,6 @@
 #include "EventLoopTimer.hpp"
 #include <limits>
-#include "EventLoopManager.hpp"
+#include "TimerHeap.hpp"
 #include "../../helpers/time/Time.hpp"
 
 CEventLoopTimer::CEventLoopTimer(std::optional<Time::steady_dur> timeout, std::function<void(SP<CEventLoopTimer> self, void* data)> cb_, void* data_) : m_cb(cb_), m_data(data_) {
@@ -12,15 +12,15 @@ CEventLoopTimer::CEventLoopTimer(std::optional<Time::steady_dur> timeout, std::f
 }
 
 void CEventLoopTimer::updateTimeout(std::optional<Time::steady_dur> timeout) {
-    if (!timeout.has_value()) {
-        m_expires.reset();
-        g_pEventLoopManager->nudgeTimers();
-        return;
-    }
+    m_generation++;
 
-    m_expires = Time::steadyNow() + *timeout;
+    if (!timeout.has_value())
+        m_expires.reset();
+    else
+        m_expires = Time::steadyNow() + *timeout;
 
-    g_pEventLoopManager->nudgeTimers();
+    if (m_heap)
+        m_heap->onTimerUpdated(this);
 }
 
 bool CEventLoopTimer::passed() {
@@ -32,6 +32,7 @@ bool CEventLoopTimer::passed() {
 void CEventLoopTimer::cancel() {
     m_wasCancelled = true;
     m_expires.reset();
+    m_generation++;
 }
 
 bool CEventLoopTimer::cancelled() {
@@ -40,6 +41,7 @@ bool CEventLoopTimer::cancelled() {
 
 void CEventLoopTimer::call(SP<CEventLoopTimer> self) {
     m_expires.reset();
+    m_generation++;
     m_cb(self, m_data);
 }
 
@@ -2,11 +2,14 @@
 
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <optional>
 
 #include "../../helpers/memory/Memory.hpp"
 #include "../../helpers/time/Time.hpp"
 
+class CTimerHeap;
+
 class CEventLoopTimer {
   public:
     CEventLoopTimer(std::optional<Time::steady_dur> timeout, std::function<void(SP<CEventLoopTimer> self, void* data)> cb_, void* data_);
@@ -30,4 +33,11 @@ class CEventLoopTimer {
     void*                                                     m_data = nullptr;
     std::optional<Time::steady_tp>                            m_expires;
     bool                                                      m_wasCancelled = false;
+
+    // bumped whenever m_expires changes, invalidates older entries in the heap
+    uint64_t    m_generation = 0;
+    size_t      m_index      = std::numeric_limits<size_t>::max(); // in the heap's timer list
+    CTimerHeap* m_heap       = nullptr;                            // the one we were added to, if any
+
+    friend class CTimerHeap;
 };
@@ -0,0 +1,137 @@
+#include "TimerHeap.hpp"
+#include "EventLoopTimer.hpp"
+
+#include <algorithm>
+#include <limits>
+
+CTimerHeap::CTimerHeap(std::function<void()> onChanged) : m_onChanged(std::move(onChanged)) {
+    ;
+}
+
+CTimerHeap::~CTimerHeap() {
+    for (auto const& t : m_vTimers) {
+        t->m_heap  = nullptr;
+        t->m_index = std::numeric_limits<size_t>::max();
+    }
+}
+
+bool CTimerHeap::entryValid(const SP<CEventLoopTimer>& timer, uint64_t generation) {
+    return timer && timer->m_generation == generation && timer->m_index < m_vTimers.size() && m_vTimers[timer->m_index] == timer;
+}
+
+void CTimerHeap::fire(Time::steady_tp now) {
+    const auto DEADLINE = now + m_slack;
+
+    // collect everything due first, callbacks may add, remove or re-arm timers
+    std::vector<std::pair<SP<CEventLoopTimer>, uint64_t>> due;
+
+    while (!m_vHeap.empty() && m_vHeap.front().expires <= DEADLINE) {
+        std::ranges::pop_heap(m_vHeap, std::greater<>{});
+        const auto ENTRY = std::move(m_vHeap.back());
+        m_vHeap.pop_back();
+
+        auto timer = ENTRY.timer.lock();
+
+        if (!entryValid(timer, ENTRY.generation))
+            continue;
+
+        // ours and the list's. If that's all, it was lost. Don't call it.
+        if (timer.strongRef() <= 2) {
+            removeAt(timer->m_index);
+            continue;
+        }
+
+        due.emplace_back(std::move(timer), ENTRY.generation);
+    }
+
+    for (auto const& [t, generation] : due) {
+        // an earlier callback might've re-armed or cancelled it
+        if (t->m_generation != generation || t->cancelled())
+            continue;
+
+        t->call(t);
+    }
+}
+
+std::optional<Time::steady_tp> CTimerHeap::next() {
+    // drop stale entries off the top, the rest is dropped when it gets there
+    while (!m_vHeap.empty() && !entryValid(m_vHeap.front().timer.lock(), m_vHeap.front().generation)) {
+        std::ranges::pop_heap(m_vHeap, std::greater<>{});
+        m_vHeap.pop_back();
+    }
+
+    if (m_vHeap.empty())
+        return std::nullopt;
+
+    return m_vHeap.front().expires;
+}
+
+void CTimerHeap::add(SP<CEventLoopTimer> timer) {
+    if (timer->m_index >= m_vTimers.size() || m_vTimers[timer->m_index] != timer) {
+        timer->m_index = m_vTimers.size();
+        timer->m_heap  = this;
+        m_vTimers.push_back(timer);
+    }
+
+    if (timer->armed())
+        push(timer);
+
+    if (m_vTimers.size() >= m_iSweepAt)
+        sweepLost();
+}
+
+void CTimerHeap::remove(SP<CEventLoopTimer> timer) {
+    if (timer->m_index < m_vTimers.size() && m_vTimers[timer->m_index] == timer)
+        removeAt(timer->m_index);
+}
+
+void CTimerHeap::onTimerUpdated(CEventLoopTimer* timer) {
+    if (timer->armed() && timer->m_index < m_vTimers.size() && m_vTimers[timer->m_index].get() == timer)
+        push(m_vTimers[timer->m_index]);
+
+    if (m_onChanged)
+        m_onChanged();
+}
+
+void CTimerHeap::setSlack(Time::steady_dur slack) {
+    m_slack = std::max(slack, Time::steady_dur{0});
+}
+
+size_t CTimerHeap::size() const {
+    return m_vTimers.size();
+}
+
+void CTimerHeap::push(const SP<CEventLoopTimer>& timer) {
+    // re-arming leaves the old entries behind, rebuild once they outnumber the live ones
+    if (m_vHeap.size() > m_vTimers.size() * 2 + 64) {
+        std::erase_if(m_vHeap, [this](const auto& e) { return !entryValid(e.timer.lock(), e.generation); });
+        std::ranges::make_heap(m_vHeap, std::greater<>{});
+    }
+
+    m_vHeap.emplace_back(SEntry{.expires = *timer->m_expires, .generation = timer->m_generation, .timer = timer});
+    std::ranges::push_heap(m_vHeap, std::greater<>{});
+}
+
+void CTimerHeap::removeAt(size_t idx) {
+    m_vTimers[idx]->m_index = std::numeric_limits<size_t>::max();
+    m_vTimers[idx]->m_heap  = nullptr;
+    m_vTimers[idx]->m_generation++;
+
+    if (idx != m_vTimers.size() - 1) {
+        m_vTimers[idx]          = std::move(m_vTimers.back());
+        m_vTimers[idx]->m_index = idx;
+    }
+
+    m_vTimers.pop_back();
+}
+
+void CTimerHeap::sweepLost() {
+    for (size_t i = 0; i < m_vTimers.size();) {
+        if (m_vTimers[i].strongRef() <= 1)
+            removeAt(i);
+        else
+            ++i;
+    }
+
+    m_iSweepAt = std::max<size_t>(64, m_vTimers.size() * 2);
+}
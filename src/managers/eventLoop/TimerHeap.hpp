@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "../../helpers/memory/Memory.hpp"
+#include "../../helpers/time/Time.hpp"
+
+class CEventLoopTimer;
+
+/*
+    The event loop's timers. Armed timers sit in a min-heap on their expiry. Re-arming pushes a new entry,
+    the old one no longer matches the timer's generation and is dropped whenever it surfaces.
+    A timer nobody but us holds anymore is lost, it's removed without being called.
+    Doesn't own the timerfd, callers pass the time in, so it can be driven headless.
+*/
+class CTimerHeap {
+  public:
+    // onChanged is called when a timer got a new timeout, i.e. the soonest expiry might have changed
+    CTimerHeap(std::function<void()> onChanged = nullptr);
+    ~CTimerHeap();
+
+    // Note: will remove the timer if the ptr is lost.
+    void                           add(SP<CEventLoopTimer> timer);
+    void                           remove(SP<CEventLoopTimer> timer);
+
+    // timer got a new timeout
+    void                           onTimerUpdated(CEventLoopTimer* timer);
+
+    // timers due within this of the soonest one are fired together with it
+    void                           setSlack(Time::steady_dur slack);
+
+    // calls every timer due by now + slack
+    void                           fire(Time::steady_tp now);
+
+    // expiry of the soonest armed timer
+    std::optional<Time::steady_tp> next();
+
+    // registered timers, armed or not, lost ones included until they're swept
+    size_t                         size() const;
+
+  private:
+    struct SEntry {
+        Time::steady_tp     expires;
+        uint64_t            generation = 0;
+        WP<CEventLoopTimer> timer;
+
+        bool                operator>(const SEntry& other) const {
+            return expires > other.expires;
+        }
+    };
+
+    void                             push(const SP<CEventLoopTimer>& timer);
+    void                             removeAt(size_t idx);
+    void                             sweepLost();
+    bool                             entryValid(const SP<CEventLoopTimer>& timer, uint64_t generation);
+
+    std::vector<SP<CEventLoopTimer>> m_vTimers;       // each timer knows its index, for O(1) removal
+    std::vector<SEntry>              m_vHeap;         // min-heap on expires, stale entries are dropped lazily
+    size_t                           m_iSweepAt = 64; // look for lost timers once we grow past this
+    Time::steady_dur                 m_slack    = {};
+    std::function<void()>            m_onChanged;
+};
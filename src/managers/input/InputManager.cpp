@@ -37,6 +37,7 @@
 #include "../../managers/LayoutManager.hpp"
 
 #include "../../helpers/time/Time.hpp"
+#include "../../debug/Trace.hpp"
 
 #include <aquamarine/input/Input.hpp>
 
@@ -91,6 +92,8 @@ CInputManager::~CInputManager() {
 }
 
 void CInputManager::onMouseMoved(IPointer::SMotionEvent e) {
+    TRACE_ZONE("mouseMoved", "input");
+
     static auto PNOACCEL = CConfigValue<Hyprlang::INT>("input:force_no_accel");
 
     Vector2D    delta   = e.delta;
@@ -201,7 +204,7 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus, bool mouse) {
     PHLWINDOW              pFoundWindow;
     PHLLS                  pFoundLayerSurface;
 
-    EMIT_HOOK_EVENT_CANCELLABLE("mouseMove", MOUSECOORDSFLOORED);
+    EMIT_TYPED_HOOK_EVENT_CANCELLABLE(HOOK_MOUSE_MOVE, MOUSECOORDSFLOORED);
 
     m_vLastCursorPosFloored = MOUSECOORDSFLOORED;
 
@@ -582,6 +585,8 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus, bool mouse) {
 }
 
 void CInputManager::onMouseButton(IPointer::SButtonEvent e) {
+    TRACE_ZONE("mouseButton", "input");
+
     EMIT_HOOK_EVENT_CANCELLABLE("mouseButton", e);
 
     if (e.mouse)
@@ -809,6 +814,8 @@ void CInputManager::processMouseDownKill(const IPointer::SButtonEvent& e) {
 }
 
 void CInputManager::onMouseWheel(IPointer::SAxisEvent e) {
+    TRACE_ZONE("mouseWheel", "input");
+
     static auto POFFWINDOWAXIS        = CConfigValue<Hyprlang::INT>("input:off_window_axis_events");
     static auto PINPUTSCROLLFACTOR    = CConfigValue<Hyprlang::FLOAT>("input:scroll_factor");
     static auto PTOUCHPADSCROLLFACTOR = CConfigValue<Hyprlang::FLOAT>("input:touchpad:scroll_factor");
@@ -818,8 +825,7 @@ void CInputManager::onMouseWheel(IPointer::SAxisEvent e) {
     const bool  ISTOUCHPADSCROLL = *PTOUCHPADSCROLLFACTOR <= 0.f || e.source == WL_POINTER_AXIS_SOURCE_FINGER;
     auto        factor           = ISTOUCHPADSCROLL ? *PTOUCHPADSCROLLFACTOR : *PINPUTSCROLLFACTOR;
 
-    const auto  EMAP = std::unordered_map<std::string, std::any>{{"event", e}};
-    EMIT_HOOK_EVENT_CANCELLABLE("mouseAxis", EMAP);
+    EMIT_HOOK_EVENT_CANCELLABLE("mouseAxis", (std::unordered_map<std::string, std::any>{{"event", e}}));
 
     if (e.mouse)
         recheckMouseWarpOnMouseInput();
@@ -1360,13 +1366,14 @@ void CInputManager::updateKeyboardsLeds(SP<IKeyboard> pKeyboard) {
 }
 
 void CInputManager::onKeyboardKey(std::any event, SP<IKeyboard> pKeyboard) {
+    TRACE_ZONE("keyboardKey", "input");
+
     if (!pKeyboard->enabled)
         return;
 
     const bool DISALLOWACTION = pKeyboard->isVirtual() && shouldIgnoreVirtualKeyboard(pKeyboard);
 
-    const auto EMAP = std::unordered_map<std::string, std::any>{{"keyboard", pKeyboard}, {"event", event}};
-    EMIT_HOOK_EVENT_CANCELLABLE("keyPress", EMAP);
+    EMIT_HOOK_EVENT_CANCELLABLE("keyPress", (std::unordered_map<std::string, std::any>{{"keyboard", pKeyboard}, {"event", event}}));
 
     bool passEvent = DISALLOWACTION || g_pKeybindManager->onKeyEvent(event, pKeyboard);
 
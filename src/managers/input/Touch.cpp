@@ -10,8 +10,11 @@
 #include "managers/AnimationManager.hpp"
 #include "../HookSystemManager.hpp"
 #include "debug/Log.hpp"
+#include "debug/Trace.hpp"
 
 void CInputManager::onTouchDown(ITouch::SDownEvent e) {
+    TRACE_ZONE("touchDown", "input");
+
     m_bLastInputTouch = true;
 
     static auto PSWIPETOUCH  = CConfigValue<Hyprlang::INT>("gestures:workspace_swipe_touch");
@@ -113,6 +116,8 @@ void CInputManager::onTouchUp(ITouch::SUpEvent e) {
 }
 
 void CInputManager::onTouchMove(ITouch::SMotionEvent e) {
+    TRACE_ZONE("touchMove", "input");
+
     m_bLastInputTouch = true;
 
     EMIT_HOOK_EVENT_CANCELLABLE("touchMove", e);
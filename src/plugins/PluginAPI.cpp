@@ -7,14 +7,8 @@
 #include "../managers/eventLoop/EventLoopManager.hpp"
 #include "../config/ConfigManager.hpp"
 #include "../debug/HyprNotificationOverlay.hpp"
+#include "SymbolIndex.hpp"
 #include <dlfcn.h>
-#include <filesystem>
-
-#if defined(__DragonFly__) || defined(__FreeBSD__) || defined(__NetBSD__)
-#include <sys/sysctl.h>
-#endif
-
-#include <sstream>
 
 APICALL const char* __hyprland_api_get_hash() {
     return GIT_COMMIT_HASH;
@@ -287,83 +281,22 @@ APICALL std::vector<SFunctionMatch> HyprlandAPI::findFunctionsByName(HANDLE hand
     if (!PLUGIN)
         return std::vector<SFunctionMatch>{};
 
-#if defined(KERN_PROC_PATHNAME)
-    int mib[] = {
-        CTL_KERN,
-#if defined(__NetBSD__)
-        KERN_PROC_ARGS,
-        -1,
-        KERN_PROC_PATHNAME,
-#else
-        KERN_PROC,
-        KERN_PROC_PATHNAME,
-        -1,
-#endif
-    };
-    u_int  miblen        = sizeof(mib) / sizeof(mib[0]);
-    char   exe[PATH_MAX] = "/nonexistent";
-    size_t sz            = sizeof(exe);
-    sysctl(mib, miblen, &exe, &sz, NULL, 0);
-    const auto FPATH = std::filesystem::canonical(exe);
-#elif defined(__OpenBSD__)
-    // Neither KERN_PROC_PATHNAME nor /proc are supported
-    const auto FPATH = std::filesystem::canonical("/usr/local/bin/Hyprland");
-#else
-    const auto FPATH = std::filesystem::canonical("/proc/self/exe");
-#endif
-
-#ifdef __clang__
-    static const auto SYMBOLS          = execAndGet(("llvm-nm -D -j \"" + FPATH.string() + "\"").c_str());
-    static const auto SYMBOLSDEMANGLED = execAndGet(("llvm-nm -D -j --demangle \"" + FPATH.string() + "\"").c_str());
-#else
-    static const auto SYMBOLS          = execAndGet(("nm -D -j \"" + FPATH.string() + "\"").c_str());
-    static const auto SYMBOLSDEMANGLED = execAndGet(("nm -D -j --demangle=auto \"" + FPATH.string() + "\"").c_str());
-#endif
-
-    auto demangledFromID = [&](size_t id) -> std::string {
-        size_t pos   = 0;
-        size_t count = 0;
-        while (count < id) {
-            pos++;
-            pos = SYMBOLSDEMANGLED.find('\n', pos);
-            if (pos == std::string::npos)
-                return "";
-            count++;
-        }
-
-        // Skip the newline char itself
-        if (pos != 0)
-            pos++;
-
-        return SYMBOLSDEMANGLED.substr(pos, SYMBOLSDEMANGLED.find('\n', pos) - pos);
-    };
+    const auto* const INDEX = g_pPluginSystem->getSymbolIndex();
 
-    if (SYMBOLS.empty()) {
-        Debug::log(ERR, R"(Unable to search for function "{}": no symbols found in binary (is "{}" in path?))", name,
-#ifdef __clang__
-                   "llvm-nm"
-#else
-                   "nm"
-#endif
-        );
+    if (!INDEX->good()) {
+        Debug::log(ERR, R"(Unable to search for function "{}": couldn't read the symbols of our own binary)", name);
         return {};
     }
 
     std::vector<SFunctionMatch> matches;
 
-    std::istringstream          inStream(SYMBOLS);
-    std::string                 line;
-    int                         lineNo = 0;
-    while (std::getline(inStream, line)) {
-        if (line.contains(name)) {
-            void* address = dlsym(nullptr, line.c_str());
+    for (const auto* sym : INDEX->findSubstring(name)) {
+        void* address = INDEX->resolve(*sym);
 
-            if (!address)
-                continue;
+        if (!address)
+            continue;
 
-            matches.push_back({address, line, demangledFromID(lineNo)});
-        }
-        lineNo++;
+        matches.push_back({address, sym->mangled, sym->demangled});
     }
 
     return matches;
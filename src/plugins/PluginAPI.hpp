@@ -280,7 +280,10 @@ namespace HyprlandAPI {
     /*
         Returns a vector of found functions matching the provided name.
 
-        These addresses will not change, and should be made static. Lookups are slow.
+        Matches are symbols whose mangled name contains the provided name, sorted by mangled name.
+
+        These addresses will not change, and should be made static. The first lookup reads
+        the symbol table of the binary, later ones are cheap.
 
         Empty means either none found or handle was invalid
     */
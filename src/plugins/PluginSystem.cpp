@@ -1,4 +1,5 @@
 #include "PluginSystem.hpp"
+#include "SymbolIndex.hpp"
 
 #include <dlfcn.h>
 #include <ranges>
@@ -11,6 +12,8 @@ CPluginSystem::CPluginSystem() {
     g_pFunctionHookSystem = makeUnique<CHookSystem>();
 }
 
+CPluginSystem::~CPluginSystem() = default;
+
 CPlugin* CPluginSystem::loadPlugin(const std::string& path) {
 
     m_szLastError = "";
@@ -204,6 +207,13 @@ size_t CPluginSystem::pluginCount() {
     return m_vLoadedPlugins.size();
 }
 
+const CSymbolIndex* CPluginSystem::getSymbolIndex() {
+    if (!m_pSymbolIndex)
+        m_pSymbolIndex = makeUnique<CSymbolIndex>();
+
+    return m_pSymbolIndex.get();
+}
+
 void CPluginSystem::sigGetPlugins(CPlugin** data, size_t len) {
     for (size_t i = 0; i < std::min(m_vLoadedPlugins.size(), len); i++) {
         data[i] = m_vLoadedPlugins[i].get();
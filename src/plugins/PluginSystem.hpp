@@ -5,6 +5,7 @@
 #include <csetjmp>
 
 class IHyprWindowDecoration;
+class CSymbolIndex;
 
 class CPlugin {
   public:
@@ -29,6 +30,7 @@ class CPlugin {
 class CPluginSystem {
   public:
     CPluginSystem();
+    ~CPluginSystem();
 
     CPlugin*                 loadPlugin(const std::string& path);
     void                     unloadPlugin(const CPlugin* plugin, bool eject = false);
@@ -39,12 +41,14 @@ class CPluginSystem {
     std::vector<CPlugin*>    getAllPlugins();
     size_t                   pluginCount();
     void                     sigGetPlugins(CPlugin** data, size_t len);
+    const CSymbolIndex*      getSymbolIndex(); // built on first use
 
     bool                     m_bAllowConfigVars = false;
     std::string              m_szLastError      = "";
 
   private:
     std::vector<UP<CPlugin>> m_vLoadedPlugins;
+    UP<CSymbolIndex>         m_pSymbolIndex;
 
     jmp_buf                  m_jbPluginFaultJumpBuf;
 };
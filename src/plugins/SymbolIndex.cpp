@@ -0,0 +1,239 @@
+#include "SymbolIndex.hpp"
+#include "../debug/Log.hpp"
+#include <algorithm>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <filesystem>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <hyprutils/os/FileDescriptor.hpp>
+
+#if defined(__DragonFly__) || defined(__FreeBSD__) || defined(__NetBSD__)
+#include <sys/sysctl.h>
+#endif
+
+using namespace Hyprutils::OS;
+
+std::string CSymbolIndex::binaryPath() {
+    try {
+#if defined(KERN_PROC_PATHNAME)
+        int mib[] = {
+            CTL_KERN,
+#if defined(__NetBSD__)
+            KERN_PROC_ARGS,
+            -1,
+            KERN_PROC_PATHNAME,
+#else
+            KERN_PROC,
+            KERN_PROC_PATHNAME,
+            -1,
+#endif
+        };
+        u_int  miblen        = sizeof(mib) / sizeof(mib[0]);
+        char   exe[PATH_MAX] = "/nonexistent";
+        size_t sz            = sizeof(exe);
+        sysctl(mib, miblen, &exe, &sz, NULL, 0);
+        return std::filesystem::canonical(exe).string();
+#elif defined(__OpenBSD__)
+        // Neither KERN_PROC_PATHNAME nor /proc are supported
+        return std::filesystem::canonical("/usr/local/bin/Hyprland").string();
+#else
+        return std::filesystem::canonical("/proc/self/exe").string();
+#endif
+    } catch (std::exception& e) { return ""; }
+}
+
+static uintptr_t mainObjectBase() {
+    uintptr_t base = 0;
+
+    // the first object is always the executable itself
+    dl_iterate_phdr(
+        [](dl_phdr_info* info, size_t size, void* data) -> int {
+            *(uintptr_t*)data = info->dlpi_addr;
+            return 1;
+        },
+        &base);
+
+    return base;
+}
+
+static std::string demangle(const char* mangled) {
+    int   status    = 0;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+
+    if (status != 0 || !demangled)
+        return mangled;
+
+    std::string result = demangled;
+    free(demangled);
+    return result;
+}
+
+CSymbolIndex::CSymbolIndex() {
+    const auto PATH = binaryPath();
+
+    if (PATH.empty()) {
+        Debug::log(ERR, "CSymbolIndex: couldn't find our own binary");
+        return;
+    }
+
+    m_bGood = parse(PATH);
+
+    if (m_bGood)
+        Debug::log(LOG, "CSymbolIndex: indexed {} dynamic symbols from {}", m_vSymbols.size(), PATH);
+}
+
+bool CSymbolIndex::parse(const std::string& path) {
+    CFileDescriptor fd{open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+
+    if (!fd.isValid()) {
+        Debug::log(ERR, "CSymbolIndex: couldn't open {}", path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd.get(), &st) < 0 || st.st_size < (off_t)sizeof(ElfW(Ehdr))) {
+        Debug::log(ERR, "CSymbolIndex: couldn't stat {}", path);
+        return false;
+    }
+
+    const size_t SIZE = st.st_size;
+    void*        map  = mmap(nullptr, SIZE, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+
+    if (map == MAP_FAILED) {
+        Debug::log(ERR, "CSymbolIndex: couldn't mmap {}", path);
+        return false;
+    }
+
+    const auto  DATA    = (const uint8_t*)map;
+    const auto  inRange = [SIZE](size_t off, size_t len) { return off <= SIZE && len <= SIZE - off; };
+    const auto* EHDR    = (const ElfW(Ehdr)*)DATA;
+    const auto  BASE    = mainObjectBase();
+
+    bool        ok = [&]() {
+        if (memcmp(EHDR->e_ident, ELFMAG, SELFMAG) != 0 || EHDR->e_ident[EI_CLASS] != (sizeof(void*) == 8 ? ELFCLASS64 : ELFCLASS32)) {
+            Debug::log(ERR, "CSymbolIndex: {} is not a native ELF", path);
+            return false;
+        }
+
+        if (EHDR->e_shentsize != sizeof(ElfW(Shdr)) || !inRange(EHDR->e_shoff, (size_t)EHDR->e_shnum * sizeof(ElfW(Shdr)))) {
+            Debug::log(ERR, "CSymbolIndex: {} has broken section headers", path);
+            return false;
+        }
+
+        const auto* SHDRS = (const ElfW(Shdr)*)(DATA + EHDR->e_shoff);
+
+        for (size_t i = 0; i < EHDR->e_shnum; ++i) {
+            const auto& SYMTAB = SHDRS[i];
+
+            if (SYMTAB.sh_type != SHT_DYNSYM || SYMTAB.sh_entsize != sizeof(ElfW(Sym)) || SYMTAB.sh_link >= EHDR->e_shnum)
+                continue;
+
+            const auto& STRTAB = SHDRS[SYMTAB.sh_link];
+
+            if (!inRange(SYMTAB.sh_offset, SYMTAB.sh_size) || !inRange(STRTAB.sh_offset, STRTAB.sh_size))
+                return false;
+
+            const auto* SYMS    = (const ElfW(Sym)*)(DATA + SYMTAB.sh_offset);
+            const auto* STRS    = (const char*)(DATA + STRTAB.sh_offset);
+            const auto  SYMSNUM = SYMTAB.sh_size / sizeof(ElfW(Sym));
+
+            m_vSymbols.reserve(SYMSNUM);
+
+            for (size_t j = 0; j < SYMSNUM; ++j) {
+                const auto& SYM = SYMS[j];
+
+                if (SYM.st_name == 0 || SYM.st_name >= STRTAB.sh_size)
+                    continue;
+
+                const char*  NAME    = STRS + SYM.st_name;
+                const size_t NAMELEN = strnlen(NAME, STRTAB.sh_size - SYM.st_name);
+
+                if (NAMELEN == 0 || NAMELEN == STRTAB.sh_size - SYM.st_name)
+                    continue;
+
+                const auto TYPE = ELF64_ST_TYPE(SYM.st_info);
+
+                // ifunc values are resolvers and TLS values offsets into each thread's block, neither is the symbol's address. Leave those to dlsym.
+                SSymbol sym;
+                sym.mangled   = std::string{NAME, NAMELEN};
+                sym.demangled = demangle(sym.mangled.c_str());
+                sym.dynamic   = SYM.st_shndx == SHN_UNDEF || SYM.st_value == 0 || TYPE == STT_GNU_IFUNC || TYPE == STT_TLS;
+                sym.address   = sym.dynamic ? nullptr : (void*)(BASE + SYM.st_value);
+
+                m_vSymbols.emplace_back(std::move(sym));
+            }
+        }
+
+        return true;
+    }();
+
+    munmap(map, SIZE);
+
+    if (!ok)
+        return false;
+
+    std::ranges::sort(m_vSymbols, [](const auto& a, const auto& b) { return a.mangled < b.mangled; });
+
+    m_vByDemangled.resize(m_vSymbols.size());
+    for (size_t i = 0; i < m_vSymbols.size(); ++i) {
+        m_vByDemangled[i] = i;
+    }
+    std::ranges::sort(m_vByDemangled, [this](size_t a, size_t b) { return m_vSymbols[a].demangled < m_vSymbols[b].demangled; });
+
+    return true;
+}
+
+bool CSymbolIndex::good() const {
+    return m_bGood;
+}
+
+size_t CSymbolIndex::size() const {
+    return m_vSymbols.size();
+}
+
+std::vector<const CSymbolIndex::SSymbol*> CSymbolIndex::findSubstring(std::string_view needle) const {
+    std::vector<const SSymbol*> result;
+
+    for (const auto& s : m_vSymbols) {
+        if (s.mangled.contains(needle))
+            result.emplace_back(&s);
+    }
+
+    return result;
+}
+
+std::vector<const CSymbolIndex::SSymbol*> CSymbolIndex::findPrefix(std::string_view prefix) const {
+    std::vector<const SSymbol*> result;
+
+    auto it = std::ranges::lower_bound(m_vSymbols, prefix, std::less<>{}, [](const SSymbol& s) -> std::string_view { return s.mangled; });
+
+    for (; it != m_vSymbols.end() && it->mangled.starts_with(prefix); ++it) {
+        result.emplace_back(&*it);
+    }
+
+    return result;
+}
+
+std::vector<const CSymbolIndex::SSymbol*> CSymbolIndex::findDemangled(std::string_view demangled) const {
+    std::vector<const SSymbol*> result;
+
+    auto it = std::ranges::lower_bound(m_vByDemangled, demangled, std::less<>{}, [this](size_t i) -> std::string_view { return m_vSymbols[i].demangled; });
+
+    for (; it != m_vByDemangled.end() && m_vSymbols[*it].demangled == demangled; ++it) {
+        result.emplace_back(&m_vSymbols[*it]);
+    }
+
+    return result;
+}
+
+void* CSymbolIndex::resolve(const SSymbol& sym) const {
+    if (!sym.dynamic)
+        return sym.address;
+
+    return dlsym(nullptr, sym.mangled.c_str());
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+    Index over the .dynsym table of our own binary, read straight from the ELF.
+    Used for plugins looking up functions by name: built once on first use, then shared.
+*/
+class CSymbolIndex {
+  public:
+    struct SSymbol {
+        std::string mangled;
+        std::string demangled;
+        void*       address = nullptr; // nullptr if it has to be resolved via dlsym, see resolve()
+        bool        dynamic = false;   // not defined here or an ifunc, needs dlsym
+    };
+
+    CSymbolIndex();
+
+    bool                        good() const;
+
+    // substring of the mangled name. Sorted by mangled name.
+    std::vector<const SSymbol*> findSubstring(std::string_view needle) const;
+    // prefix of the mangled name. Sorted by mangled name.
+    std::vector<const SSymbol*> findPrefix(std::string_view prefix) const;
+    // exact demangled name, e.g. "CCompositor::focusWindow(...)"
+    std::vector<const SSymbol*> findDemangled(std::string_view demangled) const;
+
+    // runtime address of a symbol
+    void*       resolve(const SSymbol& sym) const;
+
+    size_t      size() const;
+
+    static std::string binaryPath();
+
+  private:
+    bool                 parse(const std::string& path);
+
+    std::vector<SSymbol> m_vSymbols; // sorted by mangled
+    std::vector<size_t>  m_vByDemangled; // indices into m_vSymbols, sorted by demangled
+    bool                 m_bGood = false;
+};
@@ -2,7 +2,6 @@
 #include "../Compositor.hpp"
 #include "../managers/SeatManager.hpp"
 #include "../devices/IKeyboard.hpp"
-#include <sys/mman.h>
 #include "core/Compositor.hpp"
 #include <cstring>
 
@@ -33,22 +32,13 @@ void CInputMethodKeyboardGrabV2::sendKeyboardData(SP<IKeyboard> keyboard) {
 
     pLastKeyboard = keyboard;
 
-    auto keymapFD = allocateSHMFile(keyboard->xkbKeymapString.length() + 1);
-    if UNLIKELY (!keymapFD.isValid()) {
-        LOGM(ERR, "Failed to create a keymap file for keyboard grab");
+    if UNLIKELY (!keyboard->compiledKeymap || !keyboard->compiledKeymap->fd.isValid()) {
+        LOGM(ERR, "No keymap file for keyboard grab");
         return;
     }
 
-    void* data = mmap(nullptr, keyboard->xkbKeymapString.length() + 1, PROT_READ | PROT_WRITE, MAP_SHARED, keymapFD.get(), 0);
-    if UNLIKELY (data == MAP_FAILED) {
-        LOGM(ERR, "Failed to mmap a keymap file for keyboard grab");
-        return;
-    }
-
-    memcpy(data, keyboard->xkbKeymapString.c_str(), keyboard->xkbKeymapString.length());
-    munmap(data, keyboard->xkbKeymapString.length() + 1);
-
-    resource->sendKeymap(WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1, keymapFD.get(), keyboard->xkbKeymapString.length() + 1);
+    // sealed and read-only, fine to hand out the keyboard's own
+    resource->sendKeymap(WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1, keyboard->compiledKeymap->fd.get(), keyboard->compiledKeymap->string.length() + 1);
 
     sendMods(keyboard->modifiersState.depressed, keyboard->modifiersState.latched, keyboard->modifiersState.locked, keyboard->modifiersState.group);
 
@@ -195,7 +195,7 @@ void CScreencopyFrame::share() {
     if (bufferDMA)
         copyDmabuf(callback);
     else
-        callback(copyShm());
+        copyShm(callback);
 }
 
 void CScreencopyFrame::copyDmabuf(std::function<void(bool)> callback) {
@@ -246,23 +246,21 @@ void CScreencopyFrame::copyDmabuf(std::function<void(bool)> callback) {
     callback(true);
 }
 
-bool CScreencopyFrame::copyShm() {
+void CScreencopyFrame::copyShm(std::function<void(bool)> callback) {
     const auto PERM    = g_pDynamicPermissionManager->clientPermissionMode(resource->client(), PERMISSION_TYPE_SCREENCOPY);
     auto       TEXTURE = makeShared<CTexture>(pMonitor->output->state->state().buffer);
 
-    auto       shm                = buffer->shm();
-    auto [pixelData, fmt, bufLen] = buffer->beginDataPtr(0); // no need for end, cuz it's shm
-
-    CRegion fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
+    CRegion    fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
 
     g_pHyprRenderer->makeEGLCurrent();
 
-    CFramebuffer fb;
-    fb.alloc(box.w, box.h, pMonitor->output->state->state().drmFormat);
+    auto fb = g_pHyprOpenGL->m_pFramebufferPool->acquire({box.w, box.h}, pMonitor->output->state->state().drmFormat);
 
-    if (!g_pHyprRenderer->beginRender(pMonitor.lock(), fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &fb, true)) {
+    if (!g_pHyprRenderer->beginRender(pMonitor.lock(), fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, fb.get(), true)) {
         LOGM(ERR, "Can't copy: failed to begin rendering");
-        return false;
+        g_pHyprOpenGL->m_pFramebufferPool->recycle(fb);
+        callback(false);
+        return;
     }
 
     if (PERM == PERMISSION_RULE_ALLOW_MODE_ALLOW) {
@@ -281,45 +279,23 @@ bool CScreencopyFrame::copyShm() {
         g_pHyprOpenGL->renderTexture(g_pHyprOpenGL->m_pScreencopyDeniedTexture, texbox, 1);
     }
 
-#ifndef GLES2
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb.getFBID());
-#else
-    glBindFramebuffer(GL_FRAMEBUFFER, fb.getFBID());
-#endif
-
-    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(shm.format);
-    if (!PFORMAT) {
-        LOGM(ERR, "Can't copy: failed to find a pixel format");
-        g_pHyprRenderer->endRender();
-        return false;
-    }
-
-    auto glFormat = PFORMAT->flipRB ? GL_BGRA_EXT : GL_RGBA;
-
     g_pHyprOpenGL->m_RenderData.blockScreenShader = true;
     g_pHyprRenderer->endRender();
 
     g_pHyprRenderer->makeEGLCurrent();
-    g_pHyprOpenGL->m_RenderData.pMonitor = pMonitor;
-    fb.bind();
 
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-
-    const auto drmFmt     = NFormatUtils::getPixelFormatFromDRM(shm.format);
-    uint32_t   packStride = NFormatUtils::minStride(drmFmt, box.w);
-
-    // This could be optimized by using a pixel buffer object to make this async,
-    // but really clients should just use a dma buffer anyways.
-    if (packStride == (uint32_t)shm.stride) {
-        glReadPixels(0, 0, box.w, box.h, glFormat, PFORMAT->glType, pixelData);
-    } else {
-        for (size_t i = 0; i < box.h; ++i) {
-            uint32_t y = i;
-            glReadPixels(0, y, box.w, 1, glFormat, PFORMAT->glType, ((unsigned char*)pixelData) + i * shm.stride);
-        }
-    }
+#ifndef GLES2
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb->getFBID());
+#else
+    glBindFramebuffer(GL_FRAMEBUFFER, fb->getFBID());
+#endif
 
-    g_pHyprOpenGL->m_RenderData.pMonitor.reset();
+    // the read is queued into a pack buffer, and the frame only becomes ready once the gpu is done with it.
+    g_pHyprOpenGL->m_pShmReadback->readInto(buffer.buffer, {0, 0, box.w, box.h}, [callback](bool success) {
+        if (success)
+            LOGM(TRACE, "Copied frame via shm");
+        callback(success);
+    });
 
 #ifndef GLES2
     glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
@@ -327,9 +303,8 @@ bool CScreencopyFrame::copyShm() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 #endif
 
-    LOGM(TRACE, "Copied frame via shm");
-
-    return true;
+    // the readback doesn't need the fb past this point, the pending read is ordered before any later draw into it.
+    g_pHyprOpenGL->m_pFramebufferPool->recycle(fb);
 }
 
 bool CScreencopyFrame::good() {
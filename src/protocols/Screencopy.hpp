@@ -75,7 +75,7 @@ class CScreencopyFrame {
 
     void                       copy(CZwlrScreencopyFrameV1* pFrame, wl_resource* buffer);
     void                       copyDmabuf(std::function<void(bool)> callback);
-    bool                       copyShm();
+    void                       copyShm(std::function<void(bool)> callback);
     void                       share();
 
     friend class CScreencopyProtocol;
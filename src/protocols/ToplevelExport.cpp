@@ -205,34 +205,35 @@ void CToplevelExportFrame::share() {
     if (!buffer || !validMapped(pWindow))
         return;
 
-    if (bufferDMA) {
-        if (!copyDmabuf(Time::steadyNow())) {
-            resource->sendFailed();
+    auto callback = [this, weak = self](bool success) {
+        if (weak.expired())
             return;
-        }
-    } else {
-        if (!copyShm(Time::steadyNow())) {
+
+        if (!success) {
             resource->sendFailed();
             return;
         }
-    }
 
-    resource->sendFlags((hyprlandToplevelExportFrameV1Flags)0);
+        resource->sendFlags((hyprlandToplevelExportFrameV1Flags)0);
 
-    if (!m_ignoreDamage)
-        resource->sendDamage(0, 0, box.width, box.height);
+        if (!m_ignoreDamage)
+            resource->sendDamage(0, 0, box.width, box.height);
 
-    const auto [sec, nsec] = Time::secNsec(Time::steadyNow());
+        const auto [sec, nsec] = Time::secNsec(Time::steadyNow());
 
-    uint32_t tvSecHi = (sizeof(sec) > 4) ? sec >> 32 : 0;
-    uint32_t tvSecLo = sec & 0xFFFFFFFF;
-    resource->sendReady(tvSecHi, tvSecLo, nsec);
+        uint32_t tvSecHi = (sizeof(sec) > 4) ? sec >> 32 : 0;
+        uint32_t tvSecLo = sec & 0xFFFFFFFF;
+        resource->sendReady(tvSecHi, tvSecLo, nsec);
+    };
+
+    if (bufferDMA)
+        callback(copyDmabuf(Time::steadyNow()));
+    else
+        copyShm(Time::steadyNow(), callback);
 }
 
-bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
-    const auto PERM               = g_pDynamicPermissionManager->clientPermissionMode(resource->client(), PERMISSION_TYPE_SCREENCOPY);
-    auto       shm                = buffer->shm();
-    auto [pixelData, fmt, bufLen] = buffer->beginDataPtr(0); // no need for end, cuz it's shm
+void CToplevelExportFrame::copyShm(const Time::steady_tp& now, std::function<void(bool)> callback) {
+    const auto PERM = g_pDynamicPermissionManager->clientPermissionMode(resource->client(), PERMISSION_TYPE_SCREENCOPY);
 
     // render the client
     const auto PMONITOR = pWindow->m_pMonitor.lock();
@@ -240,8 +241,7 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
 
     g_pHyprRenderer->makeEGLCurrent();
 
-    CFramebuffer outFB;
-    outFB.alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, PMONITOR->output->state->state().drmFormat);
+    auto outFB = g_pHyprOpenGL->m_pFramebufferPool->acquire(PMONITOR->vecPixelSize, PMONITOR->output->state->state().drmFormat);
 
     auto overlayCursor = shouldOverlayCursor();
 
@@ -250,8 +250,11 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
         g_pPointerManager->damageCursor(PMONITOR->self.lock());
     }
 
-    if (!g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &outFB))
-        return false;
+    if (!g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, outFB.get())) {
+        g_pHyprOpenGL->m_pFramebufferPool->recycle(outFB);
+        callback(false);
+        return;
+    }
 
     g_pHyprOpenGL->clear(CHyprColor(0, 0, 0, 1.0));
 
@@ -269,27 +272,17 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
         g_pHyprOpenGL->renderTexture(g_pHyprOpenGL->m_pScreencopyDeniedTexture, texbox, 1);
     }
 
-    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(shm.format);
-    if (!PFORMAT) {
-        g_pHyprRenderer->endRender();
-        return false;
-    }
-
     g_pHyprOpenGL->m_RenderData.blockScreenShader = true;
     g_pHyprRenderer->endRender();
 
     g_pHyprRenderer->makeEGLCurrent();
-    g_pHyprOpenGL->m_RenderData.pMonitor = PMONITOR;
-    outFB.bind();
 
 #ifndef GLES2
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, outFB.getFBID());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, outFB->getFBID());
+#else
+    glBindFramebuffer(GL_FRAMEBUFFER, outFB->getFBID());
 #endif
 
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-
-    auto glFormat = PFORMAT->flipRB ? GL_BGRA_EXT : GL_RGBA;
-
     auto origin = Vector2D(0, 0);
     switch (PMONITOR->transform) {
         case WL_OUTPUT_TRANSFORM_FLIPPED_180:
@@ -311,20 +304,20 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
         default: break;
     }
 
-    glReadPixels(origin.x, origin.y, box.width, box.height, glFormat, PFORMAT->glType, pixelData);
+    g_pHyprOpenGL->m_pShmReadback->readInto(buffer.buffer, {origin, box.size()}, callback);
 
     if (overlayCursor) {
         g_pPointerManager->unlockSoftwareForMonitor(PMONITOR->self.lock());
         g_pPointerManager->damageCursor(PMONITOR->self.lock());
     }
 
-    outFB.unbind();
-
 #ifndef GLES2
     glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+#else
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 #endif
 
-    return true;
+    g_pHyprOpenGL->m_pFramebufferPool->recycle(outFB);
 }
 
 bool CToplevelExportFrame::copyDmabuf(const Time::steady_tp& now) {
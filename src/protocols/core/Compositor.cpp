@@ -8,6 +8,7 @@
 #include "../Viewporter.hpp"
 #include "../../helpers/Monitor.hpp"
 #include "../../helpers/sync/SyncReleaser.hpp"
+#include "../../debug/Trace.hpp"
 #include "../PresentationTime.hpp"
 #include "../DRMSyncobj.hpp"
 #include "../types/DMABuffer.hpp"
@@ -482,6 +483,8 @@ CBox CWLSurfaceResource::extends() {
 }
 
 void CWLSurfaceResource::commitState(SSurfaceState& state) {
+    TRACE_ZONE("commitState", "surface");
+
     auto lastTexture = current.texture;
     current.updateFrom(state);
 
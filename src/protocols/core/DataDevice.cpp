@@ -591,8 +591,7 @@ void CWLDataDeviceProtocol::initiateDrag(WP<CWLDataSourceResource> currentSource
         dropDrag();
     });
 
-    dnd.mouseMove = g_pHookSystem->hookDynamic("mouseMove", [this](void* self, SCallbackInfo& info, std::any e) {
-        auto V = std::any_cast<const Vector2D>(e);
+    dnd.mouseMove = g_pHookSystem->registerTyped<HOOK_MOUSE_MOVE>([this](SCallbackInfo& info, const Vector2D& V) {
         if (dnd.focusedDevice && g_pSeatManager->state.dndPointerFocus) {
             auto surf = CWLSurface::fromResource(g_pSeatManager->state.dndPointerFocus.lock());
 
@@ -17,6 +17,7 @@
 #include "../../helpers/math/Math.hpp"
 #include "../../helpers/time/Time.hpp"
 #include "../types/DataDevice.hpp"
+#include "../../managers/HookSystemManager.hpp"
 #include <hyprutils/os/FileDescriptor.hpp>
 
 class CWLDataDeviceResource;
@@ -178,10 +179,10 @@ class CWLDataDeviceProtocol : public IWaylandProtocol {
         CHyprSignalListener    dndSurfaceCommit;
 
         // for ending a dnd
-        SP<HOOK_CALLBACK_FN> mouseMove;
-        SP<HOOK_CALLBACK_FN> mouseButton;
-        SP<HOOK_CALLBACK_FN> touchUp;
-        SP<HOOK_CALLBACK_FN> touchMove;
+        SP<HOOK_TYPED_FN<HOOK_MOUSE_MOVE>> mouseMove;
+        SP<HOOK_CALLBACK_FN>               mouseButton;
+        SP<HOOK_CALLBACK_FN>               touchUp;
+        SP<HOOK_CALLBACK_FN>               touchMove;
     } dnd;
 
     void abortDrag();
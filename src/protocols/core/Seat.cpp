@@ -320,9 +320,11 @@ void CWLKeyboardResource::sendKeymap(SP<IKeyboard> keyboard) {
     if (!(PROTO::seat->currentCaps & eHIDCapabilityType::HID_INPUT_CAPABILITY_KEYBOARD))
         return;
 
-    std::string_view                keymap = keyboard->xkbKeymapString;
-    Hyprutils::OS::CFileDescriptor& fd     = keyboard->xkbKeymapFD;
-    uint32_t                        size   = keyboard->xkbKeymapString.length() + 1;
+    if (!keyboard->compiledKeymap)
+        return;
+
+    std::string_view keymap = keyboard->compiledKeymap->string;
+    uint32_t         size   = keyboard->compiledKeymap->string.length() + 1;
 
     if (keymap == lastKeymap)
         return;
@@ -331,7 +333,7 @@ void CWLKeyboardResource::sendKeymap(SP<IKeyboard> keyboard) {
 
     const wl_keyboard_keymap_format format = keyboard ? WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1 : WL_KEYBOARD_KEYMAP_FORMAT_NO_KEYMAP;
 
-    resource->sendKeymap(format, fd.get(), size);
+    resource->sendKeymap(format, keyboard->compiledKeymap->fd.get(), size);
 }
 
 void CWLKeyboardResource::sendEnter(SP<CWLSurfaceResource> surface) {
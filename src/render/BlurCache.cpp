@@ -0,0 +1,200 @@
+#include "BlurCache.hpp"
+#include "OpenGL.hpp"
+#include "Renderer.hpp"
+#include "../config/ConfigValue.hpp"
+#include "../helpers/Monitor.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+#include "../protocols/core/Compositor.hpp"
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+constexpr static auto BLUR_CACHE_IDLE_TIMEOUT = 10s;
+
+CBlurCache::CBlurCache() {
+    m_pTrimTimer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { trim(); }, nullptr);
+    g_pEventLoopManager->addTimer(m_pTrimTimer);
+}
+
+CBlurCache::~CBlurCache() {
+    if (g_pEventLoopManager)
+        g_pEventLoopManager->removeTimer(m_pTrimTimer);
+}
+
+void CBlurCache::onDamage(PHLMONITOR pMonitor, const CRegion& damage, SP<CWLSurfaceResource> pSource) {
+    if (m_lEntries.empty() || damage.empty())
+        return;
+
+    // a blurred pixel samples everything within the blur radius around it
+    const float RADIUS = g_pHyprRenderer->m_sRenderPass.oneBlurRadius();
+    CRegion     expanded;
+
+    for (auto& e : m_lEntries) {
+        if (e.monitor != pMonitor || e.valid.empty())
+            continue;
+
+        // a surface redrawing itself doesn't change what's behind it
+        if (pSource && e.surface == pSource)
+            continue;
+
+        if (CRegion{damage}.intersect(e.box.copy().expand(RADIUS)).empty())
+            continue;
+
+        if (expanded.empty())
+            expanded = CRegion{damage}.expand(RADIUS);
+
+        e.valid.subtract(expanded);
+    }
+}
+
+void CBlurCache::invalidate(PHLMONITOR pMonitor) {
+    for (auto& e : m_lEntries) {
+        if (e.monitor == pMonitor)
+            e.valid.clear();
+    }
+}
+
+SP<CFramebuffer> CBlurCache::get(SP<CWLSurfaceResource> pSurface, PHLMONITOR pMonitor, const CBox& box, float a, const CRegion& region) {
+    auto it = find(pSurface, pMonitor);
+    if (it == m_lEntries.end())
+        return nullptr;
+
+    if (it->box != box || it->a != a || it->monitorSize != pMonitor->vecPixelSize || it->transform != pMonitor->transform)
+        return nullptr;
+
+    if (!CRegion{region}.subtract(it->valid).empty())
+        return nullptr;
+
+    it->lastUsed = Time::steadyNow();
+    m_lEntries.splice(m_lEntries.begin(), m_lEntries, it);
+
+    return it->fb;
+}
+
+void CBlurCache::put(SP<CWLSurfaceResource> pSurface, PHLMONITOR pMonitor, const CBox& box, float a, const CRegion& region, CFramebuffer* blurred) {
+#ifdef GLES2
+    // no glBlitFramebuffer
+    return;
+#else
+    static auto PCACHESIZE = CConfigValue<Hyprlang::INT>("decoration:blur:cache_size");
+
+    if (*PCACHESIZE <= 0 || !blurred || !blurred->isAllocated() || region.empty())
+        return;
+
+    const auto BUFFERBOX = bufferBoxFor(pMonitor, box);
+    if (BUFFERBOX.empty())
+        return;
+
+    auto it = find(pSurface, pMonitor);
+
+    if (it != m_lEntries.end() && (it->box != box || it->a != a || it->monitorSize != pMonitor->vecPixelSize || it->transform != pMonitor->transform)) {
+        erase(it);
+        it = m_lEntries.end();
+    }
+
+    if (it == m_lEntries.end()) {
+        m_lEntries.emplace_front(SEntry{
+            .surface     = pSurface,
+            .monitor     = pMonitor,
+            .box         = box,
+            .monitorSize = pMonitor->vecPixelSize,
+            .transform   = pMonitor->transform,
+            .a           = a,
+            .fb          = g_pHyprOpenGL->m_pFramebufferPool->acquire(BUFFERBOX.size(), pMonitor->output->state->state().drmFormat),
+        });
+        it = m_lEntries.begin();
+        m_iBytes += it->fb->bytes();
+    } else
+        m_lEntries.splice(m_lEntries.begin(), m_lEntries, it);
+
+    it->lastUsed = Time::steadyNow();
+
+    // the blur is only correct inside region, copy just that
+    CRegion bufferRegion{region};
+    bufferRegion.transform(wlTransformToHyprutils(invertTransform(pMonitor->transform)), pMonitor->vecTransformedSize.x, pMonitor->vecTransformedSize.y);
+    bufferRegion.intersect(BUFFERBOX);
+
+    GLint readBefore = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readBefore);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, blurred->getFBID());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, it->fb->getFBID());
+    glDisable(GL_SCISSOR_TEST);
+
+    for (auto const& RECT : bufferRegion.getRects()) {
+        glBlitFramebuffer(RECT.x1, RECT.y1, RECT.x2, RECT.y2, RECT.x1 - BUFFERBOX.x, RECT.y1 - BUFFERBOX.y, RECT.x2 - BUFFERBOX.x, RECT.y2 - BUFFERBOX.y, GL_COLOR_BUFFER_BIT,
+                          GL_NEAREST);
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, readBefore);
+
+    it->valid.add(region);
+
+    evict();
+
+    if (!m_pTrimTimer->armed())
+        m_pTrimTimer->updateTimeout(BLUR_CACHE_IDLE_TIMEOUT);
+#endif
+}
+
+CBox CBlurCache::bufferBoxFor(PHLMONITOR pMonitor, const CBox& box) {
+    // whole pixels, and a pixel of slack for linear sampling at the edges
+    CBox cropped = box.copy().expand(1).round().intersection(CBox{0, 0, pMonitor->vecTransformedSize.x, pMonitor->vecTransformedSize.y});
+    return cropped.transform(wlTransformToHyprutils(invertTransform(pMonitor->transform)), pMonitor->vecTransformedSize.x, pMonitor->vecTransformedSize.y);
+}
+
+size_t CBlurCache::size() const {
+    return m_lEntries.size();
+}
+
+size_t CBlurCache::bytes() const {
+    return m_iBytes;
+}
+
+std::list<CBlurCache::SEntry>::iterator CBlurCache::find(SP<CWLSurfaceResource> pSurface, PHLMONITOR pMonitor) {
+    return std::ranges::find_if(m_lEntries, [&](const auto& e) { return e.surface == pSurface && e.monitor == pMonitor; });
+}
+
+void CBlurCache::erase(std::list<SEntry>::iterator it) {
+    m_iBytes -= it->fb ? it->fb->bytes() : 0;
+    g_pHyprOpenGL->m_pFramebufferPool->recycle(it->fb);
+    m_lEntries.erase(it);
+}
+
+void CBlurCache::evict() {
+    static auto  PCACHESIZE = CConfigValue<Hyprlang::INT>("decoration:blur:cache_size");
+    const size_t MAXBYTES   = std::max(*PCACHESIZE, (Hyprlang::INT)0) * 1024 * 1024;
+
+    // unlike the text cache, an entry bigger than the whole budget isn't worth keeping
+    while (!m_lEntries.empty() && m_iBytes > MAXBYTES) {
+        erase(std::prev(m_lEntries.end()));
+    }
+}
+
+void CBlurCache::trim() {
+    const auto NOW = Time::steadyNow();
+
+    const auto stale = [&](const SEntry& e) { return e.surface.expired() || e.monitor.expired() || NOW - e.lastUsed >= BLUR_CACHE_IDLE_TIMEOUT; };
+
+    if (!m_lEntries.empty())
+        g_pHyprRenderer->makeEGLCurrent();
+
+    for (auto it = m_lEntries.begin(); it != m_lEntries.end();) {
+        auto next = std::next(it);
+        if (stale(*it))
+            erase(it);
+        it = next;
+    }
+
+    // also picks up a smaller cache_size after a reload
+    evict();
+
+    if (m_lEntries.empty()) {
+        m_pTrimTimer->updateTimeout(std::nullopt);
+        return;
+    }
+
+    const auto OLDEST = std::ranges::min_element(m_lEntries, {}, &SEntry::lastUsed)->lastUsed;
+    m_pTrimTimer->updateTimeout(std::max(std::chrono::duration_cast<std::chrono::steady_clock::duration>(1s), BLUR_CACHE_IDLE_TIMEOUT - (NOW - OLDEST)));
+}
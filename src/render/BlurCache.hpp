@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/math/Math.hpp"
+#include "../helpers/time/Time.hpp"
+#include "Framebuffer.hpp"
+#include <list>
+
+class CEventLoopTimer;
+class CWLSurfaceResource;
+
+/*
+    Keeps the blurred background behind blurred surfaces that can't use the monitor's blurFB
+    (floating windows, layers without xray). Each entry is a crop of the blur around one surface
+    on one monitor, and the part of it that is still valid. Damage from anything but the surface itself that lands
+    within the blur radius of an entry invalidates that part, so a surface redrawing itself over
+    a static background doesn't re-run the blur passes.
+    GPU memory is capped by decoration:blur:cache_size, least recently used entries go first.
+*/
+class CBlurCache {
+  public:
+    CBlurCache();
+    ~CBlurCache();
+
+    // in monitor pixels. pSource is the surface that committed it, null for anything else.
+    void             onDamage(PHLMONITOR pMonitor, const CRegion& damage, SP<CWLSurfaceResource> pSource = nullptr);
+    void             invalidate(PHLMONITOR pMonitor);
+
+    // the cached blur for pSurface at box (monitor pixels) if it's valid over all of region, null otherwise
+    SP<CFramebuffer> get(SP<CWLSurfaceResource> pSurface, PHLMONITOR pMonitor, const CBox& box, float a, const CRegion& region);
+    // copies region out of a freshly blurred full monitor fb. Requires the EGL context to be current.
+    void             put(SP<CWLSurfaceResource> pSurface, PHLMONITOR pMonitor, const CBox& box, float a, const CRegion& region, CFramebuffer* blurred);
+
+    // the part of the monitor fb an entry for box holds, in buffer pixels
+    static CBox      bufferBoxFor(PHLMONITOR pMonitor, const CBox& box);
+
+    size_t           size() const;
+    size_t           bytes() const;
+
+  private:
+    struct SEntry {
+        WP<CWLSurfaceResource> surface;
+        PHLMONITORREF          monitor;
+        CBox                   box;
+        Vector2D               monitorSize;
+        wl_output_transform    transform = WL_OUTPUT_TRANSFORM_NORMAL;
+        float                  a         = 1.F;
+        SP<CFramebuffer>       fb;
+        CRegion                valid; // monitor pixels
+        Time::steady_tp        lastUsed;
+    };
+
+    std::list<SEntry>::iterator find(SP<CWLSurfaceResource> pSurface, PHLMONITOR pMonitor);
+    void                        erase(std::list<SEntry>::iterator it);
+    void                        evict();
+    void                        trim();
+
+    std::list<SEntry>           m_lEntries; // most recently used first
+    size_t                      m_iBytes = 0;
+    SP<CEventLoopTimer>         m_pTrimTimer;
+};
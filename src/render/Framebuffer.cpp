@@ -53,7 +53,8 @@ bool CFramebuffer::alloc(int w, int h, uint32_t drmFormat) {
     glBindTexture(GL_TEXTURE_2D, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    m_vSize = Vector2D(w, h);
+    m_vSize      = Vector2D(w, h);
+    m_iDrmFormat = drmFormat;
 
     return true;
 }
@@ -131,6 +132,23 @@ GLuint CFramebuffer::getFBID() {
     return m_iFbAllocated ? m_iFb : 0;
 }
 
+size_t CFramebuffer::bytes() {
+    if (!isAllocated())
+        return 0;
+
+    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(m_iDrmFormat);
+    return (size_t)m_vSize.x * m_vSize.y * (PFORMAT ? PFORMAT->bytesPerBlock : 4);
+}
+
 SP<CTexture> CFramebuffer::getStencilTex() {
     return m_pStencilTex;
 }
+
+void CFramebuffer::swap(CFramebuffer& other) {
+    std::swap(m_cTex, other.m_cTex);
+    std::swap(m_iFb, other.m_iFb);
+    std::swap(m_iFbAllocated, other.m_iFbAllocated);
+    std::swap(m_pStencilTex, other.m_pStencilTex);
+    std::swap(m_vSize, other.m_vSize);
+    std::swap(m_iDrmFormat, other.m_iDrmFormat);
+}
@@ -18,8 +18,11 @@ class CFramebuffer {
     SP<CTexture> getTexture();
     SP<CTexture> getStencilTex();
     GLuint       getFBID();
+    size_t       bytes(); // color attachment only, the stencil is shared
+    void         swap(CFramebuffer& other);
 
     Vector2D     m_vSize;
+    uint32_t     m_iDrmFormat = 0;
 
   private:
     SP<CTexture> m_cTex;
@@ -0,0 +1,82 @@
+#include "FramebufferPool.hpp"
+#include "Renderer.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+constexpr static auto FB_POOL_IDLE_TIMEOUT = 5s;
+
+CFramebufferPool::CFramebufferPool() {
+    m_pTrimTimer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { trim(); }, nullptr);
+    g_pEventLoopManager->addTimer(m_pTrimTimer);
+}
+
+CFramebufferPool::~CFramebufferPool() {
+    if (g_pEventLoopManager)
+        g_pEventLoopManager->removeTimer(m_pTrimTimer);
+}
+
+SP<CFramebuffer> CFramebufferPool::acquire(const Vector2D& size, uint32_t drmFormat) {
+    auto it = std::ranges::find_if(m_vFree, [&](const auto& e) { return e.fb->m_vSize == size && e.fb->m_iDrmFormat == drmFormat; });
+
+    if (it != m_vFree.end()) {
+        auto fb = it->fb;
+        m_vFree.erase(it);
+        return fb;
+    }
+
+    auto fb = makeShared<CFramebuffer>();
+    fb->alloc(size.x, size.y, drmFormat);
+    return fb;
+}
+
+void CFramebufferPool::recycle(SP<CFramebuffer> fb) {
+    if (!fb || !fb->isAllocated())
+        return;
+
+    // oldest first, the oldest one goes if we're full
+    if (m_vFree.size() >= MAX_POOLED)
+        m_vFree.erase(m_vFree.begin());
+
+    m_vFree.emplace_back(SPooledFramebuffer{.fb = fb, .lastUsed = Time::steadyNow()});
+
+    if (!m_pTrimTimer->armed())
+        m_pTrimTimer->updateTimeout(FB_POOL_IDLE_TIMEOUT);
+}
+
+void CFramebufferPool::clear() {
+    if (m_vFree.empty())
+        return;
+
+    g_pHyprRenderer->makeEGLCurrent();
+    m_vFree.clear();
+    m_pTrimTimer->updateTimeout(std::nullopt);
+}
+
+size_t CFramebufferPool::size() const {
+    return m_vFree.size();
+}
+
+size_t CFramebufferPool::bytes() const {
+    size_t total = 0;
+    for (auto const& e : m_vFree) {
+        total += e.fb->bytes();
+    }
+    return total;
+}
+
+void CFramebufferPool::trim() {
+    const auto NOW = Time::steadyNow();
+
+    if (std::ranges::any_of(m_vFree, [&](const auto& e) { return NOW - e.lastUsed >= FB_POOL_IDLE_TIMEOUT; })) {
+        g_pHyprRenderer->makeEGLCurrent();
+        std::erase_if(m_vFree, [&](const auto& e) { return NOW - e.lastUsed >= FB_POOL_IDLE_TIMEOUT; });
+    }
+
+    if (!m_vFree.empty())
+        m_pTrimTimer->updateTimeout(FB_POOL_IDLE_TIMEOUT - (NOW - m_vFree.front().lastUsed));
+    else
+        m_pTrimTimer->updateTimeout(std::nullopt);
+}
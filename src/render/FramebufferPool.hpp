@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/time/Time.hpp"
+#include "Framebuffer.hpp"
+#include <vector>
+
+class CEventLoopTimer;
+
+/*
+    A small pool of offscreen framebuffers, keyed by size and drm format.
+    Used for transient renders (e.g. shm screencopy, effect buffers) that would
+    otherwise allocate and free a full-size texture every frame.
+    Idle framebuffers are freed after a while.
+*/
+class CFramebufferPool {
+  public:
+    CFramebufferPool();
+    ~CFramebufferPool();
+
+    // requires the EGL context to be current
+    SP<CFramebuffer> acquire(const Vector2D& size, uint32_t drmFormat);
+    void             recycle(SP<CFramebuffer> fb);
+    void             clear();
+
+    size_t           size() const;
+    size_t           bytes() const;
+
+  private:
+    struct SPooledFramebuffer {
+        SP<CFramebuffer> fb;
+        Time::steady_tp  lastUsed;
+    };
+
+    void                            trim();
+
+    std::vector<SPooledFramebuffer> m_vFree;
+    SP<CEventLoopTimer>             m_pTrimTimer;
+
+    constexpr static size_t         MAX_POOLED = 16;
+};
@@ -16,6 +16,7 @@
 #include "../managers/HookSystemManager.hpp"
 #include "../managers/input/InputManager.hpp"
 #include "../helpers/fs/FsUtils.hpp"
+#include "../debug/Trace.hpp"
 #include "debug/HyprNotificationOverlay.hpp"
 #include "hyprerror/HyprError.hpp"
 #include "pass/TexPassElement.hpp"
@@ -345,6 +346,25 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_iDRMFD(g_pCompositor->m_drmFD) {
 
     RASSERT(m_szExtensions.contains("GL_EXT_texture_format_BGRA8888"), "GL_EXT_texture_format_BGRA8888 support by the GPU driver is required");
 
+    m_sExts.EXT_disjoint_timer_query = m_szExtensions.contains("GL_EXT_disjoint_timer_query");
+
+    if (m_sExts.EXT_disjoint_timer_query) {
+        loadGLProc(&m_sProc.glGenQueriesEXT, "glGenQueriesEXT");
+        loadGLProc(&m_sProc.glDeleteQueriesEXT, "glDeleteQueriesEXT");
+        loadGLProc(&m_sProc.glQueryCounterEXT, "glQueryCounterEXT");
+        loadGLProc(&m_sProc.glGetQueryivEXT, "glGetQueryivEXT");
+        loadGLProc(&m_sProc.glGetQueryObjectuivEXT, "glGetQueryObjectuivEXT");
+        loadGLProc(&m_sProc.glGetQueryObjectui64vEXT, "glGetQueryObjectui64vEXT");
+
+        // the extension allows timestamps to be unsupported, only elapsed time. We need them to place frames on the timeline.
+        GLint bits = 0;
+        m_sProc.glGetQueryivEXT(GL_TIMESTAMP_EXT, GL_QUERY_COUNTER_BITS_EXT, &bits);
+        m_sExts.EXT_disjoint_timer_query = bits > 0;
+    }
+
+    if (!m_sExts.EXT_disjoint_timer_query)
+        Debug::log(LOG, "GL_EXT_disjoint_timer_query timestamps not supported, traces won't have GPU timings");
+
     if (!m_sExts.EXT_read_format_bgra)
         Debug::log(WARN, "Your GPU does not support GL_EXT_read_format_bgra, this may cause issues with texture importing");
     if (!m_sExts.EXT_image_dma_buf_import || !m_sExts.EXT_image_dma_buf_import_modifiers)
@@ -368,7 +388,13 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_iDRMFD(g_pCompositor->m_drmFD) {
 
     initAssets();
 
-    static auto P = g_pHookSystem->hookDynamic("preRender", [&](void* self, SCallbackInfo& info, std::any data) { preRender(std::any_cast<PHLMONITOR>(data)); });
+    m_pFramebufferPool = makeUnique<CFramebufferPool>();
+    m_pBlurCache       = makeUnique<CBlurCache>();
+    m_pShmReadback     = makeUnique<CShmReadback>();
+    m_pTextCache       = makeUnique<CTextCache>();
+    m_pProgramCache    = makeUnique<CProgramBinaryCache>();
+
+    static auto P = g_pHookSystem->registerTyped<HOOK_PRE_RENDER>([&](SCallbackInfo& info, const PHLMONITOR& pMonitor) { preRender(pMonitor); });
 
     RASSERT(eglMakeCurrent(m_pEglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT), "Couldn't unset current EGL!");
 
@@ -376,6 +402,19 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_iDRMFD(g_pCompositor->m_drmFD) {
 }
 
 CHyprOpenGLImpl::~CHyprOpenGLImpl() {
+    m_pTextCache.reset();
+    m_pShmReadback.reset();
+    m_pBlurCache.reset();
+    m_pFramebufferPool.reset();
+
+    for (auto const& q : m_vGPUTracePending) {
+        m_vGPUTraceFreeQueries.emplace_back(q.begin);
+        m_vGPUTraceFreeQueries.emplace_back(q.end);
+    }
+
+    if (!m_vGPUTraceFreeQueries.empty())
+        m_sProc.glDeleteQueriesEXT(m_vGPUTraceFreeQueries.size(), m_vGPUTraceFreeQueries.data());
+
     if (m_pEglDisplay && m_pEglContext != EGL_NO_CONTEXT)
         eglDestroyContext(m_pEglDisplay, m_pEglContext);
 
@@ -599,6 +638,11 @@ void CHyprOpenGLImpl::logShaderError(const GLuint& shader, bool program, bool si
 }
 
 GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string& frag, bool dynamic, bool silent) {
+    if (m_pProgramCache) {
+        if (const auto CACHED = m_pProgramCache->load(vert, frag); CACHED)
+            return CACHED;
+    }
+
     auto vertCompiled = compileShader(GL_VERTEX_SHADER, vert, dynamic, silent);
     if (dynamic) {
         if (vertCompiled == 0)
@@ -616,6 +660,10 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
     auto prog = glCreateProgram();
     glAttachShader(prog, vertCompiled);
     glAttachShader(prog, fragCompiled);
+
+    if (m_pProgramCache)
+        m_pProgramCache->prepare(prog);
+
     glLinkProgram(prog);
 
     glDetachShader(prog, vertCompiled);
@@ -636,6 +684,9 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
         RASSERT(ok != GL_FALSE, "createProgram() failed! GL_LINK_STATUS not OK!");
     }
 
+    if (m_pProgramCache)
+        m_pProgramCache->store(prog, vert, frag);
+
     return prog;
 }
 
@@ -736,6 +787,8 @@ void CHyprOpenGLImpl::begin(PHLMONITOR pMonitor, const CRegion& damage_, CFrameb
 
     TRACY_GPU_ZONE("RenderBegin");
 
+    beginGPUTrace();
+
     glViewport(0, 0, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
 
     m_RenderData.projection = Mat3x3::outputProjection(pMonitor->vecPixelSize, HYPRUTILS_TRANSFORM_NORMAL);
@@ -755,17 +808,20 @@ void CHyprOpenGLImpl::begin(PHLMONITOR pMonitor, const CRegion& damage_, CFrameb
         m_RenderData.pCurrentMonData->stencilTex->allocate();
 
         m_RenderData.pCurrentMonData->offloadFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y, pMonitor->output->state->state().drmFormat);
-        m_RenderData.pCurrentMonData->mirrorFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y, pMonitor->output->state->state().drmFormat);
-        m_RenderData.pCurrentMonData->mirrorSwapFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y, pMonitor->output->state->state().drmFormat);
-
         m_RenderData.pCurrentMonData->offloadFB.addStencil(m_RenderData.pCurrentMonData->stencilTex);
-        m_RenderData.pCurrentMonData->mirrorFB.addStencil(m_RenderData.pCurrentMonData->stencilTex);
-        m_RenderData.pCurrentMonData->mirrorSwapFB.addStencil(m_RenderData.pCurrentMonData->stencilTex);
     }
 
     if (m_RenderData.pCurrentMonData->monitorMirrorFB.isAllocated() && m_RenderData.pMonitor->mirrors.empty())
         m_RenderData.pCurrentMonData->monitorMirrorFB.release();
 
+    // no point in keeping a full-size blur cache around if nothing is going to sample it
+    static auto PBLUR            = CConfigValue<Hyprlang::INT>("decoration:blur:enabled");
+    static auto PBLURNEWOPTIMIZE = CConfigValue<Hyprlang::INT>("decoration:blur:new_optimizations");
+    if (m_RenderData.pCurrentMonData->blurFB.isAllocated() && (!*PBLUR || !*PBLURNEWOPTIMIZE)) {
+        m_RenderData.pCurrentMonData->blurFB.release();
+        m_RenderData.pCurrentMonData->blurFBDirty = true;
+    }
+
     m_RenderData.damage.set(damage_);
     m_RenderData.finalDamage.set(finalDamage.value_or(damage_));
 
@@ -826,6 +882,13 @@ void CHyprOpenGLImpl::end() {
         m_RenderData.outFB->bind();
         blend(false);
 
+        if (m_RenderData.outFBOffset != Vector2D{}) {
+            // outFB only holds a crop of the monitor, shift it under the full-size copy.
+            // scissors don't care about the viewport, so damage everything, the fb bounds clip the rest.
+            glViewport(-m_RenderData.outFBOffset.x, -m_RenderData.outFBOffset.y, m_RenderData.pMonitor->vecPixelSize.x, m_RenderData.pMonitor->vecPixelSize.y);
+            m_RenderData.damage = CBox{0, 0, m_RenderData.pMonitor->vecTransformedSize.x, m_RenderData.pMonitor->vecTransformedSize.y};
+        }
+
         if (m_sFinalScreenShader.program < 1 && !g_pHyprRenderer->m_bCrashingInProgress)
             renderTexturePrimitive(m_RenderData.pCurrentMonData->offloadFB.getTexture(), monbox);
         else
@@ -846,12 +909,19 @@ void CHyprOpenGLImpl::end() {
     m_RenderData.currentFB         = nullptr;
     m_RenderData.mainFB            = nullptr;
     m_RenderData.outFB             = nullptr;
+    m_RenderData.outFBOffset       = {};
 
-    // if we dropped to offMain, release it now.
-    // if there is a plugin constantly using it, this might be a bit slow,
-    // but I havent seen a single plugin yet use these, so it's better to drop a bit of vram.
-    if (m_RenderData.pCurrentMonData->offMainFB.isAllocated())
-        m_RenderData.pCurrentMonData->offMainFB.release();
+    endGPUTrace();
+
+    // hand the effect buffers back, the pool will free them if they stay unused for a while
+    for (auto fb : {&m_RenderData.pCurrentMonData->mirrorFB, &m_RenderData.pCurrentMonData->mirrorSwapFB, &m_RenderData.pCurrentMonData->offMainFB}) {
+        if (!fb->isAllocated())
+            continue;
+
+        auto pooled = makeShared<CFramebuffer>();
+        pooled->swap(*fb);
+        m_pFramebufferPool->recycle(pooled);
+    }
 
     // check for gl errors
     const GLenum ERR = glGetError();
@@ -864,6 +934,85 @@ void CHyprOpenGLImpl::end() {
         RASSERT(false, "glGetError at Opengl::end() returned GL_CONTEXT_LOST. Cannot continue until proper GPU reset handling is implemented.");
 }
 
+void CHyprOpenGLImpl::beginGPUTrace() {
+    if (!m_sExts.EXT_disjoint_timer_query)
+        return;
+
+    collectGPUTraces();
+
+    // if the driver never resolves them don't pile up more
+    if (!Trace::enabled() || m_bGPUTraceActive || m_vGPUTracePending.size() >= 16)
+        return;
+
+    const auto takeQuery = [this]() {
+        GLuint query = 0;
+        if (!m_vGPUTraceFreeQueries.empty()) {
+            query = m_vGPUTraceFreeQueries.back();
+            m_vGPUTraceFreeQueries.pop_back();
+        } else
+            m_sProc.glGenQueriesEXT(1, &query);
+        return query;
+    };
+
+    if (!m_iGPUClockOffset.has_value()) {
+        // the GPU clock has its own epoch, map it onto ours once. Close enough for a trace, the read is a round trip to the GPU.
+        GLint64 gpuNow = 0;
+        glGetInteger64v(GL_TIMESTAMP_EXT, &gpuNow);
+        m_iGPUClockOffset = (int64_t)Trace::nowNs() - gpuNow;
+    }
+
+    m_vGPUTracePending.emplace_back(SGPUTraceQuery{.begin = takeQuery(), .end = takeQuery(), .monitor = m_RenderData.pMonitor ? m_RenderData.pMonitor->ID : -1});
+    m_sProc.glQueryCounterEXT(m_vGPUTracePending.back().begin, GL_TIMESTAMP_EXT);
+    m_bGPUTraceActive = true;
+}
+
+void CHyprOpenGLImpl::endGPUTrace() {
+    if (!m_bGPUTraceActive)
+        return;
+
+    m_sProc.glQueryCounterEXT(m_vGPUTracePending.back().end, GL_TIMESTAMP_EXT);
+    m_bGPUTraceActive = false;
+}
+
+void CHyprOpenGLImpl::collectGPUTraces() {
+    if (m_vGPUTracePending.empty())
+        return;
+
+    // reading the flag resets it. If it was set, the results we're about to read can be garbage (e.g. the clock changed)
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    if (disjoint)
+        m_iGPUClockOffset.reset();
+
+    size_t done = 0;
+    for (; done < m_vGPUTracePending.size(); ++done) {
+        const auto& PENDING = m_vGPUTracePending[done];
+
+        // the one still recording can't be read
+        if (m_bGPUTraceActive && done == m_vGPUTracePending.size() - 1)
+            break;
+
+        // results arrive in submission order, so the first unavailable one ends it
+        GLuint available = 0;
+        m_sProc.glGetQueryObjectuivEXT(PENDING.end, GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+        if (!available)
+            break;
+
+        GLuint64 begin = 0, end = 0;
+        m_sProc.glGetQueryObjectui64vEXT(PENDING.begin, GL_QUERY_RESULT_EXT, &begin);
+        m_sProc.glGetQueryObjectui64vEXT(PENDING.end, GL_QUERY_RESULT_EXT, &end);
+
+        if (!disjoint && m_iGPUClockOffset.has_value())
+            Trace::recordGPU(Trace::SEvent{.name = "frame", .category = "gpu", .startNs = begin + *m_iGPUClockOffset, .endNs = end + *m_iGPUClockOffset, .arg = PENDING.monitor});
+
+        m_vGPUTraceFreeQueries.emplace_back(PENDING.begin);
+        m_vGPUTraceFreeQueries.emplace_back(PENDING.end);
+    }
+
+    m_vGPUTracePending.erase(m_vGPUTracePending.begin(), m_vGPUTracePending.begin() + done);
+}
+
 void CHyprOpenGLImpl::setDamage(const CRegion& damage_, std::optional<CRegion> finalDamage) {
     m_RenderData.damage.set(damage_);
     m_RenderData.finalDamage.set(finalDamage.value_or(damage_));
@@ -1796,10 +1945,11 @@ void CHyprOpenGLImpl::renderTextureMatte(SP<CTexture> tex, const CBox& box, CFra
 //
 // Dual (or more) kawase blur
 CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* originalDamage) {
+    TRACE_ZONE("blur", "render");
 
     if (!m_RenderData.currentFB->getTexture()) {
         Debug::log(ERR, "BUG THIS: null fb texture while attempting to blur main fb?! (introspection off?!)");
-        return &m_RenderData.pCurrentMonData->mirrorFB; // return something to sample from at least
+        return getTransientFB(m_RenderData.pCurrentMonData->mirrorFB); // return something to sample from at least
     }
 
     TRACY_GPU_ZONE("RenderBlurMainFramebufferWithDamage");
@@ -1827,8 +1977,8 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
     damage.expand(*PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES));
 
     // helper
-    const auto    PMIRRORFB     = &m_RenderData.pCurrentMonData->mirrorFB;
-    const auto    PMIRRORSWAPFB = &m_RenderData.pCurrentMonData->mirrorSwapFB;
+    const auto    PMIRRORFB     = getTransientFB(m_RenderData.pCurrentMonData->mirrorFB);
+    const auto    PMIRRORSWAPFB = getTransientFB(m_RenderData.pCurrentMonData->mirrorSwapFB);
 
     CFramebuffer* currentRenderToFB = PMIRRORFB;
 
@@ -2032,6 +2182,9 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
 void CHyprOpenGLImpl::markBlurDirtyForMonitor(PHLMONITOR pMonitor) {
     m_mMonitorRenderResources[pMonitor].blurFBDirty = true;
+
+    if (m_pBlurCache)
+        m_pBlurCache->invalidate(pMonitor);
 }
 
 void CHyprOpenGLImpl::preRender(PHLMONITOR pMonitor) {
@@ -2224,13 +2377,29 @@ void CHyprOpenGLImpl::renderTextureWithBlur(SP<CTexture> tex, const CBox& box, f
     //   vvv TODO: layered blur fbs?
     const bool    USENEWOPTIMIZE = shouldUseNewBlurOptimizations(m_RenderData.currentLS.lock(), m_RenderData.currentWindow.lock()) && !blockBlurOptimization;
 
-    CFramebuffer* POUTFB = nullptr;
+    // the cache holds plain monitor-space blur, so nothing that moves or scales the scene, and only the real monitor render
+    static auto PBLURCACHE = CConfigValue<Hyprlang::INT>("decoration:blur:cache_size");
+    const bool  USECACHE   = !USENEWOPTIMIZE && *PBLURCACHE > 0 && m_RenderData.renderModif.modifs.empty() && m_RenderData.mouseZoomFactor == 1.f &&
+        m_RenderData.currentFB == m_RenderData.mainFB && m_RenderData.outFBOffset == Vector2D{} && !g_pHyprRenderer->m_bRenderingSnapshot;
+
+    CFramebuffer*    POUTFB = nullptr;
+    SP<CFramebuffer> cachedFB;
     if (!USENEWOPTIMIZE) {
         inverseOpaque.translate(box.pos());
         m_RenderData.renderModif.applyToRegion(inverseOpaque);
         inverseOpaque.intersect(texDamage);
 
-        POUTFB = blurMainFramebufferWithDamage(a, &inverseOpaque);
+        if (USECACHE)
+            cachedFB = m_pBlurCache->get(pSurface, m_RenderData.pMonitor.lock(), box, a, inverseOpaque);
+
+        if (cachedFB)
+            POUTFB = cachedFB.get();
+        else {
+            POUTFB = blurMainFramebufferWithDamage(a, &inverseOpaque);
+
+            if (USECACHE)
+                m_pBlurCache->put(pSurface, m_RenderData.pMonitor.lock(), box, a, inverseOpaque, POUTFB);
+        }
     } else
         POUTFB = &m_RenderData.pCurrentMonData->blurFB;
 
@@ -2272,6 +2441,13 @@ void CHyprOpenGLImpl::renderTextureWithBlur(SP<CTexture> tex, const CBox& box, f
     m_RenderData.primarySurfaceUVTopLeft     = monitorSpaceBox.pos() / m_RenderData.pMonitor->vecTransformedSize;
     m_RenderData.primarySurfaceUVBottomRight = (monitorSpaceBox.pos() + monitorSpaceBox.size()) / m_RenderData.pMonitor->vecTransformedSize;
 
+    // the cached blur is only the crop around the surface, not the whole monitor
+    if (cachedFB) {
+        const auto CROP                          = CBlurCache::bufferBoxFor(m_RenderData.pMonitor.lock(), box);
+        m_RenderData.primarySurfaceUVTopLeft     = (m_RenderData.primarySurfaceUVTopLeft * m_RenderData.pMonitor->vecPixelSize - CROP.pos()) / CROP.size();
+        m_RenderData.primarySurfaceUVBottomRight = (m_RenderData.primarySurfaceUVBottomRight * m_RenderData.pMonitor->vecPixelSize - CROP.pos()) / CROP.size();
+    }
+
     static auto PBLURIGNOREOPACITY = CConfigValue<Hyprlang::INT>("decoration:blur:ignore_opacity");
     setMonitorTransformEnabled(true);
     if (!USENEWOPTIMIZE)
@@ -2715,15 +2891,21 @@ SP<CTexture> CHyprOpenGLImpl::loadAsset(const std::string& filename) {
 }
 
 SP<CTexture> CHyprOpenGLImpl::renderText(const std::string& text, CHyprColor col, int pt, bool italic, const std::string& fontFamily, int maxWidth) {
-    SP<CTexture>          tex = makeShared<CTexture>();
+    static auto         FONT = CConfigValue<std::string>("misc:font_family");
+
+    const auto          FONTFAMILY = fontFamily.empty() ? *FONT : fontFamily;
+    const auto          FONTSIZE   = pt;
+    const auto          COLOR      = col;
 
-    static auto           FONT = CConfigValue<std::string>("misc:font_family");
+    const STextCacheKey KEY = {.text = text, .fontFamily = FONTFAMILY, .pt = FONTSIZE, .italic = italic, .color = COLOR.getAsHex(), .maxWidth = std::max(maxWidth, 0)};
 
-    const auto            FONTFAMILY = fontFamily.empty() ? *FONT : fontFamily;
-    const auto            FONTSIZE   = pt;
-    const auto            COLOR      = col;
+    if (auto cached = m_pTextCache->get(KEY); cached)
+        return cached;
+
+    SP<CTexture> tex = makeShared<CTexture>();
 
-    auto                  CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1920, 1080 /* arbitrary, just for size */);
+    // shape once on a dummy surface, then draw the same layout onto one that fits it
+    auto                  CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
     auto                  CAIRO        = cairo_create(CAIROSURFACE);
 
     PangoLayout*          layoutText = pango_cairo_create_layout(CAIRO);
@@ -2735,8 +2917,6 @@ SP<CTexture> CHyprOpenGLImpl::renderText(const std::string& text, CHyprColor col
     pango_font_description_set_weight(pangoFD, PANGO_WEIGHT_NORMAL);
     pango_layout_set_font_description(layoutText, pangoFD);
 
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
-
     int textW = 0, textH = 0;
     pango_layout_set_text(layoutText, text.c_str(), -1);
 
@@ -2750,29 +2930,19 @@ SP<CTexture> CHyprOpenGLImpl::renderText(const std::string& text, CHyprColor col
     textH /= PANGO_SCALE;
 
     pango_font_description_free(pangoFD);
-    g_object_unref(layoutText);
     cairo_destroy(CAIRO);
     cairo_surface_destroy(CAIROSURFACE);
 
-    CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, textW, textH);
+    CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, std::max(textW, 1), std::max(textH, 1));
     CAIRO        = cairo_create(CAIROSURFACE);
 
-    layoutText = pango_cairo_create_layout(CAIRO);
-    pangoFD    = pango_font_description_new();
-
-    pango_font_description_set_family_static(pangoFD, FONTFAMILY.c_str());
-    pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
-    pango_font_description_set_style(pangoFD, italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
-    pango_font_description_set_weight(pangoFD, PANGO_WEIGHT_NORMAL);
-    pango_layout_set_font_description(layoutText, pangoFD);
-    pango_layout_set_text(layoutText, text.c_str(), -1);
+    pango_cairo_update_layout(CAIRO, layoutText);
 
     cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
 
     cairo_move_to(CAIRO, 0, 0);
     pango_cairo_show_layout(CAIRO, layoutText);
 
-    pango_font_description_free(pangoFD);
     g_object_unref(layoutText);
 
     cairo_surface_flush(CAIROSURFACE);
@@ -2793,6 +2963,8 @@ SP<CTexture> CHyprOpenGLImpl::renderText(const std::string& text, CHyprColor col
     cairo_destroy(CAIRO);
     cairo_surface_destroy(CAIROSURFACE);
 
+    m_pTextCache->put(KEY, tex);
+
     return tex;
 }
 
@@ -3004,12 +3176,9 @@ void CHyprOpenGLImpl::destroyMonitorResources(PHLMONITORREF pMonitor) {
 
     auto RESIT = g_pHyprOpenGL->m_mMonitorRenderResources.find(pMonitor);
     if (RESIT != g_pHyprOpenGL->m_mMonitorRenderResources.end()) {
-        RESIT->second.mirrorFB.release();
         RESIT->second.offloadFB.release();
-        RESIT->second.mirrorSwapFB.release();
         RESIT->second.monitorMirrorFB.release();
         RESIT->second.blurFB.release();
-        RESIT->second.offMainFB.release();
         RESIT->second.stencilTex->destroyTexture();
         g_pHyprOpenGL->m_mMonitorRenderResources.erase(RESIT);
     }
@@ -3020,6 +3189,9 @@ void CHyprOpenGLImpl::destroyMonitorResources(PHLMONITORREF pMonitor) {
         g_pHyprOpenGL->m_mMonitorBGFBs.erase(TEXIT);
     }
 
+    if (pMonitor && g_pHyprRenderer)
+        g_pHyprRenderer->m_sRenderPass.m_mRetained.erase(pMonitor->ID);
+
     if (pMonitor)
         Debug::log(LOG, "Monitor {} -> destroyed all render data", pMonitor->szName);
 }
@@ -3037,16 +3209,27 @@ void CHyprOpenGLImpl::restoreMatrix() {
 }
 
 void CHyprOpenGLImpl::bindOffMain() {
-    if (!m_RenderData.pCurrentMonData->offMainFB.isAllocated()) {
-        m_RenderData.pCurrentMonData->offMainFB.alloc(m_RenderData.pMonitor->vecPixelSize.x, m_RenderData.pMonitor->vecPixelSize.y,
-                                                      m_RenderData.pMonitor->output->state->state().drmFormat);
-
-        m_RenderData.pCurrentMonData->offMainFB.addStencil(m_RenderData.pCurrentMonData->stencilTex);
-    }
+    const auto PFB = getTransientFB(m_RenderData.pCurrentMonData->offMainFB);
 
-    m_RenderData.pCurrentMonData->offMainFB.bind();
+    PFB->bind();
     clear(CHyprColor(0, 0, 0, 0));
-    m_RenderData.currentFB = &m_RenderData.pCurrentMonData->offMainFB;
+    m_RenderData.currentFB = PFB;
+}
+
+CFramebuffer* CHyprOpenGLImpl::getTransientFB(CFramebuffer& fb) {
+    RASSERT(m_RenderData.pMonitor, "Tried to get a transient fb without begin()!");
+
+    if (fb.isAllocated())
+        return &fb;
+
+    // move the pooled storage into the member, plugins expect these to be plain CFramebuffers
+    fb.swap(*m_pFramebufferPool->acquire(m_RenderData.pMonitor->vecPixelSize, m_RenderData.pMonitor->output->state->state().drmFormat));
+
+    // pooled fbs might have been someone else's, only re-attach if it's not ours already
+    if (fb.getStencilTex() != m_RenderData.pCurrentMonData->stencilTex)
+        fb.addStencil(m_RenderData.pCurrentMonData->stencilTex);
+
+    return &fb;
 }
 
 void CHyprOpenGLImpl::renderOffToMain(CFramebuffer* off) {
@@ -19,6 +19,11 @@
 #include "Texture.hpp"
 #include "Framebuffer.hpp"
 #include "Renderbuffer.hpp"
+#include "FramebufferPool.hpp"
+#include "BlurCache.hpp"
+#include "ShmReadback.hpp"
+#include "TextCache.hpp"
+#include "ProgramCache.hpp"
 #include "pass/Pass.hpp"
 
 #include <EGL/egl.h>
@@ -101,6 +106,8 @@ struct SPreparedShaders {
 
 struct SMonitorRenderData {
     CFramebuffer offloadFB;
+    // mirrorFB, mirrorSwapFB and offMainFB only have storage between begin() and end(), borrowed from the framebuffer pool
+    // when something asks for them. Call CHyprOpenGLImpl::getTransientFB() on them before use.
     CFramebuffer mirrorFB;     // these are used for some effects,
     CFramebuffer mirrorSwapFB; // etc
     CFramebuffer offMainFB;
@@ -113,6 +120,12 @@ struct SMonitorRenderData {
     bool         blurFBShouldRender = false;
 };
 
+// a closing window / layer, cropped to its bounding box.
+struct SSnapshotFramebuffer {
+    SP<CFramebuffer> fb;
+    CBox             box; // what part of the monitor fb covers, transformed monitor pixels
+};
+
 struct SCurrentRenderData {
     PHLMONITORREF          pMonitor;
     Mat3x3                 projection;
@@ -123,6 +136,7 @@ struct SCurrentRenderData {
     CFramebuffer*          currentFB       = nullptr; // current rendering to
     CFramebuffer*          mainFB          = nullptr; // main to render to
     CFramebuffer*          outFB           = nullptr; // out to render to (if offloaded, etc)
+    Vector2D               outFBOffset;               // where outFB sits on the monitor in buffer pixels, if it's smaller
 
     CRegion                damage;
     CRegion                finalDamage; // damage used for funal off -> main
@@ -236,6 +250,9 @@ class CHyprOpenGLImpl {
     EGLImageKHR                          createEGLImage(const Aquamarine::SDMABUFAttrs& attrs);
     SP<CEGLSync>                         createEGLSync(int fence = -1);
 
+    // gets a monitor-sized fb from the pool for the current frame, it goes back to the pool in end()
+    CFramebuffer*                        getTransientFB(CFramebuffer& fb);
+
     bool                                 initShaders();
     bool                                 m_bShadersInitialized = false;
     SP<SPreparedShaders>                 m_shaders;
@@ -251,11 +268,17 @@ class CHyprOpenGLImpl {
 
     bool                                 m_bReloadScreenShader = true; // at launch it can be set
 
-    std::map<PHLWINDOWREF, CFramebuffer> m_mWindowFramebuffers;
-    std::map<PHLLSREF, CFramebuffer>     m_mLayerFramebuffers;
+    std::map<PHLWINDOWREF, SSnapshotFramebuffer> m_mWindowFramebuffers;
+    std::map<PHLLSREF, SSnapshotFramebuffer>     m_mLayerFramebuffers;
     std::map<PHLMONITORREF, SMonitorRenderData> m_mMonitorRenderResources;
     std::map<PHLMONITORREF, CFramebuffer>       m_mMonitorBGFBs;
 
+    UP<CFramebufferPool>                        m_pFramebufferPool;
+    UP<CBlurCache>                              m_pBlurCache;
+    UP<CShmReadback>                            m_pShmReadback;
+    UP<CTextCache>                              m_pTextCache;
+    UP<CProgramBinaryCache>                     m_pProgramCache;
+
     struct {
         PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESPROC glEGLImageTargetRenderbufferStorageOES = nullptr;
         PFNGLEGLIMAGETARGETTEXTURE2DOESPROC           glEGLImageTargetTexture2DOES           = nullptr;
@@ -272,6 +295,12 @@ class CHyprOpenGLImpl {
         PFNEGLDESTROYSYNCKHRPROC                      eglDestroySyncKHR                      = nullptr;
         PFNEGLDUPNATIVEFENCEFDANDROIDPROC             eglDupNativeFenceFDANDROID             = nullptr;
         PFNEGLWAITSYNCKHRPROC                         eglWaitSyncKHR                         = nullptr;
+        PFNGLGENQUERIESEXTPROC                        glGenQueriesEXT                        = nullptr;
+        PFNGLDELETEQUERIESEXTPROC                     glDeleteQueriesEXT                     = nullptr;
+        PFNGLQUERYCOUNTEREXTPROC                      glQueryCounterEXT                      = nullptr;
+        PFNGLGETQUERYIVEXTPROC                        glGetQueryivEXT                        = nullptr;
+        PFNGLGETQUERYOBJECTUIVEXTPROC                 glGetQueryObjectuivEXT                 = nullptr;
+        PFNGLGETQUERYOBJECTUI64VEXTPROC               glGetQueryObjectui64vEXT               = nullptr;
     } m_sProc;
 
     struct {
@@ -281,6 +310,7 @@ class CHyprOpenGLImpl {
         bool KHR_display_reference              = false;
         bool IMG_context_priority               = false;
         bool EXT_create_context_robustness      = false;
+        bool EXT_disjoint_timer_query           = false;
     } m_sExts;
 
     SP<CTexture> m_pScreencopyDeniedTexture;
@@ -313,9 +343,23 @@ class CHyprOpenGLImpl {
     CShader                 m_sFinalScreenShader;
     CTimer                  m_tGlobalTimer;
 
+    // GPU timestamps at begin() and end() per frame for the trace recorder, resolved a few frames later
+    struct SGPUTraceQuery {
+        GLuint  begin   = 0;
+        GLuint  end     = 0;
+        int64_t monitor = -1;
+    };
+    std::vector<SGPUTraceQuery> m_vGPUTracePending;
+    std::vector<GLuint>         m_vGPUTraceFreeQueries;
+    bool                        m_bGPUTraceActive = false;
+    std::optional<int64_t>      m_iGPUClockOffset; // cpu - gpu ns, taken once and again after a disjoint event
+
     SP<CTexture>            m_pMissingAssetTexture, m_pBackgroundTexture, m_pLockDeadTexture, m_pLockDead2Texture, m_pLockTtyTextTexture; // TODO: don't always load lock
 
     void                    logShaderError(const GLuint&, bool program = false, bool silent = false);
+    void                    beginGPUTrace();
+    void                    endGPUTrace();
+    void                    collectGPUTraces();
     GLuint                  createProgram(const std::string&, const std::string&, bool dynamic = false, bool silent = false);
     GLuint                  compileShader(const GLuint&, std::string, bool dynamic = false, bool silent = false);
     void                    createBGTextureForMonitor(PHLMONITOR);
@@ -0,0 +1,222 @@
+#include "ProgramCache.hpp"
+#include "../debug/Log.hpp"
+#include "../version.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <vector>
+
+// bump on changes to the file layout
+constexpr static uint32_t BINARY_CACHE_VERSION = 1;
+constexpr static uint32_t MAX_BINARY_SIZE      = 64 * 1024 * 1024;
+
+struct SBinaryHeader {
+    char     magic[4] = {'H', 'L', 'P', 'B'};
+    uint32_t version  = BINARY_CACHE_VERSION;
+    uint32_t format   = 0;
+    uint32_t length   = 0;
+};
+
+// stable across runs and standard libraries, unlike std::hash
+static uint64_t fnv1a(std::string_view data, uint64_t hash = 0xcbf29ce484222325ULL) {
+    for (const auto c : data) {
+        hash ^= (uint8_t)c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static std::string glString(GLenum name) {
+    const auto STR = (const char*)glGetString(name);
+    return STR ? STR : "";
+}
+
+CProgramBinaryCache::CProgramBinaryCache() {
+#ifndef GLES2
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    if (formats <= 0) {
+        Debug::log(LOG, "CProgramBinaryCache: driver has no program binary formats, shaders will always be compiled");
+        return;
+    }
+
+    const auto CACHEHOME = getenv("XDG_CACHE_HOME");
+    const auto HOME      = getenv("HOME");
+
+    if (CACHEHOME && CACHEHOME[0] != '\0')
+        m_szDir = std::string{CACHEHOME} + "/hyprland/shaders";
+    else if (HOME && HOME[0] != '\0')
+        m_szDir = std::string{HOME} + "/.cache/hyprland/shaders";
+    else {
+        Debug::log(WARN, "CProgramBinaryCache: $XDG_CACHE_HOME and $HOME not set, not caching shaders");
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_szDir, ec);
+
+    if (ec) {
+        Debug::log(WARN, "CProgramBinaryCache: couldn't create {}: {}", m_szDir, ec.message());
+        return;
+    }
+
+    m_szDriver = std::format("{}\n{}\n{}\n{}{}", glString(GL_VENDOR), glString(GL_RENDERER), glString(GL_VERSION), GIT_COMMIT_HASH, GIT_DIRTY);
+    m_bEnabled = true;
+
+    prune();
+#endif
+}
+
+std::string CProgramBinaryCache::pathFor(const std::string& vert, const std::string& frag) const {
+    uint64_t hash = fnv1a(m_szDriver);
+    hash          = fnv1a(vert, hash);
+    // so that moving text between the two sources changes the key
+    hash = fnv1a(std::string_view{"\0", 1}, hash);
+    hash = fnv1a(frag, hash);
+
+    return std::format("{}/{:016x}.bin", m_szDir, hash);
+}
+
+GLuint CProgramBinaryCache::load(const std::string& vert, const std::string& frag) {
+#ifndef GLES2
+    if (!m_bEnabled)
+        return 0;
+
+    const auto    PATH = pathFor(vert, frag);
+    std::ifstream file(PATH, std::ios::binary);
+
+    if (!file.good())
+        return 0;
+
+    std::error_code ec;
+    SBinaryHeader   header;
+    file.read((char*)&header, sizeof(header));
+
+    if (!file || memcmp(header.magic, SBinaryHeader{}.magic, sizeof(header.magic)) != 0 || header.version != BINARY_CACHE_VERSION || header.length == 0 ||
+        header.length > MAX_BINARY_SIZE) {
+        Debug::log(WARN, "CProgramBinaryCache: {} is broken, dropping it", PATH);
+        std::filesystem::remove(PATH, ec);
+        return 0;
+    }
+
+    std::vector<char> binary(header.length);
+    file.read(binary.data(), header.length);
+
+    if (!file) {
+        Debug::log(WARN, "CProgramBinaryCache: {} is truncated, dropping it", PATH);
+        std::filesystem::remove(PATH, ec);
+        return 0;
+    }
+
+    auto prog = glCreateProgram();
+    glProgramBinary(prog, header.format, binary.data(), header.length);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+
+    if (ok != GL_TRUE) {
+        // e.g. a driver update that kept the version string. Not an error, just recompile.
+        Debug::log(LOG, "CProgramBinaryCache: driver rejected {}, compiling from source", PATH);
+        while (glGetError() != GL_NO_ERROR) {
+            ;
+        }
+        glDeleteProgram(prog);
+        std::filesystem::remove(PATH, ec);
+        return 0;
+    }
+
+    // keeps it from being pruned
+    std::filesystem::last_write_time(PATH, std::filesystem::file_time_type::clock::now(), ec);
+
+    return prog;
+#else
+    return 0;
+#endif
+}
+
+void CProgramBinaryCache::prepare(GLuint program) {
+#ifndef GLES2
+    if (m_bEnabled)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+}
+
+void CProgramBinaryCache::store(GLuint program, const std::string& vert, const std::string& frag) {
+#ifndef GLES2
+    if (!m_bEnabled)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length <= 0 || (uint32_t)length > MAX_BINARY_SIZE)
+        return;
+
+    std::vector<char> binary(length);
+    GLsizei           written = 0;
+    GLenum            format  = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+
+    if (written <= 0)
+        return;
+
+    SBinaryHeader header;
+    header.format = format;
+    header.length = written;
+
+    // write and rename, so that a crash mid-write can't leave a half file behind
+    const auto PATH    = pathFor(vert, frag);
+    const auto TMPPATH = PATH + ".tmp";
+
+    {
+        std::ofstream file(TMPPATH, std::ios::binary | std::ios::trunc);
+        file.write((const char*)&header, sizeof(header));
+        file.write(binary.data(), written);
+
+        if (!file.good()) {
+            Debug::log(WARN, "CProgramBinaryCache: failed writing {}", TMPPATH);
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(TMPPATH, ec);
+            return;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(TMPPATH, PATH, ec);
+
+    if (ec)
+        Debug::log(WARN, "CProgramBinaryCache: failed to rename {}: {}", TMPPATH, ec.message());
+#endif
+}
+
+void CProgramBinaryCache::prune() {
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+    std::error_code                                                                ec;
+
+    for (const auto& entry : std::filesystem::directory_iterator(m_szDir, ec)) {
+        if (!entry.is_regular_file(ec))
+            continue;
+
+        // leftovers of a crash
+        if (entry.path().extension() == ".tmp") {
+            std::filesystem::remove(entry.path(), ec);
+            continue;
+        }
+
+        entries.emplace_back(entry.last_write_time(ec), entry.path());
+    }
+
+    if (entries.size() <= MAX_ENTRIES)
+        return;
+
+    // old custom screen shaders and old drivers pile up, drop the least recently used
+    std::ranges::sort(entries, [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (size_t i = 0; i < entries.size() - MAX_ENTRIES; ++i) {
+        std::filesystem::remove(entries[i].second, ec);
+    }
+}
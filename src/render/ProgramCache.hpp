@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <string>
+
+/*
+    On-disk cache of linked GL program binaries, so we don't compile all the shaders
+    on every launch. Keyed by the processed sources, the driver and our build:
+    a binary the driver rejects anyways is dropped and the program compiled from source.
+    Needs GLES3, GLES2 only has this as an extension.
+*/
+class CProgramBinaryCache {
+  public:
+    CProgramBinaryCache();
+
+    // 0 on a miss
+    GLuint load(const std::string& vert, const std::string& frag);
+    // call before linking a program that will be stored
+    void   prepare(GLuint program);
+    void   store(GLuint program, const std::string& vert, const std::string& frag);
+
+  private:
+    std::string pathFor(const std::string& vert, const std::string& frag) const;
+    void        prune();
+
+    std::string m_szDriver;
+    std::string m_szDir;
+    bool        m_bEnabled = false;
+
+    constexpr static size_t MAX_ENTRIES = 64;
+};
@@ -33,6 +33,7 @@
 #include "pass/RendererHintsPassElement.hpp"
 #include "pass/SurfacePassElement.hpp"
 #include "debug/Log.hpp"
+#include "../debug/Trace.hpp"
 #include "../protocols/ColorManagement.hpp"
 #include "../protocols/types/ContentType.hpp"
 #include "../helpers/MiscFunctions.hpp"
@@ -104,7 +105,7 @@ CHyprRenderer::CHyprRenderer() {
         ensureCursorRenderingMode();
     });
 
-    static auto P2 = g_pHookSystem->hookDynamic("mouseMove", [&](void* self, SCallbackInfo& info, std::any param) {
+    static auto P2 = g_pHookSystem->registerTyped<HOOK_MOUSE_MOVE>([&](SCallbackInfo& info, const Vector2D& pos) {
         if (!m_sCursorHiddenConditions.hiddenOnKeyboard && m_sCursorHiddenConditions.hiddenOnTouch == g_pInputManager->m_bLastInputTouch &&
             !m_sCursorHiddenConditions.hiddenOnTimeout)
             return;
@@ -1131,6 +1132,8 @@ void CHyprRenderer::calculateUVForSurface(PHLWINDOW pWindow, SP<CWLSurfaceResour
 }
 
 void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor) {
+    TRACE_ZONE_ARG("renderMonitor", "render", pMonitor->ID);
+
     static std::chrono::high_resolution_clock::time_point renderStart        = std::chrono::high_resolution_clock::now();
     static std::chrono::high_resolution_clock::time_point renderStartOverlay = std::chrono::high_resolution_clock::now();
     static std::chrono::high_resolution_clock::time_point endRenderOverlay   = std::chrono::high_resolution_clock::now();
@@ -1242,7 +1245,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor) {
         }
     }
 
-    EMIT_HOOK_EVENT("preRender", pMonitor);
+    EMIT_TYPED_HOOK_EVENT(HOOK_PRE_RENDER, pMonitor);
 
     const auto NOW = Time::steadyNow();
 
@@ -1462,6 +1465,8 @@ static hdr_output_metadata       createHDRMetadata(SImageDescription settings, A
 }
 
 bool CHyprRenderer::commitPendingAndDoExplicitSync(PHLMONITOR pMonitor) {
+    TRACE_ZONE_ARG("commitOutput", "render", pMonitor->ID);
+
     static auto PPASS = CConfigValue<Hyprlang::INT>("render:cm_fs_passthrough");
     const bool  PHDR  = pMonitor->imageDescription.transferFunction == CM_TRANSFER_FUNCTION_ST2084_PQ;
 
@@ -1854,7 +1859,7 @@ void CHyprRenderer::damageSurface(SP<CWLSurfaceResource> pSurface, double x, dou
         damageBoxForEach.set(damageBox);
         damageBoxForEach.translate({-m->vecPosition.x, -m->vecPosition.y}).scale(m->scale);
 
-        m->addDamage(damageBoxForEach);
+        m->addDamage(damageBoxForEach, pSurface);
     }
 
     static auto PLOGDAMAGE = CConfigValue<Hyprlang::INT>("debug:log_damage");
@@ -2412,6 +2417,37 @@ void CHyprRenderer::makeRawWindowSnapshot(PHLWINDOW pWindow, CFramebuffer* pFram
     endRender();
 }
 
+bool CHyprRenderer::beginSnapshotRender(PHLMONITOR pMonitor, CBox box, SSnapshotFramebuffer& snapshot) {
+    // only the part of the monitor the surface covers, so both the fb and the fill rate scale with it, not with the monitor
+    box.translate(-pMonitor->vecPosition).scale(pMonitor->scale).expand(1).round();
+    box = box.intersection(CBox{0, 0, pMonitor->vecTransformedSize.x, pMonitor->vecTransformedSize.y});
+
+    makeEGLCurrent();
+
+    if (box.empty())
+        return false;
+
+    const auto BUFFERBOX = box.copy().transform(wlTransformToHyprutils(invertTransform(pMonitor->transform)), pMonitor->vecTransformedSize.x, pMonitor->vecTransformedSize.y);
+
+    // not from the framebuffer pool. Snapshots live as long as their animation, and recycling them would push out the effect buffers.
+    if (!snapshot.fb)
+        snapshot.fb = makeShared<CFramebuffer>();
+
+    snapshot.fb->alloc(BUFFERBOX.w, BUFFERBOX.h, pMonitor->output->state->state().drmFormat);
+    snapshot.box = box;
+
+    CRegion fakeDamage{box};
+
+    if (!beginRender(pMonitor, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, snapshot.fb.get())) {
+        Debug::log(ERR, "beginSnapshotRender: beginRender failed for monitor {}", pMonitor->szName);
+        return false;
+    }
+
+    g_pHyprOpenGL->m_RenderData.outFBOffset = BUFFERBOX.pos();
+
+    return true;
+}
+
 void CHyprRenderer::makeWindowSnapshot(PHLWINDOW pWindow) {
     // we trust the window is valid.
     const auto PMONITOR = pWindow->m_pMonitor.lock();
@@ -2422,20 +2458,17 @@ void CHyprRenderer::makeWindowSnapshot(PHLWINDOW pWindow) {
     if (!shouldRenderWindow(pWindow))
         return; // ignore, window is not being rendered
 
-    // we need to "damage" the entire monitor
-    // so that we render the entire window
-    // this is temporary, doesnt mess with the actual damage
-    CRegion      fakeDamage{0, 0, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y};
+    const auto PWORKSPACE = pWindow->m_pWorkspace;
+    CBox       box        = pWindow->getFullWindowBoundingBox().translate(pWindow->m_vFloatingOffset);
+    if (PWORKSPACE && !pWindow->m_bPinned)
+        box.translate(PWORKSPACE->m_vRenderOffset->value());
 
     PHLWINDOWREF ref{pWindow};
 
-    makeEGLCurrent();
-
-    const auto PFRAMEBUFFER = &g_pHyprOpenGL->m_mWindowFramebuffers[ref];
-
-    PFRAMEBUFFER->alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, PMONITOR->output->state->state().drmFormat);
-
-    beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, PFRAMEBUFFER);
+    if (!beginSnapshotRender(PMONITOR, box, g_pHyprOpenGL->m_mWindowFramebuffers[ref])) {
+        g_pHyprOpenGL->m_mWindowFramebuffers.erase(ref);
+        return;
+    }
 
     m_bRenderingSnapshot = true;
 
@@ -2468,18 +2501,10 @@ void CHyprRenderer::makeLayerSnapshot(PHLLS pLayer) {
     if (!PMONITOR || !PMONITOR->output || PMONITOR->vecPixelSize.x <= 0 || PMONITOR->vecPixelSize.y <= 0)
         return;
 
-    // we need to "damage" the entire monitor
-    // so that we render the entire window
-    // this is temporary, doesnt mess with the actual damage
-    CRegion fakeDamage{0, 0, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y};
-
-    makeEGLCurrent();
-
-    const auto PFRAMEBUFFER = &g_pHyprOpenGL->m_mLayerFramebuffers[pLayer];
-
-    PFRAMEBUFFER->alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, PMONITOR->output->state->state().drmFormat);
-
-    beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, PFRAMEBUFFER);
+    if (!beginSnapshotRender(PMONITOR, CBox{pLayer->realPosition->value(), pLayer->realSize->value()}, g_pHyprOpenGL->m_mLayerFramebuffers[pLayer])) {
+        g_pHyprOpenGL->m_mLayerFramebuffers.erase(pLayer);
+        return;
+    }
 
     m_bRenderingSnapshot = true;
 
@@ -2508,7 +2533,7 @@ void CHyprRenderer::renderSnapshot(PHLWINDOW pWindow) {
 
     const auto FBDATA = &g_pHyprOpenGL->m_mWindowFramebuffers.at(ref);
 
-    if (!FBDATA->getTexture())
+    if (!FBDATA->fb || !FBDATA->fb->getTexture())
         return;
 
     const auto PMONITOR = pWindow->m_pMonitor.lock();
@@ -2519,10 +2544,11 @@ void CHyprRenderer::renderSnapshot(PHLWINDOW pWindow) {
     Vector2D scaleXY = Vector2D((PMONITOR->scale * pWindow->m_vRealSize->value().x / (pWindow->m_vOriginalClosedSize.x * PMONITOR->scale)),
                                 (PMONITOR->scale * pWindow->m_vRealSize->value().y / (pWindow->m_vOriginalClosedSize.y * PMONITOR->scale)));
 
-    windowBox.width  = PMONITOR->vecTransformedSize.x * scaleXY.x;
-    windowBox.height = PMONITOR->vecTransformedSize.y * scaleXY.y;
-    windowBox.x      = ((pWindow->m_vRealPosition->value().x - PMONITOR->vecPosition.x) * PMONITOR->scale) - ((pWindow->m_vOriginalClosedPos.x * PMONITOR->scale) * scaleXY.x);
-    windowBox.y      = ((pWindow->m_vRealPosition->value().y - PMONITOR->vecPosition.y) * PMONITOR->scale) - ((pWindow->m_vOriginalClosedPos.y * PMONITOR->scale) * scaleXY.y);
+    // the snapshot only covers FBDATA->box, scale it around the original window position
+    windowBox.width  = FBDATA->box.width * scaleXY.x;
+    windowBox.height = FBDATA->box.height * scaleXY.y;
+    windowBox.x      = ((pWindow->m_vRealPosition->value().x - PMONITOR->vecPosition.x) * PMONITOR->scale) + ((FBDATA->box.x - pWindow->m_vOriginalClosedPos.x * PMONITOR->scale) * scaleXY.x);
+    windowBox.y      = ((pWindow->m_vRealPosition->value().y - PMONITOR->vecPosition.y) * PMONITOR->scale) + ((FBDATA->box.y - pWindow->m_vOriginalClosedPos.y * PMONITOR->scale) * scaleXY.y);
 
     CRegion fakeDamage{0, 0, PMONITOR->vecTransformedSize.x, PMONITOR->vecTransformedSize.y};
 
@@ -2539,7 +2565,7 @@ void CHyprRenderer::renderSnapshot(PHLWINDOW pWindow) {
 
     CTexPassElement::SRenderData data;
     data.flipEndFrame = true;
-    data.tex          = FBDATA->getTexture();
+    data.tex          = FBDATA->fb->getTexture();
     data.box          = windowBox;
     data.a            = pWindow->m_fAlpha->value();
     data.damage       = fakeDamage;
@@ -2553,7 +2579,7 @@ void CHyprRenderer::renderSnapshot(PHLLS pLayer) {
 
     const auto FBDATA = &g_pHyprOpenGL->m_mLayerFramebuffers.at(pLayer);
 
-    if (!FBDATA->getTexture())
+    if (!FBDATA->fb || !FBDATA->fb->getTexture())
         return;
 
     const auto PMONITOR = pLayer->monitor.lock();
@@ -2564,16 +2590,16 @@ void CHyprRenderer::renderSnapshot(PHLLS pLayer) {
     Vector2D scaleXY = Vector2D((PMONITOR->scale * pLayer->realSize->value().x / (pLayer->geometry.w * PMONITOR->scale)),
                                 (PMONITOR->scale * pLayer->realSize->value().y / (pLayer->geometry.h * PMONITOR->scale)));
 
-    layerBox.width  = PMONITOR->vecTransformedSize.x * scaleXY.x;
-    layerBox.height = PMONITOR->vecTransformedSize.y * scaleXY.y;
-    layerBox.x = ((pLayer->realPosition->value().x - PMONITOR->vecPosition.x) * PMONITOR->scale) - (((pLayer->geometry.x - PMONITOR->vecPosition.x) * PMONITOR->scale) * scaleXY.x);
-    layerBox.y = ((pLayer->realPosition->value().y - PMONITOR->vecPosition.y) * PMONITOR->scale) - (((pLayer->geometry.y - PMONITOR->vecPosition.y) * PMONITOR->scale) * scaleXY.y);
+    layerBox.width  = FBDATA->box.width * scaleXY.x;
+    layerBox.height = FBDATA->box.height * scaleXY.y;
+    layerBox.x = ((pLayer->realPosition->value().x - PMONITOR->vecPosition.x) * PMONITOR->scale) + ((FBDATA->box.x - (pLayer->geometry.x - PMONITOR->vecPosition.x) * PMONITOR->scale) * scaleXY.x);
+    layerBox.y = ((pLayer->realPosition->value().y - PMONITOR->vecPosition.y) * PMONITOR->scale) + ((FBDATA->box.y - (pLayer->geometry.y - PMONITOR->vecPosition.y) * PMONITOR->scale) * scaleXY.y);
 
     CRegion                      fakeDamage{0, 0, PMONITOR->vecTransformedSize.x, PMONITOR->vecTransformedSize.y};
 
     CTexPassElement::SRenderData data;
     data.flipEndFrame = true;
-    data.tex          = FBDATA->getTexture();
+    data.tex          = FBDATA->fb->getTexture();
     data.box          = layerBox;
     data.a            = pLayer->alpha->value();
     data.damage       = fakeDamage;
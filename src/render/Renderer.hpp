@@ -130,6 +130,7 @@ class CHyprRenderer {
     void renderSessionLockMissing(PHLMONITOR pMonitor);
 
     bool commitPendingAndDoExplicitSync(PHLMONITOR pMonitor);
+    bool beginSnapshotRender(PHLMONITOR pMonitor, CBox box, SSnapshotFramebuffer& snapshot); // box is logical, global
 
     bool m_bCursorHidden                           = false;
     bool m_bCursorHasSurface                       = false;
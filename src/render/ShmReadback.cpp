@@ -0,0 +1,137 @@
+#include "ShmReadback.hpp"
+#include "OpenGL.hpp"
+#include "Renderer.hpp"
+#include "../protocols/types/Buffer.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+CShmReadback::~CShmReadback() {
+    for (auto const& pbo : m_vFree) {
+        glDeleteBuffers(1, &pbo.id);
+    }
+}
+
+void CShmReadback::readInto(SP<IHLBuffer> buffer, const CBox& region, std::function<void(bool)> callback) {
+    const auto SHM     = buffer->shm();
+    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(SHM.format);
+    if (!PFORMAT) {
+        Debug::log(ERR, "CShmReadback: no pixel format for {}", NFormatUtils::drmFormatName(SHM.format));
+        callback(false);
+        return;
+    }
+
+    const auto     glFormat   = PFORMAT->flipRB ? GL_BGRA_EXT : GL_RGBA;
+    const auto     size       = region.size();
+    const uint32_t packStride = NFormatUtils::minStride(PFORMAT, size.x);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+#ifndef GLES2
+    const auto PBO = acquire((size_t)packStride * size.y);
+
+    // goes into the bound pack buffer, doesn't wait for the gpu
+    glReadPixels(region.x, region.y, size.x, size.y, glFormat, PFORMAT->glType, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    auto sync = g_pHyprOpenGL->createEGLSync();
+    if (!sync) {
+        // mapping will block until the read is done, but it will still be correct.
+        finish(PBO, buffer, size, packStride, callback);
+        return;
+    }
+
+    g_pEventLoopManager->doOnReadable(sync->takeFD(), [this, PBO, buffer, size, packStride, callback]() { finish(PBO, buffer, size, packStride, callback); });
+#else
+    auto [pixelData, fmt, bufLen] = buffer->beginDataPtr(0); // no need for end, cuz it's shm
+
+    if (packStride == (uint32_t)SHM.stride)
+        glReadPixels(region.x, region.y, size.x, size.y, glFormat, PFORMAT->glType, pixelData);
+    else {
+        for (size_t i = 0; i < size.y; ++i) {
+            glReadPixels(region.x, region.y + i, size.x, 1, glFormat, PFORMAT->glType, pixelData + i * SHM.stride);
+        }
+    }
+
+    callback(true);
+#endif
+}
+
+size_t CShmReadback::bytes() const {
+    size_t total = 0;
+    for (auto const& pbo : m_vFree) {
+        total += pbo.size;
+    }
+    return total;
+}
+
+#ifndef GLES2
+CShmReadback::SPackBuffer CShmReadback::acquire(size_t size) {
+    SPackBuffer pbo;
+
+    auto        it = std::ranges::find_if(m_vFree, [size](const auto& e) { return e.size == size; });
+    if (it == m_vFree.end() && !m_vFree.empty())
+        it = m_vFree.begin();
+
+    if (it != m_vFree.end()) {
+        pbo = *it;
+        m_vFree.erase(it);
+    } else
+        glGenBuffers(1, &pbo.id);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo.id);
+
+    if (pbo.size != size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        pbo.size = size;
+    }
+
+    return pbo;
+}
+
+void CShmReadback::recycle(const SPackBuffer& pbo) {
+    if (m_vFree.size() >= MAX_POOLED) {
+        glDeleteBuffers(1, &m_vFree.front().id);
+        m_vFree.erase(m_vFree.begin());
+    }
+
+    m_vFree.emplace_back(pbo);
+}
+
+void CShmReadback::finish(const SPackBuffer& pbo, SP<IHLBuffer> buffer, const Vector2D& size, uint32_t packStride, std::function<void(bool)> callback) {
+    g_pHyprRenderer->makeEGLCurrent();
+
+    const auto SHM                = buffer->shm();
+    auto [pixelData, fmt, bufLen] = buffer->beginDataPtr(0); // no need for end, cuz it's shm
+    const size_t ROWS             = size.y;
+
+    if (!pixelData || ROWS == 0 || bufLen < (ROWS - 1) * SHM.stride + packStride) {
+        Debug::log(ERR, "CShmReadback: shm buffer too small for the readback");
+        recycle(pbo);
+        callback(false);
+        return;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo.id);
+
+    const auto SRC = (const uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (size_t)packStride * ROWS, GL_MAP_READ_BIT);
+    if (SRC) {
+        if (packStride == (uint32_t)SHM.stride)
+            memcpy(pixelData, SRC, (size_t)packStride * ROWS);
+        else {
+            for (size_t i = 0; i < ROWS; ++i) {
+                memcpy(pixelData + i * SHM.stride, SRC + i * packStride, packStride);
+            }
+        }
+
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else
+        Debug::log(ERR, "CShmReadback: failed to map the pack buffer (GL Error: 0x{:x})", (int)glGetError());
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    recycle(pbo);
+    callback(SRC != nullptr);
+}
+#endif
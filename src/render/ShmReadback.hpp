@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/math/Math.hpp"
+#include <functional>
+#include <vector>
+
+class IHLBuffer;
+
+/*
+    Reads pixels back from the GPU into shm buffers without stalling.
+    glReadPixels goes into a pooled pixel pack buffer, and the copy into the
+    client's memory happens once the fence for it signals.
+    GLES2 has no pack buffers, so there it reads synchronously.
+*/
+class CShmReadback {
+  public:
+    ~CShmReadback();
+
+    // reads a region of the bound read framebuffer into the shm buffer.
+    // callback is called with the result once the pixels landed, possibly before this returns.
+    void   readInto(SP<IHLBuffer> buffer, const CBox& region, std::function<void(bool)> callback);
+
+    // size of the idle pack buffers
+    size_t bytes() const;
+
+  private:
+    struct SPackBuffer {
+        GLuint id   = 0;
+        size_t size = 0;
+    };
+
+    SPackBuffer              acquire(size_t size);
+    void                     recycle(const SPackBuffer& pbo);
+    void                     finish(const SPackBuffer& pbo, SP<IHLBuffer> buffer, const Vector2D& size, uint32_t packStride, std::function<void(bool)> callback);
+
+    std::vector<SPackBuffer> m_vFree;
+
+    constexpr static size_t  MAX_POOLED = 4;
+};
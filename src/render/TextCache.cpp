@@ -0,0 +1,66 @@
+#include "TextCache.hpp"
+
+size_t STextCacheKeyHash::operator()(const STextCacheKey& key) const {
+    size_t     hash    = std::hash<std::string>{}(key.text);
+    const auto combine = [&hash](size_t v) { hash ^= v + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+
+    combine(std::hash<std::string>{}(key.fontFamily));
+    combine(std::hash<int>{}(key.pt));
+    combine(std::hash<int>{}(key.maxWidth));
+    combine(std::hash<uint32_t>{}(key.color));
+    combine(key.italic);
+
+    return hash;
+}
+
+SP<CTexture> CTextCache::get(const STextCacheKey& key) {
+    const auto IT = m_mLookup.find(key);
+    if (IT == m_mLookup.end())
+        return nullptr;
+
+    m_lEntries.splice(m_lEntries.begin(), m_lEntries, IT->second);
+    return IT->second->tex;
+}
+
+void CTextCache::put(const STextCacheKey& key, SP<CTexture> tex) {
+    if (!tex)
+        return;
+
+    const size_t BYTES = (size_t)tex->m_vSize.x * tex->m_vSize.y * 4;
+
+    if (const auto IT = m_mLookup.find(key); IT != m_mLookup.end()) {
+        m_iBytes -= IT->second->bytes;
+        m_lEntries.erase(IT->second);
+        m_mLookup.erase(IT);
+    }
+
+    m_lEntries.emplace_front(SEntry{.key = key, .tex = tex, .bytes = BYTES});
+    m_mLookup[key] = m_lEntries.begin();
+    m_iBytes += BYTES;
+
+    evict();
+}
+
+void CTextCache::clear() {
+    m_mLookup.clear();
+    m_lEntries.clear();
+    m_iBytes = 0;
+}
+
+size_t CTextCache::size() const {
+    return m_lEntries.size();
+}
+
+size_t CTextCache::bytes() const {
+    return m_iBytes;
+}
+
+void CTextCache::evict() {
+    // always keep the newest one, even if it's huge on its own
+    while (m_lEntries.size() > 1 && (m_lEntries.size() > MAX_ENTRIES || m_iBytes > MAX_BYTES)) {
+        const auto& LAST = m_lEntries.back();
+        m_iBytes -= LAST.bytes;
+        m_mLookup.erase(LAST.key);
+        m_lEntries.pop_back();
+    }
+}
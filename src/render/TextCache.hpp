@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "Texture.hpp"
+#include <list>
+#include <string>
+#include <unordered_map>
+
+struct STextCacheKey {
+    std::string text;
+    std::string fontFamily;
+    int         pt       = 0;
+    bool        italic   = false;
+    uint32_t    color    = 0; // AR32
+    int         maxWidth = 0; // 0 means no ellipsizing
+
+    bool        operator==(const STextCacheKey& other) const = default;
+};
+
+struct STextCacheKeyHash {
+    size_t operator()(const STextCacheKey& key) const;
+};
+
+/*
+    LRU cache of rendered text runs. Text tends to be drawn over and over with the
+    same parameters (group bar titles, notifications), so shaping and uploading it
+    again every time is a waste.
+    The textures are shared, callers must not modify them.
+*/
+class CTextCache {
+  public:
+    SP<CTexture> get(const STextCacheKey& key);
+    void         put(const STextCacheKey& key, SP<CTexture> tex);
+    void         clear();
+
+    size_t       size() const;
+    size_t       bytes() const;
+
+  private:
+    struct SEntry {
+        STextCacheKey key;
+        SP<CTexture>  tex;
+        size_t        bytes = 0;
+    };
+
+    void                                                                              evict();
+
+    std::list<SEntry>                                                                 m_lEntries; // most recently used first
+    std::unordered_map<STextCacheKey, std::list<SEntry>::iterator, STextCacheKeyHash> m_mLookup;
+    size_t                                                                            m_iBytes = 0;
+
+    constexpr static size_t                                                           MAX_ENTRIES = 256;
+    constexpr static size_t                                                           MAX_BYTES   = 32 * 1024 * 1024;
+};
@@ -151,8 +151,8 @@ void CHyprDropShadowDecoration::render(PHLMONITOR pMonitor, float const& a) {
     g_pHyprOpenGL->m_RenderData.currentWindow = m_pWindow;
 
     // we'll take the liberty of using this as it should not be used rn
-    CFramebuffer& alphaFB     = g_pHyprOpenGL->m_RenderData.pCurrentMonData->mirrorFB;
-    CFramebuffer& alphaSwapFB = g_pHyprOpenGL->m_RenderData.pCurrentMonData->mirrorSwapFB;
+    CFramebuffer& alphaFB     = *g_pHyprOpenGL->getTransientFB(g_pHyprOpenGL->m_RenderData.pCurrentMonData->mirrorFB);
+    CFramebuffer& alphaSwapFB = *g_pHyprOpenGL->getTransientFB(g_pHyprOpenGL->m_RenderData.pCurrentMonData->mirrorSwapFB);
     auto*         LASTFB      = g_pHyprOpenGL->m_RenderData.currentFB;
 
     fullBox.scale(pMonitor->scale).round();
@@ -59,7 +59,7 @@ Vector2D CDecorationPositioner::getEdgeDefinedPoint(uint32_t edges, PHLWINDOW pW
 }
 
 void CDecorationPositioner::uncacheDecoration(IHyprWindowDecoration* deco) {
-    std::erase_if(m_vWindowPositioningDatas, [&](const auto& data) { return !data->pWindow.lock() || data->pDecoration == deco; });
+    eraseDatas([&](const auto& data) { return !data->pWindow.lock() || data->pDecoration == deco; });
 
     const auto WIT = std::find_if(m_mWindowDatas.begin(), m_mWindowDatas.end(), [&](const auto& other) { return other.first.lock() == deco->m_pWindow.lock(); });
     if (WIT == m_mWindowDatas.end())
@@ -74,21 +74,35 @@ void CDecorationPositioner::repositionDeco(IHyprWindowDecoration* deco) {
 }
 
 CDecorationPositioner::SWindowPositioningData* CDecorationPositioner::getDataFor(IHyprWindowDecoration* pDecoration, PHLWINDOW pWindow) {
-    auto it = std::find_if(m_vWindowPositioningDatas.begin(), m_vWindowPositioningDatas.end(), [&](const auto& el) { return el->pDecoration == pDecoration; });
-
-    if (it != m_vWindowPositioningDatas.end())
-        return it->get();
+    if (const auto DATA = findDataFor(pDecoration); DATA)
+        return DATA;
 
     const auto DATA = m_vWindowPositioningDatas.emplace_back(makeUnique<CDecorationPositioner::SWindowPositioningData>(pWindow, pDecoration)).get();
 
-    DATA->positioningInfo = pDecoration->getPositioningInfo();
+    DATA->positioningInfo           = pDecoration->getPositioningInfo();
+    m_mDecorationDatas[pDecoration] = DATA;
 
     return DATA;
 }
 
+CDecorationPositioner::SWindowPositioningData* CDecorationPositioner::findDataFor(IHyprWindowDecoration* pDecoration) {
+    const auto IT = m_mDecorationDatas.find(pDecoration);
+    return IT == m_mDecorationDatas.end() ? nullptr : IT->second;
+}
+
+void CDecorationPositioner::eraseDatas(const std::function<bool(const UP<SWindowPositioningData>&)>& pred) {
+    std::erase_if(m_vWindowPositioningDatas, [&](const auto& data) {
+        if (!pred(data))
+            return false;
+
+        m_mDecorationDatas.erase(data->pDecoration);
+        return true;
+    });
+}
+
 void CDecorationPositioner::sanitizeDatas() {
     std::erase_if(m_mWindowDatas, [](const auto& other) { return !valid(other.first); });
-    std::erase_if(m_vWindowPositioningDatas, [](const auto& other) {
+    eraseDatas([](const auto& other) {
         if (!validMapped(other->pWindow))
             return true;
         if (std::find_if(other->pWindow->m_dWindowDecorations.begin(), other->pWindow->m_dWindowDecorations.end(),
@@ -130,9 +144,8 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
     }
 
     if (WINDOWDATA->lastWindowSize == pWindow->m_vRealSize->value() /* position not changed */
-        && std::all_of(m_vWindowPositioningDatas.begin(), m_vWindowPositioningDatas.end(),
-                       [pWindow](const auto& data) { return pWindow != data->pWindow.lock() || !data->needsReposition; })
-        /* all window datas are either not for this window or don't need a reposition */
+        && std::all_of(datas.begin(), datas.end(), [](const auto& data) { return !data->needsReposition; })
+        /* all datas of this window don't need a reposition */
         && !WINDOWDATA->needsRecalc /* window doesn't need recalc */
     )
         return;
@@ -278,7 +291,7 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
 }
 
 void CDecorationPositioner::onWindowUnmap(PHLWINDOW pWindow) {
-    std::erase_if(m_vWindowPositioningDatas, [&](const auto& data) { return data->pWindow.lock() == pWindow; });
+    eraseDatas([&](const auto& data) { return data->pWindow.lock() == pWindow; });
     m_mWindowDatas.erase(pWindow);
 }
 
@@ -297,8 +310,9 @@ SBoxExtents CDecorationPositioner::getWindowDecorationExtents(PHLWINDOW pWindow,
     CBox const mainSurfaceBox = pWindow->getWindowMainSurfaceBox();
     CBox       accum          = mainSurfaceBox;
 
-    for (auto const& data : m_vWindowPositioningDatas) {
-        if (!data->pDecoration || (inputOnly && !(data->pDecoration->getDecorationFlags() & DECORATION_ALLOWS_MOUSE_INPUT)))
+    for (auto const& wd : pWindow->m_dWindowDecorations) {
+        const auto data = findDataFor(wd.get());
+        if (!data || !data->pDecoration || (inputOnly && !(data->pDecoration->getDecorationFlags() & DECORATION_ALLOWS_MOUSE_INPUT)))
             continue;
 
         auto const window = data->pWindow.lock();
@@ -345,8 +359,9 @@ SBoxExtents CDecorationPositioner::getWindowDecorationExtents(PHLWINDOW pWindow,
 CBox CDecorationPositioner::getBoxWithIncludedDecos(PHLWINDOW pWindow) {
     CBox accum = pWindow->getWindowMainSurfaceBox();
 
-    for (auto const& data : m_vWindowPositioningDatas) {
-        if (data->pWindow.lock() != pWindow)
+    for (auto const& wd : pWindow->m_dWindowDecorations) {
+        const auto data = findDataFor(wd.get());
+        if (!data || data->pWindow.lock() != pWindow)
             continue;
 
         if (!(data->pDecoration->getDecorationFlags() & DECORATION_PART_OF_MAIN_WINDOW))
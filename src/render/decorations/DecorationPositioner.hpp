@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <functional>
 #include "../../helpers/math/Math.hpp"
 #include "../../desktop/DesktopTypes.hpp"
 
@@ -90,10 +92,15 @@ class CDecorationPositioner {
     std::map<PHLWINDOWREF, SWindowData>     m_mWindowDatas;
     std::vector<UP<SWindowPositioningData>> m_vWindowPositioningDatas;
 
-    SWindowPositioningData*                 getDataFor(IHyprWindowDecoration* pDecoration, PHLWINDOW pWindow);
-    void                                    onWindowUnmap(PHLWINDOW pWindow);
-    void                                    onWindowMap(PHLWINDOW pWindow);
-    void                                    sanitizeDatas();
+    // decoration -> its entry in m_vWindowPositioningDatas, so per-window queries don't have to walk every deco of every window
+    std::unordered_map<IHyprWindowDecoration*, SWindowPositioningData*> m_mDecorationDatas;
+
+    SWindowPositioningData*                                             getDataFor(IHyprWindowDecoration* pDecoration, PHLWINDOW pWindow);
+    SWindowPositioningData*                                             findDataFor(IHyprWindowDecoration* pDecoration);
+    void                                                                eraseDatas(const std::function<bool(const UP<SWindowPositioningData>&)>& pred);
+    void                                                                onWindowUnmap(PHLWINDOW pWindow);
+    void                                                                onWindowMap(PHLWINDOW pWindow);
+    void                                                                sanitizeDatas();
 };
 
 inline UP<CDecorationPositioner> g_pDecorationPositioner;
\ No newline at end of file
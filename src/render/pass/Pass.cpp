@@ -9,6 +9,7 @@
 #include "../../render/Renderer.hpp"
 #include "../../Compositor.hpp"
 #include "../../protocols/core/Compositor.hpp"
+#include "../../debug/Trace.hpp"
 
 bool CRenderPass::empty() const {
     return false;
@@ -22,83 +23,134 @@ void CRenderPass::add(SP<IPassElement> el) {
     m_vPassElements.emplace_back(makeShared<SPassElementData>(CRegion{}, el));
 }
 
+bool CRenderPass::SOcclusionInputs::operator==(const SOcclusionInputs& other) const {
+    return passName == other.passName && liveBlur == other.liveBlur && undiscardable == other.undiscardable && boundingBox == other.boundingBox &&
+        pixman_region32_equal(const_cast<CRegion*>(&opaque)->pixman(), const_cast<CRegion*>(&other.opaque)->pixman());
+}
+
 void CRenderPass::simplify() {
+    TRACE_ZONE("simplify", "render");
+
     static auto PDEBUGPASS = CConfigValue<Hyprlang::INT>("debug:pass");
 
     // TODO: use precompute blur for instances where there is nothing in between
 
-    // if there is live blur, we need to NOT occlude any area where it will be influenced
-    const auto WILLBLUR = std::ranges::any_of(m_vPassElements, [](const auto& el) { return el->element->needsLiveBlur(); });
+    const auto  PMONITOR   = g_pHyprOpenGL->m_RenderData.pMonitor;
+    const float SCALE      = PMONITOR->scale;
+    const float BLURRADIUS = oneBlurRadius();
 
-    CRegion    newDamage = damage.copy().intersect(CBox{{}, g_pHyprOpenGL->m_RenderData.pMonitor->vecTransformedSize});
-    for (auto& el : m_vPassElements | std::views::reverse) {
+    auto&       retained = m_mRetained[PMONITOR->ID];
 
-        if (newDamage.empty() && !el->element->undiscardable()) {
-            el->discard = true;
-            continue;
-        }
+    // occlusion of an element only depends on its own inputs and the live blur below it,
+    // so everything up to the first changed element can be reused from the last frame.
+    const bool PARAMSCHANGED = retained.scale != SCALE || retained.blurRadius != BLURRADIUS;
+    const bool SAMESET       = !PARAMSCHANGED && retained.elements.size() == m_vPassElements.size();
 
-        el->elementDamage = newDamage;
-        auto bb1          = el->element->boundingBox();
-        if (!bb1 || newDamage.empty())
-            continue;
+    std::vector<SRetainedElement> elements;
+    elements.reserve(m_vPassElements.size());
 
-        auto bb = bb1->scale(g_pHyprOpenGL->m_RenderData.pMonitor->scale);
+    bool    blurBelowChanged = !SAMESET;
+    bool    allReused        = SAMESET;
+    CRegion liveBlurBelow, liveBlurBelowScaled;
+    retainStats = {};
 
-        // drop if empty
-        if (CRegion copy = newDamage.copy(); copy.intersect(bb).empty()) {
-            el->discard = true;
-            continue;
-        }
+    for (size_t i = 0; i < m_vPassElements.size(); ++i) {
+        const auto& EL = m_vPassElements[i]->element;
+        auto&       el = elements.emplace_back();
+        el.inputs.passName      = EL->passName();
+        el.inputs.liveBlur      = EL->needsLiveBlur();
+        el.inputs.undiscardable = EL->undiscardable();
+        el.inputs.boundingBox   = EL->boundingBox();
+        el.inputs.opaque        = EL->opaqueRegion();
 
-        auto opaque = el->element->opaqueRegion();
+        const bool SAMEINPUTS = SAMESET && retained.elements[i].inputs == el.inputs;
+        allReused             = allReused && SAMEINPUTS;
 
-        if (!opaque.empty()) {
-            opaque.scale(g_pHyprOpenGL->m_RenderData.pMonitor->scale);
+        if (SAMEINPUTS && !blurBelowChanged) {
+            el.occluder = retained.elements[i].occluder;
+            retainStats.reusedOccluders++;
+        } else if (!el.inputs.opaque.empty()) {
+            el.occluder = el.inputs.opaque.copy().scale(SCALE);
 
             // if this intersects the liveBlur region, allow live blur to operate correctly.
             // do not occlude a border near it.
-            if (WILLBLUR) {
-                CRegion liveBlurRegion;
-                for (auto& el2 : m_vPassElements) {
-                    // if we reach self, no problem, we can break.
-                    // if the blur is above us, we don't care, it will work fine.
-                    if (el2 == el)
-                        break;
+            // eh, this is not the correct solution, but it will do...
+            // TODO: is this *easily* fixable?
+            if (!liveBlurBelowScaled.empty())
+                el.occluder.subtract(liveBlurBelowScaled);
+        }
+
+        // if the blur is above us, we don't care, it will work fine.
+        if (!SAMEINPUTS && (el.inputs.liveBlur || (SAMESET && retained.elements[i].inputs.liveBlur)))
+            blurBelowChanged = true;
 
-                    if (!el2->element->needsLiveBlur())
-                        continue;
+        if (!el.inputs.liveBlur)
+            continue;
 
-                    const auto BB = el2->element->boundingBox();
-                    RASSERT(BB, "No bounding box for an element with live blur is illegal");
+        RASSERT(el.inputs.boundingBox, "No bounding box for an element with live blur is illegal");
 
-                    liveBlurRegion.add(*BB);
-                }
+        // expand the region: this area needs to be proper to blur it right.
+        liveBlurBelow.add(*el.inputs.boundingBox);
+        liveBlurBelowScaled = liveBlurBelow.copy().scale(SCALE).expand(BLURRADIUS * 2.F);
+    }
 
-                // expand the region: this area needs to be proper to blur it right.
-                liveBlurRegion.scale(g_pHyprOpenGL->m_RenderData.pMonitor->scale).expand(oneBlurRadius() * 2.F);
+    CRegion newDamage = damage.copy().intersect(CBox{{}, PMONITOR->vecTransformedSize});
 
-                if (auto infringement = opaque.copy().intersect(liveBlurRegion); !infringement.empty()) {
-                    // eh, this is not the correct solution, but it will do...
-                    // TODO: is this *easily* fixable?
-                    opaque.subtract(infringement);
-                }
+    // nothing moved and the same area is damaged as last frame, e.g. a blinking cursor
+    if (allReused && pixman_region32_equal(newDamage.pixman(), retained.damage.pixman())) {
+        retainStats.reusedDamage = true;
+
+        for (size_t i = 0; i < m_vPassElements.size(); ++i) {
+            elements[i].elementDamage         = retained.elements[i].elementDamage;
+            elements[i].discard               = retained.elements[i].discard;
+            m_vPassElements[i]->elementDamage = elements[i].elementDamage;
+            m_vPassElements[i]->discard       = elements[i].discard;
+        }
+    } else {
+        retained.damage = newDamage.copy();
+
+        for (size_t i = m_vPassElements.size(); i-- > 0;) {
+            auto& el  = m_vPassElements[i];
+            auto& ret = elements[i];
+
+            if (newDamage.empty() && !ret.inputs.undiscardable) {
+                el->discard = true;
+                ret.discard = true;
+                continue;
             }
-            newDamage.subtract(opaque);
-            if (*PDEBUGPASS)
-                occludedRegions.emplace_back(opaque);
+
+            el->elementDamage = newDamage;
+            ret.elementDamage = newDamage;
+            if (!ret.inputs.boundingBox || newDamage.empty())
+                continue;
+
+            auto bb = ret.inputs.boundingBox->copy().scale(SCALE);
+
+            // drop if empty
+            if (CRegion copy = newDamage.copy(); copy.intersect(bb).empty()) {
+                el->discard = true;
+                ret.discard = true;
+                continue;
+            }
+
+            if (!ret.occluder.empty())
+                newDamage.subtract(ret.occluder);
         }
     }
 
+    retained.scale      = SCALE;
+    retained.blurRadius = BLURRADIUS;
+    retained.elements   = std::move(elements);
+
     if (*PDEBUGPASS) {
-        for (auto& el2 : m_vPassElements) {
-            if (!el2->element->needsLiveBlur())
-                continue;
+        for (auto& el : retained.elements) {
+            if (!el.inputs.opaque.empty() && !el.discard)
+                occludedRegions.emplace_back(el.occluder);
 
-            const auto BB = el2->element->boundingBox();
-            RASSERT(BB, "No bounding box for an element with live blur is illegal");
+            if (!el.inputs.liveBlur)
+                continue;
 
-            totalLiveBlurRegion.add(BB->copy().scale(g_pHyprOpenGL->m_RenderData.pMonitor->scale));
+            totalLiveBlurRegion.add(el.inputs.boundingBox->copy().scale(SCALE));
         }
     }
 }
@@ -108,6 +160,8 @@ void CRenderPass::clear() {
 }
 
 CRegion CRenderPass::render(const CRegion& damage_) {
+    TRACE_ZONE("renderPass", "render");
+
     static auto PDEBUGPASS = CConfigValue<Hyprlang::INT>("debug:pass");
 
     const auto  WILLBLUR = std::ranges::any_of(m_vPassElements, [](const auto& el) { return el->element->needsLiveBlur(); });
@@ -260,31 +314,46 @@ void CRenderPass::renderDebugData() {
     }
 
     const auto DISCARDED_ELEMENTS = std::count_if(m_vPassElements.begin(), m_vPassElements.end(), [](const auto& e) { return e->discard; });
-    auto tex = g_pHyprOpenGL->renderText(std::format("occlusion layers: {}\npass elements: {} ({} discarded)\nviewport: {:X0}", occludedRegions.size(), m_vPassElements.size(),
-                                                     DISCARDED_ELEMENTS, g_pHyprOpenGL->m_RenderData.pMonitor->vecPixelSize),
-                                         Colors::WHITE, 12);
-
-    if (tex) {
-        box = CBox{{0.F, g_pHyprOpenGL->m_RenderData.pMonitor->vecSize.y - tex->m_vSize.y}, tex->m_vSize}.scale(g_pHyprOpenGL->m_RenderData.pMonitor->scale);
-        g_pHyprOpenGL->renderTexture(tex, box, 1.F);
-    }
-
-    std::string passStructure;
-    auto        yn   = [](const bool val) -> const char* { return val ? "yes" : "no"; };
-    auto        tick = [](const bool val) -> const char* { return val ? "✔" : "✖"; };
+    renderDebugText(
+        {
+            std::format("occlusion layers: {}", occludedRegions.size()),
+            std::format("pass elements: {} ({} discarded)", m_vPassElements.size(), DISCARDED_ELEMENTS),
+            std::format("retained occluders: {}{}", retainStats.reusedOccluders, retainStats.reusedDamage ? " (+damage)" : ""),
+            std::format("viewport: {:X0}", g_pHyprOpenGL->m_RenderData.pMonitor->vecPixelSize),
+        },
+        false);
+
+    std::vector<std::string> passStructure;
+    auto                     yn   = [](const bool val) -> const char* { return val ? "yes" : "no"; };
+    auto                     tick = [](const bool val) -> const char* { return val ? "✔" : "✖"; };
     for (const auto& el : m_vPassElements | std::views::reverse) {
-        passStructure += std::format("{} {} (bb: {} op: {})\n", tick(!el->discard), el->element->passName(), yn(el->element->boundingBox().has_value()),
-                                     yn(!el->element->opaqueRegion().empty()));
+        passStructure.emplace_back(std::format("{} {} (bb: {} op: {})", tick(!el->discard), el->element->passName(), yn(el->element->boundingBox().has_value()),
+                                               yn(!el->element->opaqueRegion().empty())));
     }
 
-    if (!passStructure.empty())
-        passStructure.pop_back();
+    renderDebugText(passStructure, true);
+}
+
+void CRenderPass::renderDebugText(const std::vector<std::string>& lines, bool alignRight) {
+    // a text run per line. Most lines repeat from frame to frame and come out of the text cache,
+    // while a whole block would be a new entry almost every frame and push out everyone else's.
+    std::vector<SP<CTexture>> textures;
+    float                     height = 0.F;
+    for (auto const& line : lines) {
+        auto tex = g_pHyprOpenGL->renderText(line, Colors::WHITE, 12);
+        if (!tex)
+            continue;
+
+        height += tex->m_vSize.y;
+        textures.emplace_back(std::move(tex));
+    }
 
-    tex = g_pHyprOpenGL->renderText(passStructure, Colors::WHITE, 12);
-    if (tex) {
-        box = CBox{{g_pHyprOpenGL->m_RenderData.pMonitor->vecSize.x - tex->m_vSize.x, g_pHyprOpenGL->m_RenderData.pMonitor->vecSize.y - tex->m_vSize.y}, tex->m_vSize}.scale(
-            g_pHyprOpenGL->m_RenderData.pMonitor->scale);
-        g_pHyprOpenGL->renderTexture(tex, box, 1.F);
+    const auto PMONITOR = g_pHyprOpenGL->m_RenderData.pMonitor;
+    float      y        = PMONITOR->vecSize.y - height;
+    for (auto const& tex : textures) {
+        const CBox BOX = CBox{{alignRight ? PMONITOR->vecSize.x - tex->m_vSize.x : 0.F, y}, tex->m_vSize}.scale(PMONITOR->scale);
+        g_pHyprOpenGL->renderTexture(tex, BOX, 1.F);
+        y += tex->m_vSize.y;
     }
 }
 
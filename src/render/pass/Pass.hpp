@@ -17,24 +17,60 @@ class CRenderPass {
 
     CRegion render(const CRegion& damage_);
 
+    // how far blur reaches out of its region, in monitor pixels
+    float   oneBlurRadius();
+
   private:
     CRegion              damage;
     std::vector<CRegion> occludedRegions;
     CRegion              totalLiveBlurRegion;
 
+    struct {
+        size_t reusedOccluders = 0;
+        bool   reusedDamage    = false;
+    } retainStats;
+
     struct SPassElementData {
         CRegion          elementDamage;
         SP<IPassElement> element;
         bool             discard = false;
     };
 
-    std::vector<SP<SPassElementData>> m_vPassElements;
+    // what the occlusion of an element depends on. Elements are rebuilt every frame,
+    // so an element is identified across frames by its position in the pass and these inputs.
+    struct SOcclusionInputs {
+        const char*         passName      = nullptr;
+        bool                liveBlur      = false;
+        bool                undiscardable = false;
+        std::optional<CBox> boundingBox;
+        CRegion             opaque; // logical
+
+        bool                operator==(const SOcclusionInputs& other) const;
+    };
+
+    struct SRetainedElement {
+        SOcclusionInputs inputs;
+        CRegion          occluder; // scaled, opaque minus whatever live blur below needs
+        CRegion          elementDamage;
+        bool             discard = false;
+    };
+
+    // simplify() results of the last frame on a monitor
+    struct SRetainedPass {
+        float                         scale      = 0.F;
+        float                         blurRadius = 0.F;
+        CRegion                       damage;
+        std::vector<SRetainedElement> elements;
+    };
+
+    std::vector<SP<SPassElementData>>            m_vPassElements;
+    std::unordered_map<MONITORID, SRetainedPass> m_mRetained;
 
-    SP<IPassElement>                  currentPassInfo = nullptr;
+    SP<IPassElement>                             currentPassInfo = nullptr;
 
-    void                              simplify();
-    float                             oneBlurRadius();
-    void                              renderDebugData();
+    void                                         simplify();
+    void                                         renderDebugData();
+    void                                         renderDebugText(const std::vector<std::string>& lines, bool alignRight); // stacked at the bottom of the monitor
 
     struct {
         bool         present = false;
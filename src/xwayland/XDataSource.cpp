@@ -22,6 +22,10 @@ CXDataSource::CXDataSource(SXSelection& sel_) : selection(sel_) {
     }
 
     auto value = (xcb_atom_t*)xcb_get_property_value(reply);
+
+    // resolve the names in one go, instead of a round trip per mime
+    g_pXWayland->pWM->cacheAtomNames(std::vector<xcb_atom_t>{value, value + reply->value_len});
+
     for (uint32_t i = 0; i < reply->value_len; i++) {
         if (value[i] == HYPRATOMS["UTF8_STRING"])
             mimeTypes.emplace_back("text/plain;charset=utf-8");
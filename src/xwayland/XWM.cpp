@@ -51,6 +51,16 @@ void CXWM::handleCreate(xcb_create_notify_event_t* e) {
 }
 
 void CXWM::handleDestroy(xcb_destroy_notify_event_t* e) {
+    // a requestor gone mid transfer won't take the rest. Dropping it closes the pipe, so the wayland source doesn't block on it forever.
+    for (auto* sel : {&clipboard, &primarySelection, &dndSelection}) {
+        for (auto const& t : sel->transfers) {
+            if (!t->incomingWindow && t->request.requestor == e->window)
+                t->selectedRequestor = false; // nothing to deselect on anymore
+        }
+
+        std::erase_if(sel->transfers, [e](const auto& t) { return !t->incomingWindow && t->request.requestor == e->window; });
+    }
+
     const auto XSURF = windowForXID(e->window);
 
     if (!XSURF)
@@ -171,25 +181,39 @@ static bool lookupParentExists(SP<CXWaylandSurface> XSURF, SP<CXWaylandSurface>
 }
 
 std::string CXWM::getAtomName(uint32_t atom) {
-    for (auto const& ha : HYPRATOMS) {
-        if (ha.second != atom)
+    cacheAtomNames({atom});
+
+    if (const auto IT = atomNames.find(atom); IT != atomNames.end())
+        return IT->second;
+
+    return "Unknown";
+}
+
+void CXWM::cacheAtom(xcb_atom_t atom, const std::string& name) {
+    atomNames[atom]   = name;
+    atomsByName[name] = atom;
+}
+
+void CXWM::cacheAtomNames(const std::vector<xcb_atom_t>& atoms) {
+    std::vector<std::pair<xcb_atom_t, xcb_get_atom_name_cookie_t>> cookies;
+
+    // send all, then wait for all: one round trip instead of one per atom
+    for (auto const& atom : atoms) {
+        if (atom == XCB_ATOM_NONE || atomNames.contains(atom) || std::ranges::any_of(cookies, [atom](const auto& c) { return c.first == atom; }))
             continue;
 
-        return ha.first;
+        cookies.emplace_back(atom, xcb_get_atom_name(connection, atom));
     }
 
-    // Get the name of the atom
-    auto const atom_name_cookie = xcb_get_atom_name(connection, atom);
-    auto*      atom_name_reply  = xcb_get_atom_name_reply(connection, atom_name_cookie, nullptr);
-
-    if (!atom_name_reply)
-        return "Unknown";
+    for (auto const& [atom, cookie] : cookies) {
+        auto* reply = xcb_get_atom_name_reply(connection, cookie, nullptr);
 
-    auto const name_len = xcb_get_atom_name_name_length(atom_name_reply);
-    auto*      name     = xcb_get_atom_name_name(atom_name_reply);
-    free(atom_name_reply);
+        if (!reply)
+            continue;
 
-    return {name, name_len};
+        cacheAtom(atom, std::string{xcb_get_atom_name_name(reply), (size_t)xcb_get_atom_name_name_length(reply)});
+        free(reply);
+    }
 }
 
 void CXWM::readProp(SP<CXWaylandSurface> XSURF, uint32_t atom, xcb_get_property_reply_t* reply) {
@@ -308,16 +332,10 @@ void CXWM::handlePropertyNotify(xcb_property_notify_event_t* e) {
     if (!XSURF)
         return;
 
-    xcb_get_property_cookie_t cookie = xcb_get_property(connection, 0, XSURF->xID, e->atom, XCB_ATOM_ANY, 0, 2048);
-    xcb_get_property_reply_t* reply  = xcb_get_property_reply(connection, cookie, nullptr);
-    if (!reply) {
-        Debug::log(ERR, "[xwm] Failed to read property notify cookie");
-        return;
-    }
-
-    readProp(XSURF, e->atom, reply);
-
-    free(reply);
+    // fetched once the event queue is drained, a burst of changes to one prop costs a single request
+    const uint64_t KEY = ((uint64_t)e->window << 32) | e->atom;
+    if (dirtyPropertiesSet.emplace(KEY).second)
+        dirtyProperties.emplace_back(KEY);
 }
 
 void CXWM::handleClientMessage(xcb_client_message_event_t* e) {
@@ -549,12 +567,16 @@ xcb_atom_t CXWM::mimeToAtom(const std::string& mime) {
     if (mime == "text/plain")
         return HYPRATOMS["TEXT"];
 
+    if (const auto IT = atomsByName.find(mime); IT != atomsByName.end())
+        return IT->second;
+
     xcb_intern_atom_cookie_t cookie = xcb_intern_atom(connection, 0, mime.length(), mime.c_str());
     xcb_intern_atom_reply_t* reply  = xcb_intern_atom_reply(connection, cookie, nullptr);
     if (!reply)
         return XCB_ATOM_NONE;
     xcb_atom_t atom = reply->atom;
     free(reply);
+    cacheAtom(atom, mime);
     return atom;
 }
 
@@ -564,15 +586,12 @@ std::string CXWM::mimeFromAtom(xcb_atom_t atom) {
     if (atom == HYPRATOMS["TEXT"])
         return "text/plain";
 
-    xcb_get_atom_name_cookie_t cookie = xcb_get_atom_name(connection, atom);
-    xcb_get_atom_name_reply_t* reply  = xcb_get_atom_name_reply(connection, cookie, nullptr);
-    if (!reply)
-        return "INVALID";
-    size_t      len = xcb_get_atom_name_name_length(reply);
-    char*       buf = xcb_get_atom_name_name(reply); // not a C string
-    std::string SZNAME{buf, len};
-    free(reply);
-    return SZNAME;
+    cacheAtomNames({atom});
+
+    if (const auto IT = atomNames.find(atom); IT != atomNames.end())
+        return IT->second;
+
+    return "INVALID";
 }
 
 void CXWM::handleSelectionNotify(xcb_selection_notify_event_t* e) {
@@ -601,6 +620,19 @@ bool CXWM::handleSelectionPropertyNotify(xcb_property_notify_event_t* e) {
     if (e->state != XCB_PROPERTY_DELETE)
         return false;
 
+    // an X client that took the last INCR chunk we sent it, wants the next one
+    for (auto* sel : {&clipboard, &primarySelection, &dndSelection}) {
+        auto it = std::ranges::find_if(sel->transfers, [e](const auto& t) {
+            return !t->incomingWindow && t->incremental && t->request.requestor == e->window && t->request.property == e->atom;
+        });
+        if (it != sel->transfers.end()) {
+            (*it)->propertySet = false;
+            if (!sel->sendIncrChunk(**it))
+                sel->transfers.erase(it);
+            return true;
+        }
+    }
+
     for (auto* sel : {&clipboard, &primarySelection}) {
         auto it = std::ranges::find_if(sel->transfers, [e](const auto& t) { return t->incomingWindow == e->window; });
         if (it != sel->transfers.end()) {
@@ -759,6 +791,35 @@ bool CXWM::handleSelectionEvent(xcb_generic_event_t* e) {
     return 0;
 }
 
+void CXWM::dispatchEvent(xcb_generic_event_t* event) {
+    if (handleSelectionEvent(event))
+        return;
+
+    // PropertyNotifies are coalesced until the end of the batch. Anything else may depend on them, so apply what's pending first to keep the order.
+    if ((event->response_type & XCB_EVENT_RESPONSE_TYPE_MASK) != XCB_PROPERTY_NOTIFY && !dirtyProperties.empty()) {
+        fetchDirtyProperties();
+        collectPropertyFetches(true);
+    }
+
+    switch (event->response_type & XCB_EVENT_RESPONSE_TYPE_MASK) {
+        case XCB_CREATE_NOTIFY: handleCreate((xcb_create_notify_event_t*)event); break;
+        case XCB_DESTROY_NOTIFY: handleDestroy((xcb_destroy_notify_event_t*)event); break;
+        case XCB_CONFIGURE_REQUEST: handleConfigureRequest((xcb_configure_request_event_t*)event); break;
+        case XCB_CONFIGURE_NOTIFY: handleConfigureNotify((xcb_configure_notify_event_t*)event); break;
+        case XCB_MAP_REQUEST: handleMapRequest((xcb_map_request_event_t*)event); break;
+        case XCB_MAP_NOTIFY: handleMapNotify((xcb_map_notify_event_t*)event); break;
+        case XCB_UNMAP_NOTIFY: handleUnmapNotify((xcb_unmap_notify_event_t*)event); break;
+        case XCB_PROPERTY_NOTIFY: handlePropertyNotify((xcb_property_notify_event_t*)event); break;
+        case XCB_CLIENT_MESSAGE: handleClientMessage((xcb_client_message_event_t*)event); break;
+        case XCB_FOCUS_IN: handleFocusIn((xcb_focus_in_event_t*)event); break;
+        case XCB_FOCUS_OUT: handleFocusOut((xcb_focus_out_event_t*)event); break;
+        case 0: handleError((xcb_value_error_t*)event); break;
+        default: {
+            Debug::log(TRACE, "[xwm] unhandled event {}", event->response_type & XCB_EVENT_RESPONSE_TYPE_MASK);
+        }
+    }
+}
+
 int CXWM::onEvent(int fd, uint32_t mask) {
 
     if ((mask & WL_EVENT_HANGUP) || (mask & WL_EVENT_ERROR)) {
@@ -771,6 +832,9 @@ int CXWM::onEvent(int fd, uint32_t mask) {
         return 0;
     }
 
+    // replies to fetches from the previous dispatch, if they're in
+    collectPropertyFetches(false);
+
     int count = 0;
 
     while (42069) {
@@ -779,34 +843,26 @@ int CXWM::onEvent(int fd, uint32_t mask) {
             break;
 
         count++;
+        dispatchEvent(event);
+        free(event);
+    }
 
-        if (handleSelectionEvent(event)) {
-            free(event);
-            continue;
-        }
+    // reading the socket above may have pulled in replies and events with it. libxcb keeps those buffered and the fd won't
+    // wake us for them again, so drain both here. Whatever is still on the wire will wake us.
+    while (42069) {
+        collectPropertyFetches(false);
 
-        switch (event->response_type & XCB_EVENT_RESPONSE_TYPE_MASK) {
-            case XCB_CREATE_NOTIFY: handleCreate((xcb_create_notify_event_t*)event); break;
-            case XCB_DESTROY_NOTIFY: handleDestroy((xcb_destroy_notify_event_t*)event); break;
-            case XCB_CONFIGURE_REQUEST: handleConfigureRequest((xcb_configure_request_event_t*)event); break;
-            case XCB_CONFIGURE_NOTIFY: handleConfigureNotify((xcb_configure_notify_event_t*)event); break;
-            case XCB_MAP_REQUEST: handleMapRequest((xcb_map_request_event_t*)event); break;
-            case XCB_MAP_NOTIFY: handleMapNotify((xcb_map_notify_event_t*)event); break;
-            case XCB_UNMAP_NOTIFY: handleUnmapNotify((xcb_unmap_notify_event_t*)event); break;
-            case XCB_PROPERTY_NOTIFY: handlePropertyNotify((xcb_property_notify_event_t*)event); break;
-            case XCB_CLIENT_MESSAGE: handleClientMessage((xcb_client_message_event_t*)event); break;
-            case XCB_FOCUS_IN: handleFocusIn((xcb_focus_in_event_t*)event); break;
-            case XCB_FOCUS_OUT: handleFocusOut((xcb_focus_out_event_t*)event); break;
-            case 0: handleError((xcb_value_error_t*)event); break;
-            default: {
-                Debug::log(TRACE, "[xwm] unhandled event {}", event->response_type & XCB_EVENT_RESPONSE_TYPE_MASK);
-            }
-        }
+        xcb_generic_event_t* event = xcb_poll_for_queued_event(connection);
+        if (!event)
+            break;
+
+        count++;
+        dispatchEvent(event);
         free(event);
     }
 
-    if (count)
-        xcb_flush(connection);
+    fetchDirtyProperties();
+    xcb_flush(connection);
 
     return count;
 }
@@ -816,9 +872,16 @@ void CXWM::gatherResources() {
     xcb_prefetch_extension_data(connection, &xcb_composite_id);
     xcb_prefetch_extension_data(connection, &xcb_res_id);
 
+    std::vector<xcb_intern_atom_cookie_t> atomCookies;
+    atomCookies.reserve(HYPRATOMS.size());
+
+    for (auto const& ATOM : HYPRATOMS) {
+        atomCookies.emplace_back(xcb_intern_atom(connection, 0, ATOM.first.length(), ATOM.first.c_str()));
+    }
+
+    size_t i = 0;
     for (auto& ATOM : HYPRATOMS) {
-        xcb_intern_atom_cookie_t cookie = xcb_intern_atom(connection, 0, ATOM.first.length(), ATOM.first.c_str());
-        xcb_intern_atom_reply_t* reply  = xcb_intern_atom_reply(connection, cookie, nullptr);
+        xcb_intern_atom_reply_t* reply = xcb_intern_atom_reply(connection, atomCookies[i++], nullptr);
 
         if (!reply) {
             Debug::log(ERR, "[xwm] Atom failed: {}", ATOM.first);
@@ -826,6 +889,7 @@ void CXWM::gatherResources() {
         }
 
         ATOM.second = reply->atom;
+        cacheAtom(ATOM.second, ATOM.first);
         free(reply);
     }
 
@@ -967,6 +1031,10 @@ CXWM::CXWM() : connection(g_pXWayland->pServer->xwmFDs[0].get()) {
 
 CXWM::~CXWM() {
 
+    for (auto const& f : propertyFetches) {
+        xcb_discard_reply(connection, f.cookie.sequence);
+    }
+
     if (eventSource)
         wl_event_source_remove(eventSource);
 
@@ -1082,16 +1150,70 @@ void CXWM::readWindowData(SP<CXWaylandSurface> surf) {
         HYPRATOMS["WM_PROTOCOLS"],
     };
 
-    for (size_t i = 0; i < interestingProps.size(); i++) {
-        xcb_get_property_cookie_t cookie = xcb_get_property(connection, 0, surf->xID, interestingProps[i], XCB_ATOM_ANY, 0, 2048);
-        xcb_get_property_reply_t* reply  = xcb_get_property_reply(connection, cookie, nullptr);
+    // the callers need the data right away. Fetches already in flight are older, apply them first.
+    collectPropertyFetches(true);
+
+    for (auto const& prop : interestingProps) {
+        fetchProperty(surf, prop);
+    }
+
+    collectPropertyFetches(true);
+}
+
+void CXWM::fetchProperty(SP<CXWaylandSurface> surf, xcb_atom_t atom) {
+    propertyFetches.emplace_back(SXPropertyFetch{
+        .surface = surf,
+        .atom    = atom,
+        .cookie  = xcb_get_property(connection, 0, surf->xID, atom, XCB_ATOM_ANY, 0, 2048),
+    });
+}
+
+void CXWM::fetchDirtyProperties() {
+    for (auto const& key : dirtyProperties) {
+        if (const auto XSURF = windowForXID(key >> 32); XSURF)
+            fetchProperty(XSURF, key & 0xFFFFFFFF);
+    }
+
+    dirtyProperties.clear();
+    dirtyPropertiesSet.clear();
+}
+
+void CXWM::collectPropertyFetches(bool block) {
+    if (propertyFetches.empty())
+        return;
+
+    // readProp emits signals, don't iterate something they could append to
+    auto fetches = std::move(propertyFetches);
+    propertyFetches.clear();
+
+    auto it = fetches.begin();
+    for (; it != fetches.end(); ++it) {
+        xcb_get_property_reply_t* reply = nullptr;
+
+        if (block)
+            reply = xcb_get_property_reply(connection, it->cookie, nullptr);
+        else {
+            // replies come in request order, nothing past the first missing one is in either
+            xcb_generic_error_t* error = nullptr;
+            if (!xcb_poll_for_reply(connection, it->cookie.sequence, (void**)&reply, &error))
+                break;
+
+            free(error);
+        }
+
         if (!reply) {
             Debug::log(ERR, "[xwm] Failed to get window property");
             continue;
         }
-        readProp(surf, interestingProps[i], reply);
+
+        if (const auto XSURF = it->surface.lock(); XSURF)
+            readProp(XSURF, it->atom, reply);
+
         free(reply);
     }
+
+    // whatever got fetched while we were reading is newer than what's left
+    propertyFetches.insert(propertyFetches.begin(), it, fetches.end());
 }
 
 SP<CXWaylandSurface> CXWM::windowForWayland(SP<CWLSurfaceResource> surf) {
@@ -1359,6 +1481,14 @@ void SXSelection::onKeyboardFocus() {
     }
 }
 
+static int readDataSource(int fd, uint32_t mask, void* data) {
+    Debug::log(LOG, "[xwm] readDataSource on fd {}", fd);
+
+    auto selection = (SXSelection*)data;
+
+    return selection->onRead(fd, mask);
+}
+
 int SXSelection::onRead(int fd, uint32_t mask) {
     auto it = std::ranges::find_if(transfers, [fd](const auto& t) { return t->wlFD.get() == fd; });
     if (it == transfers.end()) {
@@ -1372,8 +1502,15 @@ int SXSelection::onRead(int fd, uint32_t mask) {
 
     auto len = read(fd, transfer->data.data() + pre, INCR_CHUNK_SIZE - 1);
     if (len < 0) {
+        transfer->data.resize(pre);
+
+        if (errno == EAGAIN || errno == EINTR)
+            return 1;
+
         Debug::log(ERR, "[xwm] readDataSource died");
-        g_pXWayland->pWM->selectionSendNotify(&transfer->request, false);
+        // with INCR, the requestor already got its notify
+        if (!transfer->incremental)
+            g_pXWayland->pWM->selectionSendNotify(&transfer->request, false);
         transfers.erase(it);
         return 0;
     }
@@ -1381,24 +1518,91 @@ int SXSelection::onRead(int fd, uint32_t mask) {
     transfer->data.resize(pre + len);
 
     if (len == 0) {
-        Debug::log(LOG, "[xwm] Received all the bytes, final length {}", transfer->data.size());
-        xcb_change_property(g_pXWayland->pWM->connection, XCB_PROP_MODE_REPLACE, transfer->request.requestor, transfer->request.property, transfer->request.target, 8,
-                            transfer->data.size(), transfer->data.data());
-        xcb_flush(g_pXWayland->pWM->connection);
-        g_pXWayland->pWM->selectionSendNotify(&transfer->request, true);
-        transfers.erase(it);
-    } else
-        Debug::log(LOG, "[xwm] Received {} bytes, waiting...", len);
+        if (!transfer->incremental) {
+            Debug::log(LOG, "[xwm] Received all the bytes, final length {}", transfer->data.size());
+            xcb_change_property(g_pXWayland->pWM->connection, XCB_PROP_MODE_REPLACE, transfer->request.requestor, transfer->request.property, transfer->request.target, 8,
+                                transfer->data.size(), transfer->data.data());
+            xcb_flush(g_pXWayland->pWM->connection);
+            g_pXWayland->pWM->selectionSendNotify(&transfer->request, true);
+            transfers.erase(it);
+            return 1;
+        }
+
+        Debug::log(LOG, "[xwm] Received all the bytes, {} left to send incrementally", transfer->data.size());
+
+        transfer->readDone = true;
+        wl_event_source_remove(transfer->eventSource);
+        transfer->eventSource = nullptr;
+        transfer->wlFD.reset();
+
+        if (!transfer->propertySet && !sendIncrChunk(*transfer))
+            transfers.erase(it);
+
+        return 1;
+    }
+
+    Debug::log(LOG, "[xwm] Received {} bytes, waiting...", len);
+
+    if (!transfer->incremental && transfer->data.size() >= INCR_CHUNK_SIZE)
+        startIncr(*transfer);
+    else if (transfer->incremental && !transfer->propertySet)
+        sendIncrChunk(*transfer); // requestor is waiting on us
+
+    // don't read further ahead of the requestor than a chunk, sendIncrChunk resumes
+    if (transfer->incremental && transfer->data.size() >= INCR_CHUNK_SIZE && transfer->eventSource) {
+        wl_event_source_remove(transfer->eventSource);
+        transfer->eventSource = nullptr;
+    }
 
     return 1;
 }
 
-static int readDataSource(int fd, uint32_t mask, void* data) {
-    Debug::log(LOG, "[xwm] readDataSource on fd {}", fd);
+void SXSelection::startIncr(SXTransfer& transfer) {
+    const auto& XWM = g_pXWayland->pWM;
 
-    auto selection = (SXSelection*)data;
+    Debug::log(LOG, "[xwm] Selection over {} bytes, sending it incrementally", INCR_CHUNK_SIZE);
 
-    return selection->onRead(fd, mask);
+    transfer.incremental = true;
+    transfer.propertySet = true;
+
+    // we get PropertyNotify and DestroyNotify for our managed windows anyways
+    if (!XWM->windowForXID(transfer.request.requestor)) {
+        const uint32_t MASK = XCB_EVENT_MASK_PROPERTY_CHANGE | XCB_EVENT_MASK_STRUCTURE_NOTIFY;
+        xcb_change_window_attributes(XWM->connection, transfer.request.requestor, XCB_CW_EVENT_MASK, &MASK);
+        transfer.selectedRequestor = true;
+    }
+
+    // a lower bound of the size, we don't know the real one
+    const uint32_t SIZE = std::min(transfer.data.size(), (size_t)UINT32_MAX);
+    xcb_change_property(XWM->connection, XCB_PROP_MODE_REPLACE, transfer.request.requestor, transfer.request.property, HYPRATOMS["INCR"], 32, 1, &SIZE);
+
+    XWM->selectionSendNotify(&transfer.request, true);
+}
+
+bool SXSelection::sendIncrChunk(SXTransfer& transfer) {
+    const auto&  XWM = g_pXWayland->pWM;
+    const size_t LEN = std::min(transfer.data.size(), (size_t)INCR_CHUNK_SIZE);
+
+    // nothing to send yet, onRead will once there is
+    if (LEN == 0 && !transfer.readDone)
+        return true;
+
+    // a zero-length chunk marks the end
+    xcb_change_property(XWM->connection, XCB_PROP_MODE_REPLACE, transfer.request.requestor, transfer.request.property, transfer.request.target, 8, LEN, transfer.data.data());
+    xcb_flush(XWM->connection);
+
+    transfer.data.erase(transfer.data.begin(), transfer.data.begin() + LEN);
+    transfer.propertySet = true;
+
+    if (LEN == 0) {
+        Debug::log(LOG, "[xwm] Incremental selection transfer done");
+        return false;
+    }
+
+    if (!transfer.readDone && !transfer.eventSource && transfer.data.size() < INCR_CHUNK_SIZE)
+        transfer.eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, transfer.wlFD.get(), WL_EVENT_READABLE, ::readDataSource, this);
+
+    return true;
 }
 
 bool SXSelection::sendData(xcb_selection_request_event_t* e, std::string mime) {
@@ -1490,6 +1694,10 @@ int SXSelection::onWrite() {
 SXTransfer::~SXTransfer() {
     if (eventSource)
         wl_event_source_remove(eventSource);
+    if (selectedRequestor) {
+        const uint32_t MASK = XCB_EVENT_MASK_NO_EVENT;
+        xcb_change_window_attributes(g_pXWayland->pWM->connection, request.requestor, XCB_CW_EVENT_MASK, &MASK);
+    }
     if (incomingWindow)
         xcb_destroy_window(g_pXWayland->pWM->connection, incomingWindow);
     if (propertyReply)
@@ -11,6 +11,8 @@
 #include <xcb/composite.h>
 #include <xcb/xcb_errors.h>
 #include <hyprutils/os/FileDescriptor.hpp>
+#include <unordered_map>
+#include <unordered_set>
 
 struct wl_event_source;
 class CXWaylandSurfaceResource;
@@ -22,9 +24,11 @@ struct SXTransfer {
     SXSelection&                   selection;
     bool                           out = true;
 
-    bool                           incremental   = false;
-    bool                           flushOnDelete = false;
-    bool                           propertySet   = false;
+    bool                           incremental       = false;
+    bool                           flushOnDelete     = false;
+    bool                           propertySet       = false; // outgoing INCR: the requestor hasn't deleted our last property yet
+    bool                           readDone          = false; // outgoing INCR: the wayland side is done writing
+    bool                           selectedRequestor = false; // we selected PropertyChange on the requestor, undo when done
 
     Hyprutils::OS::CFileDescriptor wlFD;
     wl_event_source*               eventSource = nullptr;
@@ -34,12 +38,19 @@ struct SXTransfer {
     xcb_selection_request_event_t  request;
 
     int                            propertyStart;
-    xcb_get_property_reply_t*      propertyReply;
-    xcb_window_t                   incomingWindow;
+    xcb_get_property_reply_t*      propertyReply  = nullptr;
+    xcb_window_t                   incomingWindow = 0;
 
     bool                           getIncomingSelectionProp(bool erase);
 };
 
+// a get_property sent, its reply not read yet
+struct SXPropertyFetch {
+    WP<CXWaylandSurface>      surface;
+    xcb_atom_t                atom = XCB_ATOM_NONE;
+    xcb_get_property_cookie_t cookie;
+};
+
 struct SXSelection {
     xcb_window_t     window    = 0;
     xcb_window_t     owner     = 0;
@@ -52,6 +63,8 @@ struct SXSelection {
     bool             sendData(xcb_selection_request_event_t* e, std::string mime);
     int              onRead(int fd, uint32_t mask);
     int              onWrite();
+    void             startIncr(SXTransfer& transfer);
+    bool             sendIncrChunk(SXTransfer& transfer); // false once the transfer is over
 
     struct {
         CHyprSignalListener setSelection;
@@ -138,6 +151,9 @@ class CXWM {
     SP<CXWaylandSurface> windowForWayland(SP<CWLSurfaceResource> surf);
 
     void                 readWindowData(SP<CXWaylandSurface> surf);
+    void                 fetchProperty(SP<CXWaylandSurface> surf, xcb_atom_t atom);
+    void                 fetchDirtyProperties();
+    void                 collectPropertyFetches(bool block);
     void                 associate(SP<CXWaylandSurface> surf, SP<CWLSurfaceResource> wlSurf);
     void                 dissociate(SP<CXWaylandSurface> surf);
 
@@ -156,6 +172,7 @@ class CXWM {
     void         handleFocusIn(xcb_focus_in_event_t* e);
     void         handleFocusOut(xcb_focus_out_event_t* e);
     void         handleError(xcb_value_error_t* e);
+    void         dispatchEvent(xcb_generic_event_t* e);
 
     bool         handleSelectionEvent(xcb_generic_event_t* e);
     void         handleSelectionNotify(xcb_selection_notify_event_t* e);
@@ -169,6 +186,8 @@ class CXWM {
     void         setClipboardToWayland(SXSelection& sel);
     void         getTransferData(SXSelection& sel);
     std::string  getAtomName(uint32_t atom);
+    void         cacheAtomNames(const std::vector<xcb_atom_t>& atoms);
+    void         cacheAtom(xcb_atom_t atom, const std::string& name);
     void         readProp(SP<CXWaylandSurface> XSURF, uint32_t atom, xcb_get_property_reply_t* reply);
 
     SXSelection* getSelection(xcb_atom_t atom);
@@ -197,6 +216,14 @@ class CXWM {
     std::vector<WP<CXWaylandSurface>>         mappedSurfaces;         // ordered by map time
     std::vector<WP<CXWaylandSurface>>         mappedSurfacesStacking; // ordered by stacking
 
+    std::vector<SXPropertyFetch>              propertyFetches;    // in request order
+    std::vector<uint64_t>                     dirtyProperties;    // (window << 32) | atom, PropertyNotify'd during this dispatch
+    std::unordered_set<uint64_t>              dirtyPropertiesSet; // same, for dedup
+
+    // atoms never change for the lifetime of the server
+    std::unordered_map<xcb_atom_t, std::string> atomNames;
+    std::unordered_map<std::string, xcb_atom_t> atomsByName;
+
     WP<CXWaylandSurface>                      focusedSurface;
     uint64_t                                  lastFocusSeq = 0;
 
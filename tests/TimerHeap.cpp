@@ -0,0 +1,282 @@
+// Headless checks for the event loop's timer heap. Drives CTimerHeap with made up clock values, no timerfd, no compositor.
+
+#include "../src/managers/eventLoop/TimerHeap.hpp"
+#include "../src/managers/eventLoop/EventLoopTimer.hpp"
+
+#include <algorithm>
+#include <print>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+static int failures = 0;
+
+static void expect(bool condition, std::string_view what) {
+    if (condition)
+        return;
+
+    std::println(stderr, "FAIL: {}", what);
+    failures++;
+}
+
+static SP<CEventLoopTimer> makeTimer(std::optional<Time::steady_dur> timeout, std::vector<int>& fired, int id) {
+    return makeShared<CEventLoopTimer>(timeout, [&fired, id](SP<CEventLoopTimer> self, void* data) { fired.push_back(id); }, nullptr);
+}
+
+// timers are armed against the real clock, everything below is placed far enough from the edges that the time spent setting up doesn't matter
+
+static void testInsert() {
+    CTimerHeap       heap;
+    std::vector<int> fired;
+
+    auto             a  = makeTimer(30ms, fired, 30);
+    auto             b  = makeTimer(10ms, fired, 10);
+    auto             c  = makeTimer(20ms, fired, 20);
+    auto             d  = makeTimer(std::nullopt, fired, 0);
+    const auto       T0 = Time::steadyNow();
+
+    for (auto const& t : {a, b, c, d}) {
+        heap.add(t);
+    }
+
+    expect(heap.size() == 4, "insert: all four timers are registered");
+    expect(heap.next().has_value() && *heap.next() <= T0 + 10ms, "insert: the soonest timer is first");
+
+    heap.fire(T0 + 5ms);
+    expect(fired.empty(), "insert: nothing fires early");
+
+    heap.fire(T0 + 15ms);
+    expect(fired == std::vector<int>{10}, "insert: only the due timer fires");
+    expect(!b->armed(), "insert: a fired timer is disarmed");
+
+    heap.fire(T0 + 1s);
+    expect(fired == std::vector<int>{10, 20, 30}, "insert: the rest fire in expiry order");
+    expect(!heap.next().has_value(), "insert: nothing armed left");
+
+    heap.fire(T0 + 2s);
+    expect(fired.size() == 3, "insert: fired timers don't fire again");
+}
+
+static void testCancel() {
+    CTimerHeap       heap;
+    std::vector<int> fired;
+
+    auto             cancelled = makeTimer(10ms, fired, 1);
+    auto             disarmed  = makeTimer(10ms, fired, 2);
+    auto             removed   = makeTimer(10ms, fired, 3);
+    const auto       T0        = Time::steadyNow();
+
+    heap.add(cancelled);
+    heap.add(disarmed);
+    heap.add(removed);
+
+    cancelled->cancel();
+    disarmed->updateTimeout(std::nullopt);
+    heap.remove(removed);
+
+    expect(heap.size() == 2, "cancel: removed timer is unregistered");
+    expect(!heap.next().has_value(), "cancel: no timer is armed");
+
+    heap.fire(T0 + 1s);
+    expect(fired.empty(), "cancel: cancelled, disarmed and removed timers don't fire");
+
+    // updating a removed timer doesn't put it back
+    removed->updateTimeout(10ms);
+    heap.fire(T0 + 1s);
+    expect(fired.empty(), "cancel: a removed timer stays removed when re-armed");
+}
+
+static void testRearm() {
+    int              changes = 0;
+    CTimerHeap       heap{[&changes] { changes++; }};
+    std::vector<int> fired;
+
+    auto             t  = makeTimer(10ms, fired, 1);
+    const auto       T0 = Time::steadyNow();
+
+    heap.add(t);
+
+    // the old entry stays in the heap, it must not fire the timer at the old time, nor twice
+    t->updateTimeout(100ms);
+    expect(changes == 1, "re-arm: the heap reports the change");
+
+    heap.fire(T0 + 50ms);
+    expect(fired.empty(), "re-arm: the old timeout is gone");
+
+    heap.fire(T0 + 1s);
+    expect(fired == std::vector<int>{1}, "re-arm: fires once at the new timeout");
+
+    // re-arming from the callback, like periodic timers do
+    int  ticks    = 0;
+    auto periodic = makeShared<CEventLoopTimer>(
+        10ms,
+        [&ticks](SP<CEventLoopTimer> self, void* data) {
+            if (++ticks < 3)
+                self->updateTimeout(10ms);
+        },
+        nullptr);
+    heap.add(periodic);
+
+    for (int i = 0; i < 5; ++i) {
+        heap.fire(Time::steadyNow() + 1s);
+    }
+
+    expect(ticks == 3, "re-arm: a timer re-armed from its callback fires each time, then stops");
+
+    // a callback re-arming another due timer defers it
+    fired.clear();
+    auto       first  = makeTimer(10ms, fired, 1);
+    auto       second = makeTimer(20ms, fired, 2);
+    const auto T1     = Time::steadyNow();
+    auto       defer  = makeShared<CEventLoopTimer>(5ms, [&second](SP<CEventLoopTimer> self, void* data) { second->updateTimeout(1h); }, nullptr);
+
+    heap.add(first);
+    heap.add(second);
+    heap.add(defer);
+
+    heap.fire(T1 + 1s);
+    expect(fired == std::vector<int>{1}, "re-arm: a timer re-armed by an earlier callback in the same batch waits");
+}
+
+static void testLost() {
+    CTimerHeap       heap;
+    std::vector<int> fired;
+
+    const auto       T0 = Time::steadyNow();
+
+    // nobody but the heap holds these
+    heap.add(makeTimer(10ms, fired, 1));
+    heap.add(makeTimer(std::nullopt, fired, 2));
+
+    auto kept = makeTimer(10ms, fired, 3);
+    heap.add(kept);
+
+    heap.fire(T0 + 1s);
+    expect(fired == std::vector<int>{3}, "lost: only the timer still held fires");
+    expect(heap.size() == 2, "lost: the armed lost timer is dropped when it's due");
+
+    // lost unarmed timers are swept once the list grows
+    for (int i = 0; i < 1000; ++i) {
+        heap.add(makeTimer(std::nullopt, fired, 4));
+    }
+
+    expect(heap.size() <= 64, "lost: unarmed lost timers are swept");
+
+    // a removed and re-added timer is a new registration, entries from before don't count
+    fired.clear();
+    kept->updateTimeout(10ms);
+    heap.remove(kept);
+    heap.add(kept);
+    kept->updateTimeout(100ms);
+
+    heap.fire(Time::steadyNow() + 50ms);
+    expect(fired.empty(), "lost: entries from a previous registration are invalid");
+
+    heap.fire(Time::steadyNow() + 1s);
+    expect(fired == std::vector<int>{3}, "lost: the timer fires once for its current registration");
+}
+
+static void testSlack() {
+    CTimerHeap       heap;
+    std::vector<int> fired;
+
+    auto             a  = makeTimer(10ms, fired, 10);
+    auto             b  = makeTimer(13ms, fired, 13);
+    auto             c  = makeTimer(30ms, fired, 30);
+    const auto       T0 = Time::steadyNow();
+
+    heap.add(a);
+    heap.add(b);
+    heap.add(c);
+
+    heap.setSlack(5ms);
+
+    heap.fire(T0 + 10ms);
+    expect(fired == std::vector<int>{10, 13}, "slack: timers within the slack fire together");
+
+    heap.fire(T0 + 20ms);
+    expect(fired.size() == 2, "slack: timers past the slack wait");
+
+    heap.setSlack(-5ms);
+    heap.fire(T0 + 30ms);
+    expect(fired == std::vector<int>{10, 13, 30}, "slack: negative slack is treated as none");
+}
+
+static void testMany() {
+    constexpr int    COUNT = 10000;
+
+    CTimerHeap       heap;
+    std::vector<int> fired;
+    fired.reserve(COUNT);
+
+    std::mt19937                     rng{1337};
+    std::uniform_int_distribution<>  seconds{1, 1000};
+
+    std::vector<SP<CEventLoopTimer>> timers;
+    std::vector<int>                 timeouts;
+    for (int i = 0; i < COUNT; ++i) {
+        timeouts.push_back(seconds(rng));
+        timers.push_back(makeTimer(std::chrono::seconds(timeouts.back()), fired, i));
+        heap.add(timers.back());
+    }
+
+    const auto T0 = Time::steadyNow();
+
+    // re-arm a third of them, leaving stale entries behind
+    for (int i = 0; i < COUNT; i += 3) {
+        timeouts[i] = seconds(rng);
+        timers[i]->updateTimeout(std::chrono::seconds(timeouts[i]));
+        timers[i]->updateTimeout(std::chrono::seconds(timeouts[i]));
+    }
+
+    // and lose a third of the rest
+    int lost = 0;
+    for (int i = 1; i < COUNT; i += 3) {
+        timers[i].reset();
+        lost++;
+    }
+
+    for (int s = 0; s <= 1001; ++s) {
+        heap.fire(T0 + std::chrono::seconds(s) + 500ms);
+    }
+
+    std::vector<int> firedTimeouts;
+    for (int i : fired) {
+        firedTimeouts.push_back(timeouts[i]);
+    }
+
+    std::vector<int> expected;
+    for (int i = 0; i < COUNT; ++i) {
+        if (timers[i])
+            expected.push_back(timeouts[i]);
+    }
+    std::ranges::sort(expected);
+
+    std::ranges::sort(fired);
+    const bool ONCE = std::ranges::adjacent_find(fired) == fired.end() && std::ranges::none_of(fired, [&](int i) { return !timers[i]; });
+
+    expect(fired.size() == (size_t)(COUNT - lost) && ONCE, "many: every held timer fires exactly once");
+    expect(std::ranges::is_sorted(firedTimeouts), "many: timers fire in expiry order");
+    expect(firedTimeouts == expected, "many: the fired timeouts match the armed ones");
+    expect(!heap.next().has_value(), "many: nothing armed left");
+    expect(heap.size() == (size_t)(COUNT - lost), "many: lost armed timers are dropped");
+}
+
+int main() {
+    testInsert();
+    testCancel();
+    testRearm();
+    testLost();
+    testSlack();
+    testMany();
+
+    if (failures > 0) {
+        std::println(stderr, "{} check(s) failed", failures);
+        return 1;
+    }
+
+    std::println("all timer heap checks passed");
+    return 0;
+}